@@ -0,0 +1,391 @@
+#include "asset_loader.h"
+#include "resource_pack.h"
+#include <raylib.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+// same as raylib (FONT_TTF_DEFAULT_CHARS_PADDING), see LoadFontEx
+inline constexpr int AssetFontGlyphPadding = 4;
+
+using AssetClock = std::chrono::steady_clock;
+
+/// decoded texture cache file: header + raw pixel data (same format as the decoded image)
+inline constexpr char TextureCacheMagic[4] = {'N', 'C', 'T', 'C'};
+inline constexpr uint32_t TextureCacheVersion = 1;
+struct TextureCacheHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint64_t sourceHash; ///< cache is stale when the source file changed
+    int32_t width;
+    int32_t height;
+    int32_t mipmaps;
+    int32_t format;
+    uint32_t dataSize;
+    uint32_t reserved[3];
+};
+static_assert(sizeof(TextureCacheHeader) == 48);
+
+// FNV-1a
+static uint64_t hashData(const unsigned char* data, int dataSize)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (int i = 0; i < dataSize; ++i)
+    {
+        hash = (hash ^ data[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+static bool loadCachedTexture(AssetJob& job, uint64_t sourceHash)
+{
+    if (!OpenMappedFile(job.cacheFileName.c_str(), job.cacheFile))
+    {
+        return false;
+    }
+    TextureCacheHeader header{};
+    if (job.cacheFile.size >= sizeof(header))
+    {
+        std::memcpy(&header, job.cacheFile.data, sizeof(header));
+    }
+    if (std::memcmp(header.magic, TextureCacheMagic, sizeof(TextureCacheMagic)) != 0 ||
+        header.version != TextureCacheVersion || header.sourceHash != sourceHash ||
+        header.dataSize != static_cast<uint32_t>(GetPixelDataSize(header.width, header.height, header.format)) ||
+        job.cacheFile.size < sizeof(header) + header.dataSize)
+    {
+        CloseMappedFile(job.cacheFile);
+        return false;
+    }
+
+    // pixels stay in the mapped file until the upload (LoadTextureFromImage)
+    job.image.data = const_cast<unsigned char*>(job.cacheFile.data + sizeof(header));
+    job.image.width = header.width;
+    job.image.height = header.height;
+    job.image.mipmaps = header.mipmaps;
+    job.image.format = header.format;
+    return true;
+}
+static void saveCachedTexture(const AssetJob& job, uint64_t sourceHash)
+{
+    TextureCacheHeader header{};
+    std::memcpy(header.magic, TextureCacheMagic, sizeof(TextureCacheMagic));
+    header.version = TextureCacheVersion;
+    header.sourceHash = sourceHash;
+    header.width = job.image.width;
+    header.height = job.image.height;
+    header.mipmaps = 1;
+    header.format = job.image.format;
+    header.dataSize = static_cast<uint32_t>(GetPixelDataSize(job.image.width, job.image.height, job.image.format));
+
+    // @NOTE: SaveFileData needs one buffer, write directly (no copy of the pixels)
+    // written next to the cache and renamed when complete, a crash while writing never leaves a broken cache behind
+    const std::string tempFileName = job.cacheFileName + ".tmp";
+    FILE* file = std::fopen(tempFileName.c_str(), "wb");
+    if (file == nullptr)
+    {
+        TraceLog(LOG_WARNING, "ASSET: [%s] failed to write texture cache", job.cacheFileName.c_str());
+        return;
+    }
+    bool written = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   std::fwrite(job.image.data, header.dataSize, 1, file) == 1;
+    written = (std::fclose(file) == 0) && written;
+    if (written && std::rename(tempFileName.c_str(), job.cacheFileName.c_str()) != 0)
+    {
+        // Windows doesn't replace existing files
+        std::remove(job.cacheFileName.c_str());
+        written = std::rename(tempFileName.c_str(), job.cacheFileName.c_str()) == 0;
+    }
+    if (!written)
+    {
+        TraceLog(LOG_WARNING, "ASSET: [%s] failed to write texture cache", job.cacheFileName.c_str());
+        std::remove(tempFileName.c_str());
+    }
+}
+
+static void releaseImage(AssetJob& job)
+{
+    if (job.cacheFile.data != nullptr)
+    {
+        // image data points into the cache file
+        CloseMappedFile(job.cacheFile);
+    }
+    else if (job.image.data != nullptr)
+    {
+        UnloadImage(job.image);
+    }
+    job.image = {};
+}
+static void releaseAsset(AssetJob& job)
+{
+    releaseImage(job);
+    if (job.glyphs != nullptr)
+    {
+        UnloadFontData(job.glyphs, job.fontGlyphCount);
+        job.glyphs = nullptr;
+    }
+    if (job.glyphRecs != nullptr)
+    {
+        MemFree(job.glyphRecs);
+        job.glyphRecs = nullptr;
+    }
+}
+
+/// file data from the embedded resource pack (no copy when stored uncompressed) or from disk
+/// @NOTE: free ownedData with UnloadFileData
+static const unsigned char* loadAssetFileData(const AssetJob& job, int* dataSize, unsigned char** ownedData)
+{
+    PackedResource resource;
+    if (FindEmbeddedResource(job.fileName.c_str(), resource) && !resource.compressed)
+    {
+        *ownedData = nullptr;
+        *dataSize = static_cast<int>(resource.dataSize);
+        return resource.data;
+    }
+    *ownedData = LoadResourceFileData(job.fileName.c_str(), dataSize);
+    return *ownedData;
+}
+
+static void decodeAsset(AssetJob& job)
+{
+    const auto startTime = AssetClock::now();
+    job.state = AssetState::Decoding;
+    int dataSize = 0;
+    unsigned char* ownedData = nullptr;
+    const unsigned char* fileData = loadAssetFileData(job, &dataSize, &ownedData);
+    if (fileData != nullptr)
+    {
+        switch (job.type)
+        {
+            case AssetType::Texture:
+            {
+                const uint64_t sourceHash = (!job.cacheFileName.empty()) ? hashData(fileData, dataSize) : 0;
+                job.fromCache = !job.cacheFileName.empty() && loadCachedTexture(job, sourceHash);
+                if (!job.fromCache)
+                {
+                    job.image = LoadImageFromMemory(GetFileExtension(job.fileName.c_str()), fileData, dataSize);
+                    // the cache only holds the base level
+                    if (job.image.data != nullptr && job.image.mipmaps == 1 && !job.cacheFileName.empty())
+                    {
+                        saveCachedTexture(job, sourceHash);
+                    }
+                }
+            }
+            break;
+            case AssetType::Font:
+                job.glyphs = LoadFontData(fileData, dataSize, job.fontSize, nullptr, job.fontGlyphCount, FONT_DEFAULT);
+                if (job.glyphs != nullptr)
+                {
+                    job.image = GenImageFontAtlas(
+                        job.glyphs,
+                        &job.glyphRecs,
+                        job.fontGlyphCount,
+                        job.fontSize,
+                        AssetFontGlyphPadding,
+                        0);
+                }
+                break;
+        }
+    }
+    if (ownedData != nullptr)
+    {
+        UnloadFileData(ownedData);
+    }
+    const auto endTime = AssetClock::now();
+    job.decodeTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
+    job.waitTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - job.queuedTime);
+    if (job.image.data == nullptr)
+    {
+        TraceLog(LOG_WARNING, "ASSET: [%s] failed to load", job.fileName.c_str());
+        releaseAsset(job);
+        job.state = AssetState::Failed;
+        return;
+    }
+    job.state = AssetState::Decoded;
+}
+static void uploadAsset(AssetJob& job)
+{
+    const auto startTime = AssetClock::now();
+    switch (job.type)
+    {
+        case AssetType::Texture:
+            if (job.targetTexture != nullptr)
+            {
+                *job.targetTexture = LoadTextureFromImage(job.image);
+            }
+            break;
+        case AssetType::Font:
+            if (job.targetFont != nullptr)
+            {
+                Font font{};
+                font.baseSize = job.fontSize;
+                font.glyphCount = job.fontGlyphCount;
+                font.glyphPadding = AssetFontGlyphPadding;
+                font.texture = LoadTextureFromImage(job.image);
+                font.recs = job.glyphRecs;
+                font.glyphs = job.glyphs;
+                *job.targetFont = font;
+                // owned by the font now
+                job.glyphs = nullptr;
+                job.glyphRecs = nullptr;
+            }
+            break;
+    }
+    releaseImage(job);
+    job.uploadTime = std::chrono::duration_cast<std::chrono::microseconds>(AssetClock::now() - startTime);
+    job.state = AssetState::Loaded;
+
+    TraceLog(
+        LOG_INFO,
+        "ASSET: [%s] decoded in %.2f ms%s (ready after %.2f ms), uploaded in %.2f ms",
+        job.fileName.c_str(),
+        job.decodeTime.count() / 1000.0f,
+        (job.fromCache) ? " (cached)" : "",
+        job.waitTime.count() / 1000.0f,
+        job.uploadTime.count() / 1000.0f);
+}
+static void assetWorker(AssetLoader& loader)
+{
+    while (!loader.cancel)
+    {
+        const size_t index = loader.nextJob.fetch_add(1);
+        if (index >= loader.jobs.size())
+        {
+            break;
+        }
+        decodeAsset(*loader.jobs[index]);
+    }
+}
+
+int QueueTextureAsset(AssetLoader& loader, const char* fileName, Texture2D* target)
+{
+    auto job = std::make_unique<AssetJob>();
+    job->fileName = fileName;
+    job->type = AssetType::Texture;
+    job->targetTexture = target;
+    loader.jobs.push_back(std::move(job));
+    return static_cast<int>(loader.jobs.size()) - 1;
+}
+int QueueFontAsset(AssetLoader& loader, const char* fileName, int fontSize, int glyphCount, Font* target)
+{
+    auto job = std::make_unique<AssetJob>();
+    job->fileName = fileName;
+    job->type = AssetType::Font;
+    job->fontSize = fontSize;
+    job->fontGlyphCount = (glyphCount > 0) ? glyphCount : 95;
+    job->targetFont = target;
+    loader.jobs.push_back(std::move(job));
+    return static_cast<int>(loader.jobs.size()) - 1;
+}
+
+void StartAssetLoader(AssetLoader& loader, [[maybe_unused]] int maxWorkers)
+{
+    loader.startTime = AssetClock::now();
+    for (auto& job : loader.jobs)
+    {
+        job->queuedTime = loader.startTime;
+    }
+    loader.nextJob = 0;
+    loader.cancel = false;
+    loader.finished = false;
+    if (!loader.cacheDirectory.empty())
+    {
+        if (!DirectoryExists(loader.cacheDirectory.c_str()) && MakeDirectory(loader.cacheDirectory.c_str()) != 0)
+        {
+            TraceLog(LOG_WARNING, "ASSET: failed to create cache directory [%s]", loader.cacheDirectory.c_str());
+            loader.cacheDirectory.clear();
+        }
+        for (auto& job : loader.jobs)
+        {
+            if (job->type == AssetType::Texture && !loader.cacheDirectory.empty())
+            {
+                // resources/atlas.png -> <cache>/resources_atlas.png.rgba
+                std::string cacheName = job->fileName;
+                std::replace(cacheName.begin(), cacheName.end(), '/', '_');
+                job->cacheFileName = loader.cacheDirectory + "/" + cacheName + ".rgba";
+            }
+        }
+    }
+#if !defined(PLATFORM_WEB)
+    const auto hardwareThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    const auto workerCount = std::min({maxWorkers, hardwareThreads, static_cast<int>(loader.jobs.size())});
+    loader.workers.reserve(workerCount);
+    for (int i = 0; i < workerCount; ++i)
+    {
+        loader.workers.emplace_back(assetWorker, std::ref(loader));
+    }
+#endif
+}
+
+bool UpdateAssetLoader(AssetLoader& loader)
+{
+#if defined(PLATFORM_WEB)
+    // no worker threads, decode one asset per frame
+    const size_t index = loader.nextJob.fetch_add(1);
+    if (index < loader.jobs.size())
+    {
+        decodeAsset(*loader.jobs[index]);
+    }
+#endif
+
+    bool done = true;
+    for (auto& job : loader.jobs)
+    {
+        switch (job->state)
+        {
+            case AssetState::Queued:
+            case AssetState::Decoding: done = false; break;
+            case AssetState::Decoded: uploadAsset(*job); break;
+            case AssetState::Loaded:
+            case AssetState::Failed: break;
+        }
+    }
+
+    if (done && !loader.finished)
+    {
+        loader.finished = true;
+        StopAssetLoader(loader);
+        TraceLog(
+            LOG_INFO,
+            "ASSET: all assets loaded in %.2f ms",
+            std::chrono::duration_cast<std::chrono::microseconds>(AssetClock::now() - loader.startTime).count() /
+                1000.0f);
+    }
+
+    return done;
+}
+
+void StopAssetLoader(AssetLoader& loader)
+{
+    loader.cancel = true;
+    for (auto& worker : loader.workers)
+    {
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+    }
+    loader.workers.clear();
+}
+
+bool IsAssetReady(const AssetLoader& loader, int assetId)
+{
+    if (assetId < 0 || assetId >= static_cast<int>(loader.jobs.size()))
+    {
+        return false;
+    }
+    const auto state = loader.jobs[assetId]->state.load();
+    return state == AssetState::Loaded || state == AssetState::Failed;
+}
+
+AssetLoader::~AssetLoader()
+{
+    StopAssetLoader(*this);
+    for (auto& job : jobs)
+    {
+        releaseAsset(*job);
+    }
+}
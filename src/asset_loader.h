@@ -0,0 +1,89 @@
+#pragma once
+
+#include "mapped_file.h"
+#include <raylib.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// enums
+enum class AssetType : uint8_t
+{
+    Texture,
+    Font,
+};
+enum class AssetState : uint8_t
+{
+    Queued,
+    Decoding,
+    Decoded, ///< CPU data ready, waiting for upload (main thread)
+    Loaded,
+    Failed,
+};
+
+/// Types
+struct AssetJob
+{
+    std::string fileName;
+    AssetType type{AssetType::Texture};
+    std::atomic<AssetState> state{AssetState::Queued};
+
+    // font settings
+    int fontSize{0};
+    int fontGlyphCount{0};
+
+    // decoded (CPU), written by the worker
+    Image image{};
+    GlyphInfo* glyphs{nullptr};
+    Rectangle* glyphRecs{nullptr};
+
+    // decoded texture cache, see AssetLoader::cacheDirectory
+    std::string cacheFileName;
+    MappedFile cacheFile; ///< image data points into the cache file (fromCache)
+    bool fromCache{false};
+
+    // target (GPU), set on upload
+    Texture2D* targetTexture{nullptr};
+    Font* targetFont{nullptr};
+
+    // timings
+    std::chrono::steady_clock::time_point queuedTime{};
+    std::chrono::microseconds decodeTime{std::chrono::microseconds::zero()};
+    std::chrono::microseconds waitTime{std::chrono::microseconds::zero()}; ///< queued -> decoded
+    std::chrono::microseconds uploadTime{std::chrono::microseconds::zero()};
+};
+
+/// decodes images (and fonts) on worker threads, the upload to the GPU happens on the main thread (UpdateAssetLoader)
+/// @NOTE: no threads on Web, decoding is done on the main thread (one asset per update)
+struct AssetLoader
+{
+    std::vector<std::unique_ptr<AssetJob>> jobs;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> nextJob{0};
+    std::atomic<bool> cancel{false};
+    std::chrono::steady_clock::time_point startTime{};
+    bool finished{false};
+    /// decoded textures (raw pixels) are cached here, keyed by the hash of the source file, empty: no cache
+    std::string cacheDirectory;
+
+    AssetLoader() = default;
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+    ~AssetLoader();
+};
+
+/// queue assets before StartAssetLoader, returns asset id
+extern int QueueTextureAsset(AssetLoader& loader, const char* fileName, Texture2D* target);
+extern int QueueFontAsset(AssetLoader& loader, const char* fileName, int fontSize, int glyphCount, Font* target);
+
+extern void StartAssetLoader(AssetLoader& loader, int maxWorkers);
+/// upload decoded assets (main thread), call every frame, returns true when all assets are done
+extern bool UpdateAssetLoader(AssetLoader& loader);
+extern void StopAssetLoader(AssetLoader& loader);
+
+/// asset is uploaded or failed to load (like LoadTexture, the game keeps running with an empty texture)
+[[nodiscard]] extern bool IsAssetReady(const AssetLoader& loader, int assetId);
@@ -0,0 +1,188 @@
+#include "batch_sim.h"
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BATCH_SIM_SSE2
+#endif
+
+static_assert(sizeof(ConnectorAction) == sizeof(int32_t), "actions are loaded as int32 lanes");
+static_assert(
+    static_cast<int>(CharacterDirection::Right) == 0 && static_cast<int>(CharacterDirection::Left) == 1 &&
+        static_cast<int>(CharacterDirection::Up) == 2 && static_cast<int>(CharacterDirection::Down) == 3,
+    "direction of a movement action: action ^ (action >> 1)");
+
+void InitBatchSimMap(BatchSimMap& map, const TileMap& tileMap)
+{
+    map.width = tileMap.width;
+    map.height = tileMap.height;
+    map.tiles.resize(static_cast<size_t>(map.width) * map.height);
+    for (int y = 0; y < map.height; ++y)
+    {
+        for (int x = 0; x < map.width; ++x)
+        {
+            const TilePosition position{x, y};
+            map.tiles[static_cast<size_t>(y) * map.width + x] = IsVoidAt(tileMap, position)   ? BatchSimTile::Void
+                                                                 : IsDoorAt(tileMap, position) ? BatchSimTile::Door
+                                                                                               : BatchSimTile::Walkable;
+        }
+    }
+}
+
+void ResetBatchSim(BatchSimState& state, size_t count, TilePosition start, CharacterDirection direction)
+{
+    state.count = count;
+    state.x.assign(count, start.x);
+    state.y.assign(count, start.y);
+    state.direction.assign(count, static_cast<int32_t>(direction));
+    state.status.assign(count, static_cast<int32_t>(BatchSimStatus::Alive));
+}
+
+static int32_t getTile(const BatchSimMap& map, int32_t x, int32_t y)
+{
+    return static_cast<int32_t>(GetBatchSimTile(map, x, y));
+}
+
+/// branch-free version of MoveTile (one lane)
+static void stepLane(const BatchSimMap& map, BatchSimState& state, size_t i, int32_t action)
+{
+    const bool alive = state.status[i] == static_cast<int32_t>(BatchSimStatus::Alive);
+    const bool isMove = action >= static_cast<int32_t>(ConnectorAction::MovementRight) &&
+                        action <= static_cast<int32_t>(ConnectorAction::MovementUp);
+    const bool isJump = action == static_cast<int32_t>(ConnectorAction::Jump);
+    const int32_t direction = (isMove && alive) ? (action ^ (action >> 1)) : state.direction[i];
+    const int32_t length = alive ? (isMove ? 1 : (isJump ? JumpFactor : 0)) : 0;
+    state.x[i] += ((direction == static_cast<int32_t>(CharacterDirection::Right)) ? length : 0) -
+                  ((direction == static_cast<int32_t>(CharacterDirection::Left)) ? length : 0);
+    state.y[i] += ((direction == static_cast<int32_t>(CharacterDirection::Down)) ? length : 0) -
+                  ((direction == static_cast<int32_t>(CharacterDirection::Up)) ? length : 0);
+    state.direction[i] = direction;
+    state.status[i] = alive ? getTile(map, state.x[i], state.y[i]) : state.status[i];
+}
+
+#if defined(BATCH_SIM_SSE2)
+static __m128i selectLanes(__m128i mask, __m128i a, __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+static __m128i loadLanes(const int32_t* data)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+}
+static void storeLanes(int32_t* data, __m128i value)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(data), value);
+}
+#endif
+
+void StepBatchSim(const BatchSimMap& map, BatchSimState& state, std::span<const ConnectorAction> actions)
+{
+    const size_t count = std::min(state.count, actions.size());
+    size_t i = 0;
+#if defined(BATCH_SIM_SSE2)
+    const auto* actionData = reinterpret_cast<const int32_t*>(actions.data());
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i noAction = _mm_set1_epi32(static_cast<int32_t>(ConnectorAction::NONE));
+    const __m128i lastMovement = _mm_set1_epi32(static_cast<int32_t>(ConnectorAction::MovementUp));
+    const __m128i jump = _mm_set1_epi32(static_cast<int32_t>(ConnectorAction::Jump));
+    const __m128i jumpFactor = _mm_set1_epi32(JumpFactor);
+    const __m128i right = _mm_set1_epi32(static_cast<int32_t>(CharacterDirection::Right));
+    const __m128i left = _mm_set1_epi32(static_cast<int32_t>(CharacterDirection::Left));
+    const __m128i up = _mm_set1_epi32(static_cast<int32_t>(CharacterDirection::Up));
+    const __m128i down = _mm_set1_epi32(static_cast<int32_t>(CharacterDirection::Down));
+    for (; i + BatchSimLanes <= count; i += BatchSimLanes)
+    {
+        const __m128i action = loadLanes(actionData + i);
+        const __m128i status = loadLanes(&state.status[i]);
+        const __m128i alive = _mm_cmpeq_epi32(status, zero);
+        if (_mm_movemask_epi8(alive) == 0)
+        {
+            continue;
+        }
+        const __m128i isMove =
+            _mm_andnot_si128(_mm_cmpgt_epi32(action, lastMovement), _mm_cmpgt_epi32(action, noAction));
+        const __m128i isJump = _mm_cmpeq_epi32(action, jump);
+
+        const __m128i direction = selectLanes(
+            _mm_and_si128(isMove, alive),
+            _mm_xor_si128(action, _mm_srai_epi32(action, 1)),
+            loadLanes(&state.direction[i]));
+        const __m128i length =
+            _mm_and_si128(alive, _mm_or_si128(_mm_and_si128(isMove, one), _mm_and_si128(isJump, jumpFactor)));
+        const __m128i dx = _mm_sub_epi32(
+            _mm_and_si128(_mm_cmpeq_epi32(direction, right), length),
+            _mm_and_si128(_mm_cmpeq_epi32(direction, left), length));
+        const __m128i dy = _mm_sub_epi32(
+            _mm_and_si128(_mm_cmpeq_epi32(direction, down), length),
+            _mm_and_si128(_mm_cmpeq_epi32(direction, up), length));
+        storeLanes(&state.x[i], _mm_add_epi32(loadLanes(&state.x[i]), dx));
+        storeLanes(&state.y[i], _mm_add_epi32(loadLanes(&state.y[i]), dy));
+        storeLanes(&state.direction[i], direction);
+
+        // tile check (gather), no gather in SSE2
+        alignas(16) int32_t tiles[BatchSimLanes];
+        for (int lane = 0; lane < BatchSimLanes; ++lane)
+        {
+            tiles[lane] = getTile(map, state.x[i + lane], state.y[i + lane]);
+        }
+        const __m128i tile = _mm_load_si128(reinterpret_cast<const __m128i*>(tiles));
+        storeLanes(&state.status[i], selectLanes(alive, tile, status));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        stepLane(map, state, i, static_cast<int32_t>(actions[i]));
+    }
+}
+
+void StepBatchSimScalar(const TileMap& map, BatchSimState& state, std::span<const ConnectorAction> actions)
+{
+    const size_t count = std::min(state.count, actions.size());
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (state.status[i] != static_cast<int32_t>(BatchSimStatus::Alive))
+        {
+            continue;
+        }
+        TilePosition position{state.x[i], state.y[i]};
+        auto direction = static_cast<CharacterDirection>(state.direction[i]);
+        MoveTile(position, direction, actions[i]);
+        state.x[i] = position.x;
+        state.y[i] = position.y;
+        state.direction[i] = static_cast<int32_t>(direction);
+        if (IsVoidAt(map, position))
+        {
+            state.status[i] = static_cast<int32_t>(BatchSimStatus::Dead);
+        }
+        else if (IsDoorAt(map, position))
+        {
+            state.status[i] = static_cast<int32_t>(BatchSimStatus::Won);
+        }
+    }
+}
+
+size_t RunBatchSim(const BatchSimMap& map, BatchSimState& state, std::span<const ConnectorAction> actions)
+{
+    if (state.count == 0)
+    {
+        return 0;
+    }
+    size_t steps = 0;
+    for (size_t offset = 0; offset + state.count <= actions.size(); offset += state.count)
+    {
+        StepBatchSim(map, state, actions.subspan(offset, state.count));
+        ++steps;
+        if (CountBatchSimStatus(state, BatchSimStatus::Alive) == 0)
+        {
+            break;
+        }
+    }
+    return steps;
+}
+
+size_t CountBatchSimStatus(const BatchSimState& state, BatchSimStatus status)
+{
+    return static_cast<size_t>(
+        std::count(state.status.begin(), state.status.begin() + state.count, static_cast<int32_t>(status)));
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "tile_map.h"
+#include "types.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/// batch simulation of many independent characters (same movement rules as UpdateMainSceneMap),
+/// e.g. to rank key binds and key sequences of a level
+/// @NOTE: states are stored as structure of arrays, BatchSimLanes states are moved at once (SSE2),
+///        scalar fallback on other platforms (Web, ARM)
+inline constexpr int BatchSimLanes = 4;
+
+/// per state, same values as BatchSimTile (tile under the character)
+enum class BatchSimStatus : int32_t
+{
+    Alive = 0,
+    Dead = 1, ///< stepped on a void tile (or outside of the map)
+    Won = 2,  ///< stepped on the door
+};
+
+/// tile classes of the level map (dense, one byte per tile), outside of the map is Void
+enum class BatchSimTile : uint8_t
+{
+    Walkable = static_cast<uint8_t>(BatchSimStatus::Alive),
+    Void = static_cast<uint8_t>(BatchSimStatus::Dead),
+    Door = static_cast<uint8_t>(BatchSimStatus::Won),
+};
+
+struct BatchSimMap
+{
+    int width{0};
+    int height{0};
+    std::vector<BatchSimTile> tiles; ///< row by row
+};
+
+/// characters (structure of arrays), direction: CharacterDirection, status: BatchSimStatus
+struct BatchSimState
+{
+    size_t count{0};
+    std::vector<int32_t> x;
+    std::vector<int32_t> y;
+    std::vector<int32_t> direction;
+    std::vector<int32_t> status;
+};
+
+extern void InitBatchSimMap(BatchSimMap& map, const TileMap& tileMap);
+[[nodiscard]] inline BatchSimTile GetBatchSimTile(const BatchSimMap& map, int x, int y)
+{
+    const bool inside = (static_cast<unsigned>(x) < static_cast<unsigned>(map.width)) &
+                        (static_cast<unsigned>(y) < static_cast<unsigned>(map.height));
+    const size_t index = inside ? static_cast<size_t>(y) * map.width + x : 0;
+    return inside ? map.tiles[index] : BatchSimTile::Void;
+}
+/// count characters on the start tile
+extern void ResetBatchSim(BatchSimState& state, size_t count, TilePosition start, CharacterDirection direction);
+
+/// one action per character (actions[i] for character i, actions.size() >= state.count),
+/// the tile is checked after every action (same as a turn in the game), dead and won characters don't move
+extern void StepBatchSim(const BatchSimMap& map, BatchSimState& state, std::span<const ConnectorAction> actions);
+/// same as StepBatchSim, one character at the time (reference, MoveTile and TileMap)
+extern void StepBatchSimScalar(const TileMap& map, BatchSimState& state, std::span<const ConnectorAction> actions);
+
+/// run action sequences of the same length, actions[step * state.count + i] for character i,
+/// stops when no character is alive, returns the steps run
+extern size_t RunBatchSim(const BatchSimMap& map, BatchSimState& state, std::span<const ConnectorAction> actions);
+
+[[nodiscard]] extern size_t CountBatchSimStatus(const BatchSimState& state, BatchSimStatus status);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "atlas.h"
 #include <raylib.h>
 #include <array>
 #include <chrono>
@@ -165,11 +166,14 @@ inline constexpr int WelcomeTextFontSize = 14;
 inline constexpr int StartButtonTextFontSize = 18;
 inline constexpr int EndTextFontSize = 16;
 inline constexpr int WelcomeFooterTextFontSize = 14;
+inline constexpr int LoadingTextFontSize = 18;
 //// Nodes
 inline constexpr int NodeFontSize = 16;
 inline constexpr int NodeLineThick = 2;
 inline constexpr auto NodeLineColor = ColorPalette[2];
 inline constexpr auto DisabledColor = ColorPalette[6];
+inline constexpr auto InvalidNodeLineColor = ColorPalette[4]; ///< editor: link breaks the rules (crossing, in between)
+inline constexpr int CandidateNodeLineThick = 1;
 //// ActionNode
 inline constexpr int ActionNodeSides = 6;
 inline constexpr int ActionNodeRadius = 18;
@@ -179,6 +183,7 @@ inline constexpr auto ActionNodeColor = ColorPalette[5];
 inline constexpr int KeyNodeRadius = 18;
 inline constexpr int KeyNodeRadiusThick = 2;
 inline constexpr auto KeyNodeColor = ColorPalette[1];
+inline constexpr int MaxNodeRadius = (ActionNodeRadius > KeyNodeRadius) ? ActionNodeRadius : KeyNodeRadius;
 //// Map
 inline constexpr int HelpIconFontSize = 12;
 inline constexpr int HelpIconRadius = 9;
@@ -195,7 +200,6 @@ inline constexpr int LevelMapWidth = 11;
 inline constexpr int LevelMapHeight = 10;
 inline constexpr int LevelTileWidth = 32;
 inline constexpr int LevelTileHeight = 32;
-inline constexpr int MaxLevels = 5;
 inline constexpr int StartLevel = 1; // for testing
 inline constexpr int JumpFactor = 2; // factor * tile size
 //// Character
@@ -208,16 +212,31 @@ inline constexpr int ActionIconSpriteWidth = 32;
 inline constexpr int ActionIconSpriteHeight = 32;
 inline constexpr int ControlIconSpriteWidth = 10;
 inline constexpr int ControlIconSpriteHeight = 10;
+//// Atlas
+/// sprite (frame) in a sprite sheet, sheet is the region in the atlas (see atlas.h), sprites are in one row
+inline constexpr Rectangle SpriteSheetRect(Rectangle sheet, int index, int spriteWidth, int spriteHeight)
+{
+    return {
+        sheet.x + static_cast<float>(index * spriteWidth),
+        sheet.y,
+        static_cast<float>(spriteWidth),
+        static_cast<float>(spriteHeight)};
+}
 
 /// Node Settings
 inline constexpr int MaxNodeConnections = 2;
 inline constexpr int MaxIndirectConnections = 4;
 inline constexpr int MaxNodesInLevel = 10;
+/// job system (fork/join), smaller counts run on the calling thread
+inline constexpr size_t UpdateNodesMinBatch = 64; ///< UpdateAllNodes, nodes per job (levels have less nodes)
+inline constexpr size_t KeyPreviewsMinBatch = 16; ///< preview lines, keys per job (6 ConnectorKeys)
+inline constexpr size_t EditorLinksMinBatch = 256; ///< node editor, link checks per job
 
 /// strings
 constexpr const char* TitleText = "";
 constexpr const char* SubTitleText = "";
 constexpr const char* WelcomeFooterText = "Copyright (c) 2024 furudbat";
+constexpr const char* LoadingText = "LOADING ...";
 constexpr const char* WelcomeText = R"(Connect Action- and Key-Neurons on
 the left side to bind your keys.
 
@@ -260,6 +279,12 @@ inline constexpr const char* LeftHelperNoConnectionsTextFormat = "Connect Action
 inline constexpr const char* LeftHelperCharacterTextFormat = "Move your Character and \nreach the door.";
 inline constexpr const char* RightHelperTextNoKeyBindsFormat = "No Key-Binds";
 inline constexpr const char* LevelsHelperFormat = "Level: %d";
+inline constexpr const char* EditorHelperText =
+    "EDITOR  LMB: drag, RMB: action/key, L: auto-layout, CTRL+S: save, F5: exit";
+inline constexpr const char* SandboxHelperText =
+    "SANDBOX  A/K: add, X: remove, SHIFT+LMB: link, G: generate, F6: exit";
+inline constexpr size_t SandboxGraphNodes = 24; ///< G, generated graph (the nodes fit into the ConnectorArea)
+inline constexpr const char* EditorLevelFileFormat = "%s%s%d%s"; ///< directory, LevelFilePrefix, level, extension
 ///// Key (enum strings)
 inline constexpr const char* ConnectorKeyHString = "H";
 inline constexpr const char* ConnectorKeyJString = "J";
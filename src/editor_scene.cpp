@@ -0,0 +1,513 @@
+#include "constants.h"
+#include "game.h"
+#include "geometry.h"
+#include "level_file.h"
+#include "node_editor.h"
+#include "types.h"
+#include <raylib.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+// pre define internal functions
+static void applyNodeEditor(GameContext& gameContext);
+static void saveEditorLevel(GameContext& gameContext);
+/// node under the mouse, InvalidNodeHandle when there is none
+static NodeHandle pickEditorNode(const NodeEditor& editor, Vector2 mouse);
+static void nextNodeData(NodeData& data);
+/// ForceLayoutStepsPerFrame layout steps, the level nodes follow the pool
+static void updateEditorLayout(GameContext& gameContext);
+/// add/remove nodes, link/unlink and generated graphs (only the pool, see ToggleNodeSandbox)
+static void updateSandbox(GameContext& gameContext);
+/// SHIFT is down in the sandbox, LMB links the nodes instead of dragging them
+static bool sandboxLinking(const GameContext& gameContext);
+
+void ToggleNodeEditor(GameContext& gameContext)
+{
+    if (gameContext.editorMode && gameContext.sandboxMode)
+    {
+        // the sandbox graph is not part of the level
+        gameContext.nodeEditor = {};
+        gameContext.editorMode = false;
+        gameContext.sandboxMode = false;
+        TraceLog(LOG_INFO, "EDITOR: sandbox closed");
+        return;
+    }
+    if (gameContext.editorMode)
+    {
+        applyNodeEditor(gameContext);
+        gameContext.editorMode = false;
+        TraceLog(LOG_INFO, "EDITOR: closed, %d connections", gameContext.levelConnections);
+        return;
+    }
+    if (gameContext.state != GameState::NodesMain)
+    {
+        return;
+    }
+
+    // same index as the level nodes, DISABLED nodes are removed again (the free slots are never used)
+    auto& editor = gameContext.nodeEditor;
+    editor = {};
+    editor.jobs = &gameContext.jobs;
+    SetNodePoolArea(editor.pool, ConnectorArea);
+    // same geometry rules as the level, the connections of the level are valid links
+    editor.pool.rules = gameContext.levelConnectionRules.rules;
+    editor.pool.maxLinksPerNode = static_cast<size_t>(gameContext.levelConnectionRules.maxConnectionsPerNode);
+    std::array<NodeHandle, MaxNodesInLevel> handles{};
+    for (const auto& node : gameContext.nodes)
+    {
+        handles[node.index] = AddPoolNode(editor.pool, node.data);
+    }
+    for (const auto& node : gameContext.nodes)
+    {
+        if (node.data.type == ConnectorType::DISABLED)
+        {
+            RemovePoolNode(editor.pool, handles[node.index]);
+        }
+    }
+    for (const auto& node : gameContext.nodes)
+    {
+        for (const auto& connectedNodeIndex : node.direct_connections)
+        {
+            if (connectedNodeIndex > node.index)
+            {
+                // not editable, but kept (see applyNodeEditor), the same connection twice is one link
+                const NodeLinkResult result =
+                    LinkPoolNodes(editor.pool, handles[node.index], handles[connectedNodeIndex]);
+                if (result != NodeLinkResult::Linked && result != NodeLinkResult::AlreadyLinked)
+                {
+                    TraceLog(
+                        LOG_WARNING,
+                        "EDITOR: connection %d - %d is not a valid link (%d), kept as it is",
+                        node.index,
+                        connectedNodeIndex,
+                        static_cast<int>(result));
+                }
+            }
+        }
+    }
+    RevalidateEditorLinks(editor);
+
+    for (auto& node : gameContext.nodes)
+    {
+        node.is_selected = false;
+    }
+    gameContext.nodeSelectionMode = false;
+    gameContext.editorMode = true;
+}
+
+void ToggleNodeSandbox(GameContext& gameContext)
+{
+    if (gameContext.editorMode)
+    {
+        // the level editor is closed with F5
+        if (gameContext.sandboxMode)
+        {
+            ToggleNodeEditor(gameContext);
+        }
+        return;
+    }
+    if (gameContext.state != GameState::NodesMain)
+    {
+        return;
+    }
+
+    auto& editor = gameContext.nodeEditor;
+    editor = {};
+    editor.jobs = &gameContext.jobs;
+    SetNodePoolArea(editor.pool, ConnectorArea);
+
+    for (auto& node : gameContext.nodes)
+    {
+        node.is_selected = false;
+    }
+    gameContext.nodeSelectionMode = false;
+    gameContext.editorMode = true;
+    gameContext.sandboxMode = true;
+    TraceLog(LOG_INFO, "EDITOR: sandbox opened");
+}
+
+void UpdateNodeEditorScene(GameContext& gameContext)
+{
+    auto& editor = gameContext.nodeEditor;
+    const Vector2 mouse = gameContext.input.mousePosition;
+    if (IsFrameKeyPressed(gameContext.input, KEY_L) && editor.dragNode == InvalidNodeHandle)
+    {
+        InitForceLayout(editor.layout, editor.pool);
+        editor.layoutRunning = true;
+    }
+    if (editor.layoutRunning)
+    {
+        // no dragging while the layout moves the nodes
+        updateEditorLayout(gameContext);
+        return;
+    }
+    if (gameContext.sandboxMode)
+    {
+        updateSandbox(gameContext);
+    }
+    if (IsFrameMouseButtonPressed(gameContext.input, MOUSE_BUTTON_LEFT))
+    {
+        // SHIFT+LMB links the nodes in the sandbox (updateSandbox)
+        editor.dragNode = sandboxLinking(gameContext) ? InvalidNodeHandle : pickEditorNode(editor, mouse);
+        if (const PoolNode* node = GetPoolNode(editor.pool, editor.dragNode); node != nullptr)
+        {
+            editor.dragOffset = {node->data.position.x - mouse.x, node->data.position.y - mouse.y};
+            UpdateEditorCandidates(editor, editor.dragNode);
+        }
+    }
+    else if (IsFrameMouseButtonDown(gameContext.input, MOUSE_BUTTON_LEFT))
+    {
+        if (const PoolNode* node = GetPoolNode(editor.pool, editor.dragNode); node != nullptr)
+        {
+            // the whole node stays in the ConnectorArea
+            const auto radius = static_cast<float>(geometry::NodeRadius(node->data));
+            const Vector2 position{
+                std::clamp(
+                    mouse.x + editor.dragOffset.x,
+                    ConnectorArea.x + radius,
+                    ConnectorArea.x + ConnectorArea.width - radius),
+                std::clamp(
+                    mouse.y + editor.dragOffset.y,
+                    ConnectorArea.y + radius,
+                    ConnectorArea.y + ConnectorArea.height - radius)};
+            if (position.x != node->data.position.x || position.y != node->data.position.y)
+            {
+                // only the links near the node are checked again
+                MoveEditorNode(editor, editor.dragNode, position);
+                UpdateEditorCandidates(editor, editor.dragNode);
+                if (!gameContext.sandboxMode)
+                {
+                    gameContext.nodes[editor.dragNode.index].data.position = position;
+                    SetSpatialGridItem(gameContext.nodeGrid, editor.dragNode.index, position);
+                }
+            }
+        }
+    }
+    else if (IsFrameMouseButtonReleased(gameContext.input, MOUSE_BUTTON_LEFT) &&
+             editor.dragNode != InvalidNodeHandle)
+    {
+        editor.dragNode = InvalidNodeHandle;
+        editor.candidateLinks.clear();
+#ifndef NDEBUG
+        if (!ValidateEditorLinks(editor))
+        {
+            TraceLog(LOG_WARNING, "EDITOR: incremental link checks differ from checking all links");
+        }
+#endif
+    }
+
+    // edit the node (action or key)
+    if (IsFrameMouseButtonPressed(gameContext.input, MOUSE_BUTTON_RIGHT))
+    {
+        const NodeHandle handle = pickEditorNode(editor, mouse);
+        if (PoolNode* node = GetPoolNode(editor.pool, handle); node != nullptr)
+        {
+            nextNodeData(node->data);
+            if (!gameContext.sandboxMode)
+            {
+                gameContext.nodes[handle.index].data = node->data;
+                UpdateAllNodes(gameContext);
+            }
+        }
+    }
+
+    if (!gameContext.sandboxMode &&
+        (IsFrameKeyDown(gameContext.input, KEY_LEFT_CONTROL) || IsFrameKeyDown(gameContext.input, KEY_RIGHT_CONTROL)) &&
+        IsFrameKeyPressed(gameContext.input, KEY_S))
+    {
+        saveEditorLevel(gameContext);
+    }
+}
+
+void RenderNodeEditorScene(GameContext& gameContext)
+{
+    const auto& editor = gameContext.nodeEditor;
+    const auto& nodes = editor.pool.nodes;
+
+    // links, invalid links (with the current positions) highlighted
+    for (uint32_t i = 0; i < nodes.size(); ++i)
+    {
+        for (const auto& link : nodes[i].links)
+        {
+            if (nodes[i].alive && link.index > i)
+            {
+                const bool valid = GetEditorLinkResult(editor, i, link.index) == NodeLinkResult::Linked;
+                QueueLineEx(
+                    gameContext.renderQueue,
+                    RenderLayer::NodeLines,
+                    nodes[i].data.position,
+                    nodes[link.index].data.position,
+                    NodeLineThick,
+                    valid ? NodeLineColor : InvalidNodeLineColor);
+            }
+        }
+    }
+    // new link (sandbox)
+    if (const PoolNode* linkNode = GetPoolNode(editor.pool, editor.linkNode); linkNode != nullptr)
+    {
+        QueueLineEx(
+            gameContext.renderQueue,
+            RenderLayer::NodeLines,
+            linkNode->data.position,
+            gameContext.input.mousePosition,
+            CandidateNodeLineThick,
+            PreviewLineColor);
+    }
+    // links the dragged node could have
+    if (const PoolNode* dragNode = GetPoolNode(editor.pool, editor.dragNode); dragNode != nullptr)
+    {
+        for (const auto& candidate : editor.candidateLinks)
+        {
+            const bool valid = candidate.result == NodeLinkResult::Linked;
+            QueueLineEx(
+                gameContext.renderQueue,
+                RenderLayer::NodeLines,
+                dragNode->data.position,
+                nodes[candidate.node.index].data.position,
+                CandidateNodeLineThick,
+                valid ? PreviewLineColor : InvalidNodeLineColor);
+        }
+    }
+
+    QueueTextEx(
+        gameContext.renderQueue,
+        RenderLayer::Ui,
+        gameContext.font,
+        gameContext.sandboxMode ? SandboxHelperText : EditorHelperText,
+        {ConnectorArea.x + 8, ConnectorArea.y + ConnectorArea.height - 8 - SmallHelperTextFontSize},
+        SmallHelperTextFontSize,
+        SmallHelperTextFontSize / FontSpacingFactor,
+        TextFontColor);
+}
+
+//
+// internal editor logic
+//
+void applyNodeEditor(GameContext& gameContext)
+{
+    const auto& editor = gameContext.nodeEditor;
+    // the editor only moves nodes: connections that are invalid links now are removed, the others stay
+    // (also the ones the pool didn't take, see ToggleNodeEditor)
+    for (auto& node : gameContext.nodes)
+    {
+        for (auto& connectedNodeIndex : node.direct_connections)
+        {
+            if (connectedNodeIndex != -1 &&
+                GetEditorLinkResult(
+                    editor, static_cast<uint32_t>(node.index), static_cast<uint32_t>(connectedNodeIndex)) !=
+                    NodeLinkResult::Linked)
+            {
+                connectedNodeIndex = -1;
+            }
+        }
+    }
+    UpdateNodeGrid(gameContext);
+    UpdateAllNodes(gameContext);
+}
+
+void saveEditorLevel(GameContext& gameContext)
+{
+    const LevelData* levelData = GetLevelData(gameContext, gameContext.level);
+    if (levelData == nullptr)
+    {
+        return;
+    }
+    std::vector<NodeData> nodesData;
+    for (const auto& node : gameContext.nodes)
+    {
+        if (node.data.type != ConnectorType::DISABLED)
+        {
+            nodesData.push_back(node.data);
+        }
+    }
+    LevelData level = *levelData;
+    level.nodesData = nodesData;
+
+    std::string directory = gameContext.levelDirectory;
+    if (!directory.empty() && directory.back() != '/')
+    {
+        directory += '/';
+    }
+    const std::string fileName =
+        TextFormat(EditorLevelFileFormat, directory.c_str(), LevelFilePrefix, gameContext.level, LevelFileExtension);
+    if (SaveLevelFile(fileName.c_str(), level))
+    {
+        TraceLog(LOG_INFO, "EDITOR: level %d saved: %s", gameContext.level, fileName.c_str());
+    }
+    else
+    {
+        TraceLog(LOG_WARNING, "EDITOR: can't save level %d: %s", gameContext.level, fileName.c_str());
+    }
+}
+
+NodeHandle pickEditorNode(const NodeEditor& editor, Vector2 mouse)
+{
+    NodeHandle ret = InvalidNodeHandle;
+    QuerySpatialGridRect(
+        editor.pool.grid,
+        {mouse.x - MaxNodeRadius, mouse.y - MaxNodeRadius, 2 * MaxNodeRadius, 2 * MaxNodeRadius},
+        [&](uint32_t index)
+        {
+            const auto& node = editor.pool.nodes[index];
+            if (CheckCollisionPointCircle(
+                    mouse, node.data.position, static_cast<float>(geometry::NodeRadius(node.data))))
+            {
+                ret = {.index = index, .generation = node.generation};
+                return true;
+            }
+            return false;
+        });
+    return ret;
+}
+
+void updateEditorLayout(GameContext& gameContext)
+{
+    auto& editor = gameContext.nodeEditor;
+    const bool done = StepForceLayout(editor.layout, ForceLayoutStepsPerFrame);
+    ApplyForceLayout(editor.layout, editor.pool);
+    if (!gameContext.sandboxMode)
+    {
+        for (const NodeHandle handle : editor.layout.nodes)
+        {
+            if (const PoolNode* node = GetPoolNode(editor.pool, handle))
+            {
+                gameContext.nodes[handle.index].data.position = node->data.position;
+            }
+        }
+        UpdateNodeGrid(gameContext);
+    }
+    // all nodes moved, all links again
+    RevalidateEditorLinks(editor);
+    if (done)
+    {
+        editor.layoutRunning = false;
+        TraceLog(
+            LOG_INFO,
+            "EDITOR: auto-layout done after %d steps, %zu invalid links",
+            editor.layout.steps,
+            editor.invalidLinks.size());
+    }
+}
+
+void updateSandbox(GameContext& gameContext)
+{
+    auto& editor = gameContext.nodeEditor;
+    const auto& input = gameContext.input;
+    const Vector2 mouse = input.mousePosition;
+    const NodeHandle mouseNode = pickEditorNode(editor, mouse);
+
+    // new node under the mouse, the whole node in the ConnectorArea
+    const bool addAction = IsFrameKeyPressed(input, KEY_A);
+    const bool addKey = IsFrameKeyPressed(input, KEY_K);
+    if ((addAction || addKey) && mouseNode == InvalidNodeHandle && CheckCollisionPointRec(mouse, ConnectorArea))
+    {
+        const auto radius = static_cast<float>(MaxNodeRadius);
+        const Vector2 position{
+            std::clamp(mouse.x, ConnectorArea.x + radius, ConnectorArea.x + ConnectorArea.width - radius),
+            std::clamp(mouse.y, ConnectorArea.y + radius, ConnectorArea.y + ConnectorArea.height - radius)};
+        AddEditorNode(
+            editor,
+            addAction ? ActionNode(position, ConnectorAction::MovementRight) : KeyNode(position, ConnectorKey::G));
+    }
+    if ((IsFrameKeyPressed(input, KEY_X) || IsFrameKeyPressed(input, KEY_DELETE)) && mouseNode != InvalidNodeHandle)
+    {
+        RemoveEditorNode(editor, mouseNode);
+    }
+
+    // SHIFT+LMB on two nodes: link them, unlink when they are linked already
+    const bool linking = sandboxLinking(gameContext);
+    if (linking && IsFrameMouseButtonPressed(input, MOUSE_BUTTON_LEFT))
+    {
+        if (GetPoolNode(editor.pool, editor.linkNode) == nullptr || mouseNode == InvalidNodeHandle)
+        {
+            editor.linkNode = mouseNode;
+        }
+        else if (mouseNode != editor.linkNode)
+        {
+            if (!UnlinkEditorNodes(editor, editor.linkNode, mouseNode))
+            {
+                const NodeLinkResult result = LinkEditorNodes(editor, editor.linkNode, mouseNode);
+                if (result != NodeLinkResult::Linked)
+                {
+                    TraceLog(
+                        LOG_INFO,
+                        "EDITOR: no link %u - %u (%d)",
+                        editor.linkNode.index,
+                        mouseNode.index,
+                        static_cast<int>(result));
+                }
+            }
+            editor.linkNode = InvalidNodeHandle;
+        }
+    }
+    else if (!linking)
+    {
+        editor.linkNode = InvalidNodeHandle;
+    }
+
+    // new graph, a jittered grid with random links (GenerateSyntheticGraph)
+    if (IsFrameKeyPressed(input, KEY_G))
+    {
+        editor.pool = {};
+        editor.dragNode = InvalidNodeHandle;
+        editor.linkNode = InvalidNodeHandle;
+        editor.candidateLinks.clear();
+        const float inset = MaxNodeRadius;
+        GenerateSyntheticGraph(
+            editor.pool,
+            SandboxGraphNodes,
+            2 * SandboxGraphNodes,
+            {ConnectorArea.x + inset,
+             ConnectorArea.y + inset,
+             ConnectorArea.width - 2 * inset,
+             ConnectorArea.height - 2 * inset},
+            static_cast<uint32_t>(GetRandomValue(0, INT32_MAX)));
+        RevalidateEditorLinks(editor);
+        TraceLog(
+            LOG_INFO,
+            "EDITOR: sandbox graph, %zu nodes, %zu links",
+            editor.pool.nodeCount,
+            editor.pool.linkCount);
+    }
+}
+
+bool sandboxLinking(const GameContext& gameContext)
+{
+    return gameContext.sandboxMode &&
+           (IsFrameKeyDown(gameContext.input, KEY_LEFT_SHIFT) || IsFrameKeyDown(gameContext.input, KEY_RIGHT_SHIFT));
+}
+
+void nextNodeData(NodeData& data)
+{
+    switch (data.type)
+    {
+        case ConnectorType::DISABLED: break;
+        case ConnectorType::Action:
+            switch (data.action)
+            {
+                case ConnectorAction::NONE:
+                case ConnectorAction::Jump: data.action = ConnectorAction::MovementRight; break;
+                case ConnectorAction::MovementRight: data.action = ConnectorAction::MovementLeft; break;
+                case ConnectorAction::MovementLeft: data.action = ConnectorAction::MovementDown; break;
+                case ConnectorAction::MovementDown: data.action = ConnectorAction::MovementUp; break;
+                case ConnectorAction::MovementUp: data.action = ConnectorAction::Jump; break;
+            }
+            break;
+        case ConnectorType::Key:
+            switch (data.key)
+            {
+                case ConnectorKey::NONE:
+                case ConnectorKey::G: data.key = ConnectorKey::H; break;
+                case ConnectorKey::H: data.key = ConnectorKey::J; break;
+                case ConnectorKey::J: data.key = ConnectorKey::K; break;
+                case ConnectorKey::K: data.key = ConnectorKey::L; break;
+                case ConnectorKey::L: data.key = ConnectorKey::B; break;
+                case ConnectorKey::B: data.key = ConnectorKey::G; break;
+            }
+            break;
+    }
+}
@@ -5,8 +5,9 @@
 
 void UpdateEndScene(GameContext& gameContext)
 {
-    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) && CheckCollisionRecs(StartButtonRect, gameContext.mouse) ||
-        IsKeyPressed(KEY_ENTER))
+    if (IsFrameMouseButtonPressed(gameContext.input, MOUSE_BUTTON_LEFT) &&
+            CheckCollisionRecs(StartButtonRect, gameContext.mouse) ||
+        IsFrameKeyPressed(gameContext.input, KEY_ENTER))
     {
         // restart
         gameContext.playerCurrentKey = ConnectorKey::NONE;
@@ -21,16 +22,20 @@ void UpdateEndScene(GameContext& gameContext)
 void RenderEndScene(GameContext& gameContext)
 {
     // title
-    DrawTexture(
-        gameContext.logoTexture,
-        ConnectorArea.x + ConnectorArea.width / 2 - gameContext.logoTexture.width / 2,
-        ConnectorArea.y + 72,
+    QueueTextureRec(
+        gameContext.renderQueue,
+        RenderLayer::Ui,
+        gameContext.atlasTexture,
+        AtlasLogoRect,
+        {ConnectorArea.x + ConnectorArea.width / 2 - AtlasLogoRect.width / 2, ConnectorArea.y + 72},
         NeutralTintColor);
 
     // show welcome text
     const auto endTextSize =
         MeasureTextEx(gameContext.font, EndText, EndTextFontSize, EndTextFontSize / FontSpacingFactor);
-    DrawTextEx(
+    QueueTextEx(
+        gameContext.renderQueue,
+        RenderLayer::Ui,
         gameContext.font,
         EndText,
         {LevelArea.x + LevelArea.width / 2 - endTextSize.x / 2, LevelArea.y + 64},
@@ -45,8 +50,15 @@ void RenderEndScene(GameContext& gameContext)
         StartButtonTextFontSize / FontSpacingFactor);
     const auto startButtonColor =
         (CheckCollisionRecs(StartButtonRect, gameContext.mouse)) ? ButtonHoverColor : ButtonColor;
-    DrawRectangleLinesEx(StartButtonRect, ButtonLineThick, startButtonColor);
-    DrawTextEx(
+    QueueRectangleLinesEx(
+        gameContext.renderQueue,
+        RenderLayer::Ui,
+        StartButtonRect,
+        ButtonLineThick,
+        startButtonColor);
+    QueueTextEx(
+        gameContext.renderQueue,
+        RenderLayer::Ui,
         gameContext.font,
         EndStartButtonText,
         {StartButtonRect.x + StartButtonRect.width / 2 - startButtonTextSize.x / 2,
@@ -55,9 +67,12 @@ void RenderEndScene(GameContext& gameContext)
         StartButtonTextFontSize / FontSpacingFactor,
         startButtonColor);
 
-    DrawTexture(
-        gameContext.endTexture,
-        LevelArea.x + LevelArea.width / 2 - EndSpriteWidth / 2 - 25,
-        LevelArea.y + LevelArea.height / 2 - EndSpriteHeight / 2 + 15,
+    QueueTextureRec(
+        gameContext.renderQueue,
+        RenderLayer::Ui,
+        gameContext.atlasTexture,
+        AtlasEndRect,
+        {LevelArea.x + LevelArea.width / 2 - EndSpriteWidth / 2 - 25,
+         LevelArea.y + LevelArea.height / 2 - EndSpriteHeight / 2 + 15},
         NeutralTintColor);
 }
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include "env_runner.h"
+#include <algorithm>
+
+/// smaller batches are not worth waking up a worker
+inline constexpr size_t MinEnvsPerWorker = 256;
+
+static size_t rangeBegin(const EnvRunner& runner, size_t range)
+{
+    return runner.envs.size() * range / (runner.workers.size() + 1);
+}
+
+static void stepRange(EnvRunner& runner, size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        auto& env = runner.envs[i];
+        const EnvStepResult result = StepEnv(env, runner.actions[i]);
+        runner.rewards[i] = result.reward;
+        runner.dones[i] = result.done ? 1 : 0;
+        if (result.done)
+        {
+            ResetEnv(env, *runner.level);
+        }
+        EncodeEnvObservation(env, GetEnvObservation(runner, i));
+    }
+}
+
+static void envWorker(EnvRunner& runner, size_t range)
+{
+    uint64_t generation = 0;
+    while (true)
+    {
+        {
+            std::unique_lock lock{runner.mutex};
+            runner.startStep.wait(lock, [&] { return runner.stop || runner.generation != generation; });
+            if (runner.stop)
+            {
+                return;
+            }
+            generation = runner.generation;
+        }
+        stepRange(runner, rangeBegin(runner, range), rangeBegin(runner, range + 1));
+        {
+            std::lock_guard lock{runner.mutex};
+            if (--runner.runningWorkers == 0)
+            {
+                runner.finishedStep.notify_one();
+            }
+        }
+    }
+}
+
+void StartEnvRunner(EnvRunner& runner, const EnvLevel& level, size_t envCount, int threadCount)
+{
+    StopEnvRunner(runner);
+    runner.level = &level;
+    runner.envs.resize(envCount);
+    runner.observations.assign(envCount * EnvObservationSize, 0);
+    runner.rewards.assign(envCount, 0.0f);
+    runner.dones.assign(envCount, 0);
+    for (size_t i = 0; i < envCount; ++i)
+    {
+        ResetEnv(runner.envs[i], level);
+        EncodeEnvObservation(runner.envs[i], GetEnvObservation(runner, i));
+    }
+
+#if !defined(PLATFORM_WEB)
+    const auto hardwareThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    const auto maxThreads = static_cast<int>(std::max<size_t>(1, envCount / MinEnvsPerWorker));
+    const int workerCount = std::min((threadCount > 0) ? threadCount : hardwareThreads, maxThreads) - 1;
+    runner.stop = false;
+    runner.generation = 0;
+    runner.workers.reserve(workerCount);
+    for (int i = 0; i < workerCount; ++i)
+    {
+        runner.workers.emplace_back(envWorker, std::ref(runner), static_cast<size_t>(i + 1));
+    }
+#endif
+}
+
+void StepEnvRunner(EnvRunner& runner, std::span<const int> actions)
+{
+    if (actions.size() < runner.envs.size())
+    {
+        return;
+    }
+    if (runner.workers.empty())
+    {
+        runner.actions = actions;
+        stepRange(runner, 0, runner.envs.size());
+        return;
+    }
+
+    {
+        std::lock_guard lock{runner.mutex};
+        runner.actions = actions;
+        runner.runningWorkers = static_cast<int>(runner.workers.size());
+        ++runner.generation;
+    }
+    runner.startStep.notify_all();
+    stepRange(runner, 0, rangeBegin(runner, 1));
+
+    std::unique_lock lock{runner.mutex};
+    runner.finishedStep.wait(lock, [&] { return runner.runningWorkers == 0; });
+}
+
+void StopEnvRunner(EnvRunner& runner)
+{
+    {
+        std::lock_guard lock{runner.mutex};
+        runner.stop = true;
+    }
+    runner.startStep.notify_all();
+    for (auto& worker : runner.workers)
+    {
+        worker.join();
+    }
+    runner.workers.clear();
+}
+
+EnvRunner::~EnvRunner()
+{
+    StopEnvRunner(*this);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "game_env.h"
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+/// steps many environments (same level) at once, split into contiguous ranges on worker threads
+/// observations, rewards and dones are preallocated contiguous buffers (env i: observations[i * EnvObservationSize])
+/// finished environments are reset in the same step (observation of the new episode, reward and done of the old one)
+/// @NOTE: no threads on Web, all environments are stepped on the calling thread
+struct EnvRunner
+{
+    const EnvLevel* level{nullptr};
+    std::vector<GameEnv> envs;
+    std::vector<uint8_t> observations;
+    std::vector<float> rewards;
+    std::vector<uint8_t> dones;
+
+    // workers (range 0 is stepped by the calling thread)
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable startStep;
+    std::condition_variable finishedStep;
+    std::span<const int> actions;
+    uint64_t generation{0};
+    int runningWorkers{0};
+    bool stop{false};
+
+    EnvRunner() = default;
+    EnvRunner(const EnvRunner&) = delete;
+    EnvRunner& operator=(const EnvRunner&) = delete;
+    ~EnvRunner();
+};
+
+/// reset envCount environments, threadCount: 0 = hardware threads
+extern void StartEnvRunner(EnvRunner& runner, const EnvLevel& level, size_t envCount, int threadCount);
+/// one action per environment (actions.size() >= envs.size()), blocks until all environments are stepped
+extern void StepEnvRunner(EnvRunner& runner, std::span<const int> actions);
+extern void StopEnvRunner(EnvRunner& runner);
+
+[[nodiscard]] inline EnvObservation GetEnvObservation(EnvRunner& runner, size_t env)
+{
+    return EnvObservation{runner.observations.data() + env * EnvObservationSize, EnvObservationSize};
+}
@@ -0,0 +1,318 @@
+#include "force_layout.h"
+#include "geometry.h"
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+void InitForceLayout(ForceLayout& layout, const NodePool& pool, const ForceLayoutSettings& settings)
+{
+    layout.settings = settings;
+    layout.nodes.clear();
+    layout.positions.clear();
+    layout.radius.clear();
+    layout.links.clear();
+    std::unordered_map<uint32_t, uint32_t> layoutIndex;
+    layoutIndex.reserve(pool.nodeCount);
+    for (uint32_t i = 0; i < pool.nodes.size(); ++i)
+    {
+        const auto& node = pool.nodes[i];
+        if (node.alive)
+        {
+            layoutIndex[i] = static_cast<uint32_t>(layout.nodes.size());
+            layout.nodes.push_back({.index = i, .generation = node.generation});
+            layout.positions.push_back(node.data.position);
+            layout.radius.push_back(static_cast<float>(geometry::NodeRadius(node.data)));
+        }
+    }
+    for (uint32_t i = 0; i < pool.nodes.size(); ++i)
+    {
+        for (const auto& link : pool.nodes[i].links)
+        {
+            if (pool.nodes[i].alive && link.index > i)
+            {
+                layout.links.emplace_back(layoutIndex[i], layoutIndex[link.index]);
+            }
+        }
+    }
+    layout.displacements.assign(layout.nodes.size(), {0, 0});
+
+    // Fruchterman-Reingold: k = sqrt(area / nodes), at least the space of two nodes
+    const float area = settings.area.width * settings.area.height;
+    const float count = std::max(1.0f, static_cast<float>(layout.nodes.size()));
+    layout.linkLength = (settings.idealLinkLength > 0.0f)
+                            ? settings.idealLinkLength
+                            : std::max(std::sqrt(area / count), 1.5f * (2 * MaxNodeRadius + settings.nodeSpacing));
+    layout.temperature = 0.1f * std::max(settings.area.width, settings.area.height);
+    layout.steps = 0;
+}
+
+bool IsForceLayoutDone(const ForceLayout& layout)
+{
+    return layout.nodes.empty() || layout.steps >= layout.settings.maxSteps || layout.temperature < 0.1f;
+}
+
+/// quadtree
+static int32_t addQuad(ForceLayout& layout, float x, float y, float size)
+{
+    layout.tree.push_back({.x = x, .y = y, .size = size});
+    return static_cast<int32_t>(layout.tree.size() - 1);
+}
+static int32_t childQuad(ForceLayout& layout, int32_t quad, Vector2 position)
+{
+    const float half = 0.5f * layout.tree[quad].size;
+    const int right = (position.x >= layout.tree[quad].x + half) ? 1 : 0;
+    const int bottom = (position.y >= layout.tree[quad].y + half) ? 1 : 0;
+    const int child = right + 2 * bottom;
+    if (layout.tree[quad].children[child] == -1)
+    {
+        const int32_t index = addQuad(
+            layout,
+            layout.tree[quad].x + static_cast<float>(right) * half,
+            layout.tree[quad].y + static_cast<float>(bottom) * half,
+            half);
+        layout.tree[quad].children[child] = index;
+    }
+    return layout.tree[quad].children[child];
+}
+static void addMass(ForceLayoutQuad& quad, Vector2 position)
+{
+    quad.centerX = (quad.centerX * quad.mass + position.x) / (quad.mass + 1.0f);
+    quad.centerY = (quad.centerY * quad.mass + position.y) / (quad.mass + 1.0f);
+    quad.mass += 1.0f;
+}
+static void insertBody(ForceLayout& layout, int32_t body)
+{
+    const Vector2 position = layout.positions[body];
+    int32_t quad = 0;
+    for (int depth = 0;; ++depth)
+    {
+        auto& cell = layout.tree[quad];
+        const bool leaf = cell.children == std::array<int32_t, 4>{-1, -1, -1, -1};
+        if (leaf && cell.mass == 0.0f)
+        {
+            cell.body = body;
+            addMass(cell, position);
+            return;
+        }
+        if (leaf && depth >= ForceLayoutMaxTreeDepth)
+        {
+            // same position (or very close), one point mass
+            addMass(cell, position);
+            return;
+        }
+        if (leaf)
+        {
+            // split: the node of the leaf moves into a child
+            const int32_t other = cell.body;
+            cell.body = -1;
+            const int32_t otherQuad = childQuad(layout, quad, layout.positions[other]);
+            layout.tree[otherQuad].body = other;
+            addMass(layout.tree[otherQuad], layout.positions[other]);
+        }
+        addMass(layout.tree[quad], position);
+        quad = childQuad(layout, quad, position);
+    }
+}
+static void buildTree(ForceLayout& layout)
+{
+    layout.tree.clear();
+    float minX = layout.positions[0].x;
+    float minY = layout.positions[0].y;
+    float maxX = minX;
+    float maxY = minY;
+    for (const auto& position : layout.positions)
+    {
+        minX = std::min(minX, position.x);
+        minY = std::min(minY, position.y);
+        maxX = std::max(maxX, position.x);
+        maxY = std::max(maxY, position.y);
+    }
+    addQuad(layout, minX, minY, std::max(maxX - minX, maxY - minY) + 1.0f);
+    for (int32_t i = 0; i < static_cast<int32_t>(layout.positions.size()); ++i)
+    {
+        insertBody(layout, i);
+    }
+}
+
+/// repulsion of all nodes on body (k^2 / d), cells far enough away (size / d < theta) are one point mass
+static Vector2 repulsion(const ForceLayout& layout, int32_t body)
+{
+    const float k2 = layout.linkLength * layout.linkLength;
+    const float theta2 = layout.settings.theta * layout.settings.theta;
+    const Vector2 position = layout.positions[body];
+    Vector2 force{0, 0};
+    std::array<int32_t, 4 * ForceLayoutMaxTreeDepth + 4> stack{};
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0)
+    {
+        const auto& quad = layout.tree[stack[--stackSize]];
+        float dx = position.x - quad.centerX;
+        float dy = position.y - quad.centerY;
+        float d2 = dx * dx + dy * dy;
+        const bool leaf = quad.body != -1;
+        if (!leaf && quad.size * quad.size >= theta2 * d2)
+        {
+            for (const int32_t child : quad.children)
+            {
+                if (child != -1)
+                {
+                    stack[stackSize++] = child;
+                }
+            }
+            continue;
+        }
+        const float mass = (quad.body == body) ? quad.mass - 1.0f : quad.mass;
+        if (mass <= 0.0f)
+        {
+            continue;
+        }
+        if (d2 < 0.01f)
+        {
+            // same position: push apart in a direction by index
+            dx = std::cos(static_cast<float>(body));
+            dy = std::sin(static_cast<float>(body));
+            d2 = 0.01f;
+        }
+        const float d = std::sqrt(d2);
+        float strength = k2 * mass / d;
+        if (leaf && quad.body != body)
+        {
+            // nodes closer than their radius + spacing push harder
+            const float minDistance = layout.radius[body] + layout.radius[quad.body] + layout.settings.nodeSpacing;
+            if (d < minDistance)
+            {
+                strength *= (minDistance / d) * (minDistance / d);
+            }
+        }
+        force.x += dx / d * strength;
+        force.y += dy / d * strength;
+    }
+    return force;
+}
+
+bool StepForceLayout(ForceLayout& layout, int steps)
+{
+    for (int step = 0; step < steps && !IsForceLayoutDone(layout); ++step)
+    {
+        buildTree(layout);
+        const auto& area = layout.settings.area;
+        const Vector2 center{area.x + 0.5f * area.width, area.y + 0.5f * area.height};
+        // the repulsion of n nodes spread evenly in a circle (radius r) grows with k^2 * n * d / r^2,
+        // same pull to the center: the nodes fill the circle inside the area (gravity 1)
+        const float areaRadius = 0.5f * std::min(area.width, area.height);
+        const float gravity = layout.settings.gravity * layout.linkLength * layout.linkLength *
+                              static_cast<float>(layout.positions.size()) / std::max(1.0f, areaRadius * areaRadius);
+        for (int32_t i = 0; i < static_cast<int32_t>(layout.positions.size()); ++i)
+        {
+            layout.displacements[i] = repulsion(layout, i);
+            layout.displacements[i].x += (center.x - layout.positions[i].x) * gravity;
+            layout.displacements[i].y += (center.y - layout.positions[i].y) * gravity;
+        }
+        // links: d^2 / k
+        for (const auto& [node1, node2] : layout.links)
+        {
+            const float dx = layout.positions[node1].x - layout.positions[node2].x;
+            const float dy = layout.positions[node1].y - layout.positions[node2].y;
+            const float d = std::sqrt(dx * dx + dy * dy);
+            if (d > 0.0f)
+            {
+                const float strength = d / layout.linkLength;
+                layout.displacements[node1].x -= dx * strength;
+                layout.displacements[node1].y -= dy * strength;
+                layout.displacements[node2].x += dx * strength;
+                layout.displacements[node2].y += dy * strength;
+            }
+        }
+        // move (at most temperature), the whole node stays inside the area
+        for (size_t i = 0; i < layout.positions.size(); ++i)
+        {
+            const Vector2 displacement = layout.displacements[i];
+            const float length = std::sqrt(displacement.x * displacement.x + displacement.y * displacement.y);
+            if (length > 0.0f)
+            {
+                const float move = std::min(length, layout.temperature) / length;
+                layout.positions[i].x += displacement.x * move;
+                layout.positions[i].y += displacement.y * move;
+            }
+            const float radius = layout.radius[i];
+            layout.positions[i].x = std::clamp(
+                layout.positions[i].x, area.x + radius, std::max(area.x + radius, area.x + area.width - radius));
+            layout.positions[i].y = std::clamp(
+                layout.positions[i].y, area.y + radius, std::max(area.y + radius, area.y + area.height - radius));
+        }
+        layout.temperature *= layout.settings.cooling;
+        ++layout.steps;
+    }
+    return IsForceLayoutDone(layout);
+}
+
+void ApplyForceLayout(const ForceLayout& layout, NodePool& pool)
+{
+    for (size_t i = 0; i < layout.nodes.size(); ++i)
+    {
+        // a node added into the slot of a removed node is not part of the layout
+        MovePoolNode(pool, layout.nodes[i], layout.positions[i]);
+    }
+}
+
+/// worker
+static void runForceLayout(ForceLayoutWorker& worker)
+{
+    while (!worker.cancel.load(std::memory_order_relaxed) && !StepForceLayout(worker.layout))
+    {
+    }
+    worker.ready.store(true, std::memory_order_release);
+}
+
+void StartForceLayoutWorker(ForceLayoutWorker& worker, const NodePool& pool, const ForceLayoutSettings& settings)
+{
+    CancelForceLayoutWorker(worker);
+    InitForceLayout(worker.layout, pool, settings);
+#if defined(PLATFORM_WEB)
+    worker.pending = true;
+#else
+    worker.worker = std::thread{runForceLayout, std::ref(worker)};
+#endif
+}
+
+void CancelForceLayoutWorker(ForceLayoutWorker& worker)
+{
+    worker.cancel = true;
+    if (worker.worker.joinable())
+    {
+        worker.worker.join();
+    }
+    worker.cancel = false;
+    worker.pending = false;
+    worker.ready = false;
+}
+
+void UpdateForceLayoutWorker(ForceLayoutWorker& worker)
+{
+    if (worker.pending && StepForceLayout(worker.layout, ForceLayoutStepsPerFrame))
+    {
+        worker.pending = false;
+        worker.ready.store(true, std::memory_order_release);
+    }
+}
+
+bool TakeForceLayout(ForceLayoutWorker& worker, NodePool& pool)
+{
+    if (!worker.ready.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+    if (worker.worker.joinable())
+    {
+        worker.worker.join();
+    }
+    ApplyForceLayout(worker.layout, pool);
+    worker.ready = false;
+    return true;
+}
+
+ForceLayoutWorker::~ForceLayoutWorker()
+{
+    CancelForceLayoutWorker(*this);
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "constants.h"
+#include "node_pool.h"
+#include "types.h"
+#include <raylib.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/// force-directed layout (Fruchterman-Reingold) for sandbox graphs and generated levels:
+/// links pull their nodes together, all nodes push each other away (Barnes-Hut quadtree, O(N log N) per step),
+/// nodes stay inside the area and keep their radius (ActionNodeRadius, KeyNodeRadius) + nodeSpacing apart
+/// @NOTE: the layout works on its own copy of the positions, steps can run across frames (StepForceLayout)
+///        or on a worker (ForceLayoutWorker), ApplyForceLayout writes the positions back into the NodePool
+inline constexpr int ForceLayoutStepsPerFrame = 4;
+inline constexpr int ForceLayoutMaxTreeDepth = 24; ///< nodes at the same position share a leaf
+
+/// Types
+struct ForceLayoutSettings
+{
+    Rectangle area{ConnectorArea};
+    float idealLinkLength{0.0f}; ///< 0: from the area and the node count
+    float nodeSpacing{4.0f}; ///< between the node circles
+    float theta{0.8f}; ///< Barnes-Hut opening angle, 0: exact (all pairs)
+    float gravity{1.0f}; ///< pull to the center of the area, 1: the nodes fill the circle inside the area
+    float cooling{0.97f}; ///< max. move per step shrinks by this factor
+    int maxSteps{400};
+};
+
+/// quadtree cell, point mass of all nodes inside
+struct ForceLayoutQuad
+{
+    float centerX{0};
+    float centerY{0};
+    float mass{0};
+    float x{0};
+    float y{0};
+    float size{0};
+    std::array<int32_t, 4> children{-1, -1, -1, -1};
+    int32_t body{-1}; ///< leaf: first node inside, -1 for inner cells
+};
+
+struct ForceLayout
+{
+    ForceLayoutSettings settings;
+    std::vector<NodeHandle> nodes; ///< pool nodes of the layout, removed in the meantime: skipped by ApplyForceLayout
+    std::vector<Vector2> positions;
+    std::vector<Vector2> displacements;
+    std::vector<float> radius;
+    std::vector<std::pair<uint32_t, uint32_t>> links; ///< layout node indices
+    std::vector<ForceLayoutQuad> tree; ///< rebuilt every step
+    float linkLength{0}; ///< ideal link length (k)
+    float temperature{0}; ///< max. move per step
+    int steps{0};
+};
+
+/// copies the alive nodes and links of the pool
+extern void InitForceLayout(ForceLayout& layout, const NodePool& pool, const ForceLayoutSettings& settings = {});
+/// runs up to steps steps, returns true when the layout is done (cooled down or maxSteps)
+extern bool StepForceLayout(ForceLayout& layout, int steps = 1);
+[[nodiscard]] extern bool IsForceLayoutDone(const ForceLayout& layout);
+/// moves the pool nodes (MovePoolNode) to the layout positions, nodes removed since InitForceLayout are skipped
+extern void ApplyForceLayout(const ForceLayout& layout, NodePool& pool);
+
+/// runs a layout on a worker thread until it's done
+/// @NOTE: no threads on Web, ForceLayoutStepsPerFrame steps per UpdateForceLayoutWorker on the main thread
+struct ForceLayoutWorker
+{
+    std::thread worker;
+    std::atomic<bool> pending{false}; ///< started, steps run on the main thread (Web)
+    std::atomic<bool> cancel{false};
+    std::atomic<bool> ready{false};
+    ForceLayout layout; ///< written by the worker until ready
+
+    ForceLayoutWorker() = default;
+    ForceLayoutWorker(const ForceLayoutWorker&) = delete;
+    ForceLayoutWorker& operator=(const ForceLayoutWorker&) = delete;
+    ~ForceLayoutWorker();
+};
+
+extern void StartForceLayoutWorker(
+    ForceLayoutWorker& worker, const NodePool& pool, const ForceLayoutSettings& settings = {});
+/// stops the worker (after the current step), drops the layout
+extern void CancelForceLayoutWorker(ForceLayoutWorker& worker);
+/// call every frame (Web)
+extern void UpdateForceLayoutWorker(ForceLayoutWorker& worker);
+/// applies the layout when it's done, returns false while it's running (or not started)
+extern bool TakeForceLayout(ForceLayoutWorker& worker, NodePool& pool);
@@ -0,0 +1,31 @@
+#include "frame_input.h"
+
+void PollFrameInput(FrameInput& input)
+{
+    for (int key = 1; key < FrameInputMaxKeys; ++key)
+    {
+        input.keysDown[key] = IsKeyDown(key);
+        input.keysPressed[key] = IsKeyPressed(key);
+    }
+    for (int button = 0; button < FrameInputMaxMouseButtons; ++button)
+    {
+        input.mouseButtonsDown[button] = IsMouseButtonDown(button);
+        input.mouseButtonsPressed[button] = IsMouseButtonPressed(button);
+        input.mouseButtonsReleased[button] = IsMouseButtonReleased(button);
+    }
+    input.mousePosition = GetMousePosition();
+    input.frameTime = GetFrameTime();
+    input.time = GetTime();
+}
+
+void MergeFrameInput(FrameInput& pending, const FrameInput& input)
+{
+    pending.keysDown = input.keysDown;
+    pending.keysPressed |= input.keysPressed;
+    pending.mouseButtonsDown = input.mouseButtonsDown;
+    pending.mouseButtonsPressed |= input.mouseButtonsPressed;
+    pending.mouseButtonsReleased |= input.mouseButtonsReleased;
+    pending.mousePosition = input.mousePosition;
+    pending.frameTime += input.frameTime;
+    pending.time = input.time;
+}
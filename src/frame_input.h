@@ -0,0 +1,48 @@
+#pragma once
+
+#include <raylib.h>
+#include <bitset>
+
+/// input of a frame, polled on the main thread (raylib polls the events in EndDrawing),
+/// the game logic reads this (GameContext::input) instead of raylib, so it can run on another thread (logic_thread.h)
+inline constexpr int FrameInputMaxKeys = 512; ///< raylib MAX_KEYBOARD_KEYS
+inline constexpr int FrameInputMaxMouseButtons = 8; ///< raylib MAX_MOUSE_BUTTONS
+
+/// Types
+struct FrameInput
+{
+    std::bitset<FrameInputMaxKeys> keysDown;
+    std::bitset<FrameInputMaxKeys> keysPressed;
+    std::bitset<FrameInputMaxMouseButtons> mouseButtonsDown;
+    std::bitset<FrameInputMaxMouseButtons> mouseButtonsPressed;
+    std::bitset<FrameInputMaxMouseButtons> mouseButtonsReleased;
+    Vector2 mousePosition{0, 0};
+    float frameTime{0.0f}; ///< seconds since the last update (GetFrameTime)
+    double time{0.0}; ///< GetTime
+};
+
+/// main thread, once per frame
+extern void PollFrameInput(FrameInput& input);
+/// input of frames the logic has not seen yet: presses and releases are kept, the rest is the latest state
+extern void MergeFrameInput(FrameInput& pending, const FrameInput& input);
+
+[[nodiscard]] inline bool IsFrameKeyDown(const FrameInput& input, int key)
+{
+    return key > 0 && key < FrameInputMaxKeys && input.keysDown[key];
+}
+[[nodiscard]] inline bool IsFrameKeyPressed(const FrameInput& input, int key)
+{
+    return key > 0 && key < FrameInputMaxKeys && input.keysPressed[key];
+}
+[[nodiscard]] inline bool IsFrameMouseButtonDown(const FrameInput& input, int button)
+{
+    return button >= 0 && button < FrameInputMaxMouseButtons && input.mouseButtonsDown[button];
+}
+[[nodiscard]] inline bool IsFrameMouseButtonPressed(const FrameInput& input, int button)
+{
+    return button >= 0 && button < FrameInputMaxMouseButtons && input.mouseButtonsPressed[button];
+}
+[[nodiscard]] inline bool IsFrameMouseButtonReleased(const FrameInput& input, int button)
+{
+    return button >= 0 && button < FrameInputMaxMouseButtons && input.mouseButtonsReleased[button];
+}
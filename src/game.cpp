@@ -1,124 +1,259 @@
 #include "game.h"
 #include "constants.h"
+#include "level_pack.h"
+#include "level_prefetch.h"
+#include "levels.h"
+#include "tile_map.h"
 #include "types.h"
 #include <raylib.h>
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <unordered_map>
+#include <utility>
 #include <vector>
-// Levels
-#include "level1.h"
-#include "level2.h"
-#include "level3.h"
-#include "level4.h"
-#include "level5.h"
 
 //
 // global game functions
 //
+static void startLevel(GameContext& gameContext, int level, const LevelData* levelData);
+static void prefetchNextLevel(GameContext& gameContext);
+/// level without decoding (level files, compiled-in levels, decoded level pack levels), nullptr when not decoded yet
+static const LevelData* findLevelData(const GameContext& gameContext, int level)
+{
+    if (level >= 1 && level <= static_cast<int>(gameContext.levelFiles.size()) &&
+        gameContext.levelFiles[level - 1] != nullptr)
+    {
+        return &gameContext.levelFiles[level - 1]->data;
+    }
+    return (gameContext.levelPack.levelCount > 0) ? FindLevelPackLevel(gameContext.levelPack, level)
+                                                  : GetBuiltinLevel(level);
+}
+const LevelData* GetLevelData(GameContext& gameContext, int level)
+{
+    if (const LevelData* levelData = findLevelData(gameContext, level))
+    {
+        return levelData;
+    }
+    return (gameContext.levelPack.levelCount > 0) ? GetLevelPackLevel(gameContext.levelPack, level) : nullptr;
+}
 void SetLevel(GameContext& gameContext, int level)
+{
+    // the prepared level may be the old version (level files)
+    CancelLevelPrefetch(gameContext.levelPrefetch);
+    const LevelData* levelData = GetLevelData(gameContext, level);
+    if (levelData != nullptr)
+    {
+        gameContext.nodes = CreateLevelNodes(levelData->nodesData);
+        LoadLevelTileMap(gameContext.map, *levelData);
+    }
+    startLevel(gameContext, level, levelData);
+}
+void startLevel(GameContext& gameContext, int level, const LevelData* levelData)
 {
     using fsec = std::chrono::duration<float>;
-    gameContext.startTime = std::chrono::duration_cast<std::chrono::milliseconds>(fsec{GetTime()});
+    gameContext.startTime = std::chrono::duration_cast<std::chrono::milliseconds>(fsec{gameContext.input.time});
     gameContext.state = GameState::NodesMain;
     gameContext.level = level;
     gameContext.levelConnections = 0;
+    gameContext.editorMode = false;
+    gameContext.sandboxMode = false;
     gameContext.playerCurrentKey = ConnectorKey::NONE;
     gameContext.playerActionIndex = -1;
     gameContext.deathCount = 0;
-    switch (gameContext.level)
+    if (levelData != nullptr)
     {
-        case 1:
-            gameContext.nodes = CreateLevelNodes(level1::NodesData);
-            gameContext.mapData = &level1::MapData;
-            gameContext.playerTilesPosition = level1::CharacterStartTilesPosition;
-            gameContext.playerStartTilesPosition = level1::CharacterStartTilesPosition;
-            gameContext.playerStartDirection = level1::CharacterStartDirection;
-            gameContext.playerDirection = level1::CharacterStartDirection;
-            gameContext.levelMaxNodeConnections = level1::MaxNodeConnections;
-            gameContext.levelMaxActionsPerKey = level1::MaxActionsPerKey;
-            gameContext.showHelp2 = true;
-            break;
-        case 2:
-            gameContext.nodes = CreateLevelNodes(level2::NodesData);
-            gameContext.mapData = &level2::MapData;
-            gameContext.playerTilesPosition = level2::CharacterStartTilesPosition;
-            gameContext.playerStartTilesPosition = level2::CharacterStartTilesPosition;
-            gameContext.playerStartDirection = level2::CharacterStartDirection;
-            gameContext.playerDirection = level2::CharacterStartDirection;
-            gameContext.levelMaxNodeConnections = level2::MaxNodeConnections;
-            gameContext.levelMaxActionsPerKey = level2::MaxActionsPerKey;
-            if (!gameContext.manuelHelp)
-            {
-                gameContext.showHelp2 = true;
-            }
-            break;
-        case 3:
-            gameContext.nodes = CreateLevelNodes(level3::NodesData);
-            gameContext.mapData = &level3::MapData;
-            gameContext.playerTilesPosition = level3::CharacterStartTilesPosition;
-            gameContext.playerStartTilesPosition = level3::CharacterStartTilesPosition;
-            gameContext.playerStartDirection = level3::CharacterStartDirection;
-            gameContext.playerDirection = level3::CharacterStartDirection;
-            gameContext.levelMaxNodeConnections = level3::MaxNodeConnections;
-            gameContext.levelMaxActionsPerKey = level3::MaxActionsPerKey;
-            if (!gameContext.manuelHelp)
-            {
-                gameContext.showHelp2 = true;
-            }
-            break;
-        case 4:
-            gameContext.nodes = CreateLevelNodes(level4::NodesData);
-            gameContext.mapData = &level4::MapData;
-            gameContext.playerTilesPosition = level4::CharacterStartTilesPosition;
-            gameContext.playerStartTilesPosition = level4::CharacterStartTilesPosition;
-            gameContext.playerStartDirection = level4::CharacterStartDirection;
-            gameContext.playerDirection = level4::CharacterStartDirection;
-            gameContext.levelMaxNodeConnections = level4::MaxNodeConnections;
-            gameContext.levelMaxActionsPerKey = level4::MaxActionsPerKey;
-            break;
-        case 5:
-            gameContext.nodes = CreateLevelNodes(level5::NodesData);
-            gameContext.mapData = &level5::MapData;
-            gameContext.playerTilesPosition = level5::CharacterStartTilesPosition;
-            gameContext.playerStartTilesPosition = level5::CharacterStartTilesPosition;
-            gameContext.playerStartDirection = level5::CharacterStartDirection;
-            gameContext.playerDirection = level5::CharacterStartDirection;
-            gameContext.levelMaxNodeConnections = level5::MaxNodeConnections;
-            gameContext.levelMaxActionsPerKey = level5::MaxActionsPerKey;
-            break;
-            /// @TODO: add (new) levels, don't forget to update MaxLevels
-        default: TraceLog(LOG_ERROR, "Error Not Found: %i", gameContext.level);
+        gameContext.playerStartTilesPosition = {
+            static_cast<int>(levelData->characterStartTilesPosition.x),
+            static_cast<int>(levelData->characterStartTilesPosition.y)};
+        gameContext.playerTilesPosition = gameContext.playerStartTilesPosition;
+        gameContext.playerStartDirection = levelData->characterStartDirection;
+        gameContext.playerDirection = levelData->characterStartDirection;
+        gameContext.levelMaxNodeConnections = levelData->maxNodeConnections;
+        gameContext.levelMaxActionsPerKey = levelData->maxActionsPerKey;
+        gameContext.levelConnectionRules = levelData->connectionRules;
+        switch (levelData->guidelines)
+        {
+            case LevelGuidelines::Keep: break;
+            case LevelGuidelines::Suggest:
+                if (!gameContext.manuelHelp)
+                {
+                    gameContext.showHelp2 = true;
+                }
+                break;
+            case LevelGuidelines::Force: gameContext.showHelp2 = true; break;
+        }
+    }
+    else
+    {
+        TraceLog(LOG_ERROR, "Error Not Found: %i", gameContext.level);
     }
+    gameContext.validateConnection = GetConnectionValidator(gameContext.levelConnectionRules);
+    UpdateNodeGrid(gameContext);
     UpdateAllNodes(gameContext);
 
     gameContext.levelHelperText = TextFormat(LevelsHelperFormat, gameContext.level);
+
+    prefetchNextLevel(gameContext);
+}
+void prefetchNextLevel(GameContext& gameContext)
+{
+    if (gameContext.level >= 1 && gameContext.level < GetLevelCount(gameContext))
+    {
+        // resolved here, the worker only decodes a new level pack level (read-only, the cache is filled in NextLevel)
+        const int level = gameContext.level + 1;
+        const LevelData* levelData = findLevelData(gameContext, level);
+        const LevelPack* levelPack =
+            (levelData == nullptr && gameContext.levelPack.levelCount > 0) ? &gameContext.levelPack : nullptr;
+        StartLevelPrefetch(gameContext.levelPrefetch, level, levelData, levelPack);
+    }
+}
+void ReloadLevel(GameContext& gameContext, int level, std::unique_ptr<LevelPackLevel> levelFile)
+{
+    if (level < 1 || levelFile == nullptr)
+    {
+        return;
+    }
+    // the worker reads the level files
+    CancelLevelPrefetch(gameContext.levelPrefetch);
+    if (static_cast<int>(gameContext.levelFiles.size()) < level)
+    {
+        gameContext.levelFiles.resize(level);
+    }
+    gameContext.levelFiles[level - 1] = std::move(levelFile);
+    if (level != gameContext.level ||
+        (gameContext.state != GameState::NodesMain && gameContext.state != GameState::CharacterMain))
+    {
+        prefetchNextLevel(gameContext);
+        return;
+    }
+
+    // the editor works on the nodes of the level (the sandbox is closed as well)
+    if (gameContext.editorMode)
+    {
+        ToggleNodeEditor(gameContext);
+    }
+    const GameLevelNodes previousNodes = gameContext.nodes;
+    SetLevel(gameContext, level);
+
+    // keep the connections between nodes with the same index and type, when they are still valid
+    // (the nodes may have moved: crossings, nodes in between), added again like the player does
+    const auto sameNode = [&](int index)
+    {
+        return index != -1 && gameContext.nodes[index].data.type != ConnectorType::DISABLED &&
+               gameContext.nodes[index].data.type == previousNodes[index].data.type;
+    };
+    int droppedConnections = 0;
+    for (const auto& previousNode : previousNodes)
+    {
+        for (const auto& connectedNodeIndex : previousNode.direct_connections)
+        {
+            if (connectedNodeIndex > previousNode.index && sameNode(previousNode.index) &&
+                sameNode(connectedNodeIndex) && !ConnectNodes(gameContext, previousNode.index, connectedNodeIndex))
+            {
+                ++droppedConnections;
+            }
+        }
+    }
+    if (droppedConnections > 0)
+    {
+        TraceLog(LOG_INFO, "LEVEL: %d connections are not valid anymore", droppedConnections);
+    }
+    TraceLog(LOG_INFO, "LEVEL: level %d reloaded", level);
+}
+int GetLevelCount(const GameContext& gameContext)
+{
+    const int levelCount = (gameContext.levelPack.levelCount > 0) ? gameContext.levelPack.levelCount : MaxLevels;
+    return std::max(levelCount, static_cast<int>(gameContext.levelFiles.size()));
 }
 void NextLevel(GameContext& gameContext)
 {
-    if (gameContext.level > 0 && gameContext.level < MaxLevels)
+    const int levelCount = GetLevelCount(gameContext);
+    if (gameContext.level > 0 && gameContext.level < levelCount)
     {
-        SetLevel(gameContext, gameContext.level + 1);
+        // prefetched while playing, swap the nodes and map in (the old ones are freed by the worker)
+        PreparedLevel* prepared = TakePreparedLevel(gameContext.levelPrefetch, gameContext.level + 1);
+        if (prepared != nullptr)
+        {
+            if (prepared->decoded != nullptr)
+            {
+                prepared->data =
+                    AddLevelPackLevel(gameContext.levelPack, prepared->level, std::move(prepared->decoded));
+            }
+            std::swap(gameContext.nodes, prepared->nodes);
+            std::swap(gameContext.map, prepared->map);
+            startLevel(gameContext, prepared->level, prepared->data);
+        }
+        else
+        {
+            SetLevel(gameContext, gameContext.level + 1);
+        }
     }
-    else if (gameContext.level == MaxLevels)
+    else if (gameContext.level == levelCount)
     {
         gameContext.state = GameState::End;
         return;
     }
 }
 
-static void updateCountConnectedNode(GameContext& gameContext, ConnectorNode& node);
-static void updateNodeConnections(GameContext& gameContext, ConnectorNode& node);
+void UpdateNodeGrid(GameContext& gameContext)
+{
+    if (gameContext.nodeGrid.cells.empty())
+    {
+        InitSpatialGrid(gameContext.nodeGrid, ConnectorArea);
+    }
+    for (const auto& node : gameContext.nodes)
+    {
+        if (node.data.type != ConnectorType::DISABLED)
+        {
+            SetSpatialGridItem(gameContext.nodeGrid, static_cast<uint32_t>(node.index), node.data.position);
+        }
+        else
+        {
+            RemoveSpatialGridItem(gameContext.nodeGrid, static_cast<uint32_t>(node.index));
+        }
+    }
+}
+
+/// @NOTE: only writes the node (connected_counter), the nodes can be updated at the same time
+static void updateCountConnectedNode(const GameContext& gameContext, ConnectorNode& node);
+/// @NOTE: only writes the node (connected_nodes, connected_actions), reads the direct_connections of the others
+static void updateNodeConnections(const GameContext& gameContext, ConnectorNode& node);
 static void updateKeyBinds(GameContext& gameContext);
 static void updateLevelConnectionCount(GameContext& gameContext);
 void UpdateAllNodes(GameContext& gameContext)
 {
-    for (auto& node : gameContext.nodes)
+    // every node on its own (job system), only worth it with more nodes than a level has
+    ParallelFor(
+        &gameContext.jobs,
+        gameContext.nodes.size(),
+        UpdateNodesMinBatch,
+        [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                updateNodeConnections(gameContext, gameContext.nodes[i]);
+                updateCountConnectedNode(gameContext, gameContext.nodes[i]);
+            }
+        });
+    /// @TODO: minimize updateing node properties
+
+    // debug
+#if !defined(PLATFORM_WEB)
+#ifndef NDEBUG
+    if (IsFrameKeyDown(gameContext.input, KEY_F2))
     {
-        updateNodeConnections(gameContext, node);
-        updateCountConnectedNode(gameContext, node);
+        for (const auto& node : gameContext.nodes)
+        {
+            TraceLog(LOG_DEBUG, "node %d -> ", node.index);
+            for (const auto& connectedIndex : node.connected_nodes)
+            {
+                TraceLog(LOG_DEBUG, " %d", connectedIndex);
+            }
+        }
     }
-    /// @TODO: minimize updateing node properties
+#endif
+#endif
 
     updateLevelConnectionCount(gameContext);
     updateKeyBinds(gameContext);
@@ -157,7 +292,7 @@ void updateLevelConnectionCount(GameContext& gameContext)
     /// @NOTE(workaround): for bidirectional connections
     gameContext.levelConnections /= 2;
 }
-void updateCountConnectedNode(GameContext& gameContext, ConnectorNode& node)
+void updateCountConnectedNode(const GameContext& gameContext, ConnectorNode& node)
 {
     node.connected_counter = 0;
     for (size_t i = 0; i < gameContext.nodes.size(); ++i)
@@ -173,7 +308,6 @@ void updateCountConnectedNode(GameContext& gameContext, ConnectorNode& node)
             }
         }
     }
-    updateNodeConnections(gameContext, node);
 }
 void updateKeyBinds(GameContext& gameContext)
 {
@@ -258,7 +392,7 @@ void updateKeyBinds(GameContext& gameContext)
         gameContext.rightHelperText = TextFormat(RightHelperTextNoKeyBindsFormat);
     }
 }
-void updateNodeConnections(GameContext& gameContext, ConnectorNode& node)
+void updateNodeConnections(const GameContext& gameContext, ConnectorNode& node)
 {
     const auto addConnection = [&](int root_node_index, const ConnectorNode& connect_node)
     {
@@ -325,34 +459,36 @@ void updateNodeConnections(GameContext& gameContext, ConnectorNode& node)
     }
 
     // update actions
+    // in chain order (key - action1 - action2 - ...): breadth-first from the node along the direct_connections,
+    // the order level_validation.h executes the actions in (not the order of the connected_nodes set)
     node.connected_actions.clear();
-    /// @NOTE(workaround): reverse set to the order of the actions is right
-    std::vector connected_nodes_arr(node.connected_nodes.begin(), node.connected_nodes.end());
-    for (auto it = connected_nodes_arr.rbegin(); it != connected_nodes_arr.rend(); ++it)
+    std::array<int, MaxIndirectConnections + 1> chain{};
+    size_t chainLength = 0;
+    chain[chainLength++] = node.index;
+    for (size_t i = 0; i < chainLength; ++i)
     {
-        const auto& connected_node_index = *it;
-        if (connected_node_index != -1 && connected_node_index != node.index)
+        const auto& chain_node = gameContext.nodes[chain[i]];
+        if (i > 0 && chain_node.data.type == ConnectorType::DISABLED)
         {
-            const auto& connected_node = gameContext.nodes[connected_node_index];
-            if (connected_node.data.type == ConnectorType::Action)
+            continue;
+        }
+        for (const auto& connected_node_index : chain_node.direct_connections)
+        {
+            if (connected_node_index != -1 && chainLength < chain.size() &&
+                node.connected_nodes.contains(connected_node_index) &&
+                std::find(chain.begin(), chain.begin() + chainLength, connected_node_index) ==
+                    chain.begin() + chainLength)
             {
-                node.connected_actions.push_back(connected_node.data.action);
+                chain[chainLength++] = connected_node_index;
             }
         }
     }
-    updateKeyBinds(gameContext);
-
-    // debug
-#if !defined(PLATFORM_WEB)
-#ifndef NDEBUG
-    if (IsKeyDown(KEY_F2))
+    for (size_t i = 1; i < chainLength; ++i)
     {
-        TraceLog(LOG_DEBUG, "node %d -> ", node.index);
-        for (const auto& connectedIndex : node.connected_nodes)
+        const auto& connected_node = gameContext.nodes[chain[i]];
+        if (connected_node.data.type == ConnectorType::Action)
         {
-            TraceLog(LOG_DEBUG, " %d", connectedIndex);
+            node.connected_actions.push_back(connected_node.data.action);
         }
     }
-#endif
-#endif
 }
\ No newline at end of file
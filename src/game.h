@@ -1,44 +1,71 @@
 #pragma once
 
 #include "constants.h"
+#include "frame_input.h"
+#include "job_system.h"
+#include "level_pack.h"
+#include "level_prefetch.h"
+#include "node_editor.h"
+#include "render_queue.h"
+#include "spatial_grid.h"
+#include "tile_map.h"
 #include "types.h"
 #include <raylib.h>
 #include <chrono>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
+
+struct GameContext;
+/// all connection rules of a level in one pass, after the connection between node1 and node2 is added
+using ConnectionValidator = bool (*)(const GameContext& gameContext, int node1, int node2);
 
 struct GameContext
 {
     // textures
     Font font{};
-    Texture2D logoTexture{};
-    Texture2D instruction1Texture{};
-    Texture2D instruction2Texture{};
-    Texture2D tilesetTexture{};
-    Texture2D endTexture{};
-    Texture2D characterSpriteSheetTexture{};
-    Texture2D iconsSpriteSheetTexture{};
-    Texture2D iconsControlSpriteSheetTexture{};
+    Texture2D atlasTexture{}; ///< all sprite sheets, see atlas.h for the regions
     std::chrono::milliseconds delta{std::chrono::milliseconds::zero()};
 
+    // rendering
+    RenderQueue renderQueue;
+
+    // workers for the frame (fork/join), see InitJobSystem in main, no workers: everything runs on the main thread
+    JobSystem jobs;
+
     // scene data
+    FrameInput input; ///< input of this update (main thread or logic thread), use this instead of the raylib input
     Rectangle mouse{0, 0, 0, 0};
-    GameState state{GameState::Start};
+    GameState state{GameState::Loading};
 
     // level/player data
     std::chrono::milliseconds timer{std::chrono::milliseconds::zero()};
     std::chrono::milliseconds startTime{std::chrono::milliseconds::zero()};
     //// level data
+    LevelPack levelPack; ///< levels from a level pack (--level-pack), compiled-in levels when empty
+    /// level files (--level-dir), replace the levels above, index: level - 1, nullptr when there is no file
+    std::vector<std::unique_ptr<LevelPackLevel>> levelFiles;
     GameLevelNodes nodes{};
-    const Level_t* mapData{nullptr};
+    SpatialGrid nodeGrid; ///< nodes (index) in the ConnectorArea, mouse picking and nodes in between connections
+    LevelPrefetch levelPrefetch; ///< next level, prepared while playing
+    TileMap map; ///< copy of the level map (any size)
     int level{0};
     int levelMaxNodeConnections{0};
     int levelMaxActionsPerKey{0};
     int levelConnections{0};
+    ConnectionRules levelConnectionRules{DefaultConnectionRules};
+    ConnectionValidator validateConnection{nullptr}; ///< compiled for levelConnectionRules, see startLevel
+    //// editor (level design, --level-dir and F5, sandbox with F6)
+    /// nodes of the level (same index) while editing, the connections are applied when the editor is closed
+    NodeEditor nodeEditor;
+    bool editorMode{false};
+    bool sandboxMode{false}; ///< editor on its own graph (F6), the level stays as it is
+    std::string levelDirectory; ///< --level-dir, the editor saves the level files there
     //// player data
     std::chrono::milliseconds turnCooldown{std::chrono::milliseconds::zero()};
-    Vector2 playerStartTilesPosition{0, 0};
-    Vector2 playerTilesPosition{0, 0};
+    TilePosition playerStartTilesPosition{0, 0};
+    TilePosition playerTilesPosition{0, 0};
     CharacterDirection playerStartDirection{CharacterDirection::Right};
     CharacterDirection playerDirection{CharacterDirection::Right};
     ConnectorKey playerCurrentKey{ConnectorKey::NONE};
@@ -56,6 +83,7 @@ struct GameContext
     std::string leftHelperText;
     std::string levelHelperText;
     std::string rightHelperText;
+    std::vector<KeyPreview> keyPreviews; ///< preview lines (guide lines), one per key with actions
     bool nodeSelectionMode{false};
 
     GameContext()
@@ -75,18 +103,38 @@ inline static constexpr int ScreenWidth = 800;
 inline static constexpr int ScreenHeight = 450;
 
 extern void UpdateAllNodes(GameContext& gameContext);
+/// (re)build nodeGrid from the node positions, call after nodes are added or moved
+extern void UpdateNodeGrid(GameContext& gameContext);
+/// level pack, level file or compiled-in level, nullptr when there is no such level
+[[nodiscard]] extern const LevelData* GetLevelData(GameContext& gameContext, int level);
 extern void SetLevel(GameContext& gameContext, int level);
+/// replace a level with a (re)loaded level file, the current level restarts and keeps the connections (same nodes)
+extern void ReloadLevel(GameContext& gameContext, int level, std::unique_ptr<LevelPackLevel> levelFile);
+[[nodiscard]] extern int GetLevelCount(const GameContext& gameContext);
 extern void NextLevel(GameContext& gameContext);
 
 // start_scene.cpp
 extern void UpdateStartScene(GameContext& gameContext);
 extern void RenderStartScene(GameContext& gameContext);
+extern void RenderLoadingScene(GameContext& gameContext);
 
 // main_scene.cpp
 extern void UpdateMainSceneNodes(GameContext& gameContext);
+/// validation for the active rules (ConnectionRules::rules), selected once per level
+[[nodiscard]] extern ConnectionValidator GetConnectionValidator(const ConnectionRules& rules);
+/// connect the nodes when the level rules allow it (same as the player), otherwise the nodes stay unchanged
+extern bool ConnectNodes(GameContext& gameContext, int node1, int node2);
 extern void UpdateMainSceneMap(GameContext& gameContext);
 extern void RenderMainScene(GameContext& gameContext);
 
+// editor_scene.cpp
+/// open (NodesMain) or close the editor, invalid connections are removed on close
+extern void ToggleNodeEditor(GameContext& gameContext);
+/// open (NodesMain) or close the editor with an empty graph, not saved and not applied to the level
+extern void ToggleNodeSandbox(GameContext& gameContext);
+extern void UpdateNodeEditorScene(GameContext& gameContext);
+extern void RenderNodeEditorScene(GameContext& gameContext);
+
 // end_scene.cpp
 extern void UpdateEndScene(GameContext& gameContext);
 extern void RenderEndScene(GameContext& gameContext);
@@ -0,0 +1,186 @@
+#include "game_env.h"
+#include "tile_map.h"
+#include <algorithm>
+#include <cstring>
+
+bool InitEnvLevel(EnvLevel& level, const LevelData& data)
+{
+    if ((data.mapData == nullptr && data.tileMap == nullptr) || !level_validation::ValidNodes(data) ||
+        !level_validation::IsSmallMap(data))
+    {
+        return false;
+    }
+    level.data = data;
+
+    TileMap tileMap;
+    LoadLevelTileMap(tileMap, data);
+    InitBatchSimMap(level.map, tileMap);
+    for (int y = 0; y < LevelMapHeight; ++y)
+    {
+        for (int x = 0; x < LevelMapWidth; ++x)
+        {
+            level.tiles[y * LevelMapWidth + x] = static_cast<uint8_t>(GetTile(tileMap, x, y));
+        }
+    }
+    return true;
+}
+
+void ResetEnv(GameEnv& env, const EnvLevel& level)
+{
+    env.level = &level;
+    env.wiring = {};
+    env.chainLastNode.fill(-1);
+    env.nodeChain.fill(0);
+    env.nodeChainPosition.fill(0);
+    env.position = {
+        static_cast<int>(level.data.characterStartTilesPosition.x),
+        static_cast<int>(level.data.characterStartTilesPosition.y)};
+    env.direction = level.data.characterStartDirection;
+    env.status = BatchSimStatus::Alive;
+    env.steps = 0;
+}
+
+/// same rules as the solver (level_validation::SolverExtendChain), a key starts a new chain
+static bool connectNodes(GameEnv& env, int node1, int node2)
+{
+    const LevelData& data = env.level->data;
+    const int nodeCount = static_cast<int>(data.nodesData.size());
+    if (node1 < 0 || node2 < 0 || node1 >= nodeCount || node2 >= nodeCount || node1 == node2 ||
+        data.nodesData[node2].type != ConnectorType::Action || env.wiring.usedNodes[node2] ||
+        env.wiring.edgeCount >= data.maxNodeConnections)
+    {
+        return false;
+    }
+
+    int chain = -1;
+    if (data.nodesData[node1].type == ConnectorType::Key)
+    {
+        if (env.nodeChain[node1] != 0)
+        {
+            return false;
+        }
+    }
+    else
+    {
+        const auto chainsEnd = env.chainLastNode.begin() + env.wiring.chainCount;
+        const auto last = std::find(env.chainLastNode.begin(), chainsEnd, node1);
+        if (last == chainsEnd)
+        {
+            return false;
+        }
+        chain = static_cast<int>(last - env.chainLastNode.begin());
+        const int maxChainLength = std::min(data.maxActionsPerKey, level_validation::MaxChainLength);
+        if (env.wiring.chains[chain].length >= maxChainLength)
+        {
+            return false;
+        }
+    }
+    if (!level_validation::SolverValidEdge(data, env.wiring, node1, node2))
+    {
+        return false;
+    }
+
+    if (chain == -1)
+    {
+        chain = env.wiring.chainCount++;
+        env.wiring.chains[chain] = {.keyNode = node1};
+        env.nodeChain[node1] = static_cast<uint8_t>(chain + 1);
+    }
+    auto& solverChain = env.wiring.chains[chain];
+    solverChain.actions[solverChain.length++] = data.nodesData[node2].action;
+    env.wiring.usedNodes[node2] = true;
+    env.wiring.edges[env.wiring.edgeCount++] = {node1, node2};
+    env.chainLastNode[chain] = node2;
+    env.nodeChain[node2] = static_cast<uint8_t>(chain + 1);
+    env.nodeChainPosition[node2] = static_cast<uint8_t>(solverChain.length);
+    return true;
+}
+
+/// execute the actions bound to the key (one turn per action, the tile is checked after every action)
+static bool pressKey(GameEnv& env, ConnectorKey key)
+{
+    const LevelData& data = env.level->data;
+    for (int c = 0; c < env.wiring.chainCount; ++c)
+    {
+        const auto& chain = env.wiring.chains[c];
+        if (data.nodesData[chain.keyNode].key != key)
+        {
+            continue;
+        }
+        for (int i = 0; i < chain.length && env.status == BatchSimStatus::Alive; ++i)
+        {
+            MoveTile(env.position, env.direction, chain.actions[i]);
+            env.status = static_cast<BatchSimStatus>(GetBatchSimTile(env.level->map, env.position.x, env.position.y));
+        }
+        return true;
+    }
+    return false;
+}
+
+EnvStepResult StepEnv(GameEnv& env, int action)
+{
+    if (env.status != BatchSimStatus::Alive || env.steps >= EnvMaxSteps)
+    {
+        return {.reward = 0.0f, .done = true};
+    }
+    ++env.steps;
+
+    EnvStepResult result{.reward = EnvStepReward, .done = false};
+    bool valid = false;
+    if (action >= 0 && action < EnvKeyCount)
+    {
+        valid = pressKey(env, EnvKeys[action]);
+    }
+    else if (action >= EnvKeyCount && action < EnvActionCount)
+    {
+        const int nodes = action - EnvKeyCount;
+        valid = connectNodes(env, nodes / MaxNodesInLevel, nodes % MaxNodesInLevel);
+    }
+    if (!valid)
+    {
+        result.reward += EnvInvalidActionReward;
+    }
+    switch (env.status)
+    {
+        case BatchSimStatus::Alive: result.done = env.steps >= EnvMaxSteps; break;
+        case BatchSimStatus::Dead:
+            result.reward += EnvDeathReward;
+            result.done = true;
+            break;
+        case BatchSimStatus::Won:
+            result.reward += EnvWinReward;
+            result.done = true;
+            break;
+    }
+    return result;
+}
+
+void EncodeEnvObservation(const GameEnv& env, EnvObservation observation)
+{
+    const LevelData& data = env.level->data;
+    std::memcpy(observation.data() + EnvMapObservationOffset, env.level->tiles.data(), env.level->tiles.size());
+
+    uint8_t* nodes = observation.data() + EnvNodeObservationOffset;
+    std::memset(nodes, 0, MaxNodesInLevel * EnvNodeObservationSize);
+    for (size_t i = 0; i < data.nodesData.size(); ++i)
+    {
+        const auto& node = data.nodesData[i];
+        uint8_t* values = nodes + i * EnvNodeObservationSize;
+        values[0] = static_cast<uint8_t>(node.type);
+        const auto keyIndex = static_cast<int>(std::find(EnvKeys.begin(), EnvKeys.end(), node.key) - EnvKeys.begin());
+        values[1] = static_cast<uint8_t>(
+            (node.type == ConnectorType::Key) ? keyIndex + 1 : static_cast<int>(node.action) + 1);
+        values[2] = env.nodeChain[i];
+        values[3] = env.nodeChainPosition[i];
+    }
+
+    // positions of dead characters can be outside of the map (jump)
+    const auto clampByte = [](int value) { return static_cast<uint8_t>(std::clamp(value, 0, 255)); };
+    uint8_t* player = observation.data() + EnvPlayerObservationOffset;
+    player[0] = clampByte(env.position.x + JumpFactor);
+    player[1] = clampByte(env.position.y + JumpFactor);
+    player[2] = static_cast<uint8_t>(env.direction);
+    player[3] = static_cast<uint8_t>(env.status);
+    player[4] = clampByte(data.maxNodeConnections - env.wiring.edgeCount);
+    player[5] = clampByte(env.steps);
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "batch_sim.h"
+#include "constants.h"
+#include "level_validation.h"
+#include "types.h"
+#include <array>
+#include <cstdint>
+#include <span>
+
+/// environment for automated players (training, evaluation), same rules as the game:
+/// connect nodes (key - action1 - action2 - ..., see level_validation.h, Solver) and press keys
+/// @NOTE: only small maps (LevelMapWidth x LevelMapHeight), see level_validation::IsSmallMap
+
+/// keys in action and observation order
+inline constexpr std::array<ConnectorKey, 6> EnvKeys{
+    ConnectorKey::B, ConnectorKey::H, ConnectorKey::J, ConnectorKey::K, ConnectorKey::L, ConnectorKey::G};
+inline constexpr int EnvKeyCount = static_cast<int>(EnvKeys.size());
+
+/// actions:
+/// [0, EnvKeyCount): press EnvKeys[action], the bound actions are executed (one turn each)
+/// [EnvKeyCount, EnvActionCount): connect node (action - EnvKeyCount) / MaxNodesInLevel
+///                                with node (action - EnvKeyCount) % MaxNodesInLevel
+inline constexpr int EnvActionCount = EnvKeyCount + MaxNodesInLevel * MaxNodesInLevel;
+[[nodiscard]] inline constexpr int EnvPressKeyAction(int keyIndex)
+{
+    return keyIndex;
+}
+[[nodiscard]] inline constexpr int EnvConnectAction(int node1, int node2)
+{
+    return EnvKeyCount + node1 * MaxNodesInLevel + node2;
+}
+
+/// observation (one byte per value):
+/// map:    LevelMapWidth x LevelMapHeight TileSet (row by row)
+/// nodes:  per node: ConnectorType, action + 1 or key index + 1, chain + 1 (0: not connected), position in chain
+/// player: x + JumpFactor, y + JumpFactor, CharacterDirection, BatchSimStatus, connections left, steps
+inline constexpr int EnvMapObservationOffset = 0;
+inline constexpr int EnvNodeObservationOffset = EnvMapObservationOffset + LevelMapWidth * LevelMapHeight;
+inline constexpr int EnvNodeObservationSize = 4;
+inline constexpr int EnvPlayerObservationOffset = EnvNodeObservationOffset + MaxNodesInLevel * EnvNodeObservationSize;
+inline constexpr int EnvObservationSize = EnvPlayerObservationOffset + 6;
+using EnvObservation = std::span<uint8_t, EnvObservationSize>;
+
+inline constexpr int EnvMaxSteps = 64; ///< done (truncated) after EnvMaxSteps steps
+inline constexpr float EnvWinReward = 1.0f;
+inline constexpr float EnvDeathReward = -1.0f;
+inline constexpr float EnvStepReward = -0.01f;
+inline constexpr float EnvInvalidActionReward = -0.05f; ///< invalid connection, unbound key
+
+/// level data shared by all environments (read-only)
+struct EnvLevel
+{
+    LevelData data; ///< @NOTE: points to the level (nodes, map), the level must outlive the EnvLevel
+    BatchSimMap map;
+    std::array<uint8_t, LevelMapWidth * LevelMapHeight> tiles{};
+};
+
+struct GameEnv
+{
+    const EnvLevel* level{nullptr};
+    level_validation::SolverState wiring{}; ///< connections (chains per key)
+    std::array<int, MaxNodesInLevel> chainLastNode{};         ///< per chain
+    std::array<uint8_t, MaxNodesInLevel> nodeChain{};         ///< per node, chain + 1, 0: not connected
+    std::array<uint8_t, MaxNodesInLevel> nodeChainPosition{}; ///< per node, 0: key node
+    TilePosition position{0, 0};
+    CharacterDirection direction{CharacterDirection::Right};
+    BatchSimStatus status{BatchSimStatus::Alive};
+    int steps{0};
+};
+
+struct EnvStepResult
+{
+    float reward{0.0f};
+    bool done{false};
+};
+
+/// false when the level can't be used (no nodes, large map)
+[[nodiscard]] extern bool InitEnvLevel(EnvLevel& level, const LevelData& data);
+
+/// start the level (no connections)
+extern void ResetEnv(GameEnv& env, const EnvLevel& level);
+extern EnvStepResult StepEnv(GameEnv& env, int action);
+extern void EncodeEnvObservation(const GameEnv& env, EnvObservation observation);
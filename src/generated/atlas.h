@@ -0,0 +1,18 @@
+#pragma once
+
+// generated by tools/atlas_packer from src/resources, do not edit
+
+#include <raylib.h>
+
+inline constexpr const char* AtlasFileName = "atlas.png";
+inline constexpr int AtlasWidth = 512;
+inline constexpr int AtlasHeight = 512;
+
+inline constexpr Rectangle AtlasCharacterRect{129, 296, 128, 32}; // character.png
+inline constexpr Rectangle AtlasEndRect{0, 296, 128, 128}; // end.png
+inline constexpr Rectangle AtlasIconsControlRect{419, 296, 40, 10}; // icons-control.png
+inline constexpr Rectangle AtlasIconsRect{0, 425, 288, 32}; // icons.png
+inline constexpr Rectangle AtlasInstruction1Rect{87, 0, 86, 198}; // instruction1.png
+inline constexpr Rectangle AtlasInstruction2Rect{0, 0, 86, 295}; // instruction2.png
+inline constexpr Rectangle AtlasLogoRect{174, 0, 330, 138}; // logo.png
+inline constexpr Rectangle AtlasTilesetRect{258, 296, 160, 32}; // tileset.png
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "constants.h"
+#include "types.h"
+#include <raylib.h>
+
+/// constexpr versions of the raylib collision checks used by the game rules (same results as raylib)
+namespace geometry
+{
+inline constexpr float Epsilon = 0.000001f;
+
+inline constexpr float Abs(float value)
+{
+    return (value < 0) ? -value : value;
+}
+inline constexpr float Min(float a, float b)
+{
+    return (a < b) ? a : b;
+}
+inline constexpr float Max(float a, float b)
+{
+    return (a > b) ? a : b;
+}
+
+/// same as CheckCollisionLines (raylib)
+inline constexpr bool CheckCollisionLines(Vector2 startPos1, Vector2 endPos1, Vector2 startPos2, Vector2 endPos2)
+{
+    const float div = (endPos2.y - startPos2.y) * (endPos1.x - startPos1.x) -
+                      (endPos2.x - startPos2.x) * (endPos1.y - startPos1.y);
+    if (Abs(div) < Epsilon)
+    {
+        return false;
+    }
+
+    const float cross1 = startPos1.x * endPos1.y - startPos1.y * endPos1.x;
+    const float cross2 = startPos2.x * endPos2.y - startPos2.y * endPos2.x;
+    const float xi = ((startPos2.x - endPos2.x) * cross1 - (startPos1.x - endPos1.x) * cross2) / div;
+    const float yi = ((startPos2.y - endPos2.y) * cross1 - (startPos1.y - endPos1.y) * cross2) / div;
+    const auto outside = [](float start, float end, float value)
+    { return Abs(start - end) > Epsilon && (value < Min(start, end) || value > Max(start, end)); };
+    return !(outside(startPos1.x, endPos1.x, xi) || outside(startPos2.x, endPos2.x, xi) ||
+             outside(startPos1.y, endPos1.y, yi) || outside(startPos2.y, endPos2.y, yi));
+}
+
+inline constexpr int NodeRadius(const NodeData& node)
+{
+    switch (node.type)
+    {
+        case ConnectorType::DISABLED: break;
+        case ConnectorType::Action: return ActionNodeRadius;
+        case ConnectorType::Key: return KeyNodeRadius;
+    }
+    return 0;
+}
+
+/// line crosses the box around the node (half the radius), see validConnection
+inline constexpr bool CheckCollisionLineNode(Vector2 startPos, Vector2 endPos, const NodeData& node)
+{
+    const float halfSize = static_cast<float>(NodeRadius(node) / 2);
+    const Vector2 topLeft = {node.position.x - halfSize, node.position.y - halfSize};
+    const Vector2 topRight = {node.position.x + halfSize, node.position.y - halfSize};
+    const Vector2 bottomLeft = {node.position.x - halfSize, node.position.y + halfSize};
+    const Vector2 bottomRight = {node.position.x + halfSize, node.position.y + halfSize};
+    return CheckCollisionLines(startPos, endPos, topLeft, topRight) ||
+           CheckCollisionLines(startPos, endPos, topRight, bottomRight) ||
+           CheckCollisionLines(startPos, endPos, bottomRight, bottomLeft) ||
+           CheckCollisionLines(startPos, endPos, bottomLeft, topLeft);
+}
+
+inline constexpr bool CheckCollisionCircles(Vector2 center1, float radius1, Vector2 center2, float radius2)
+{
+    const float dx = center2.x - center1.x;
+    const float dy = center2.y - center1.y;
+    return dx * dx + dy * dy <= (radius1 + radius2) * (radius1 + radius2);
+}
+
+/// circle is completely inside the rectangle
+inline constexpr bool CircleInsideRec(Vector2 center, float radius, Rectangle rec)
+{
+    return center.x - radius >= rec.x && center.x + radius <= rec.x + rec.width && center.y - radius >= rec.y &&
+           center.y + radius <= rec.y + rec.height;
+}
+} // namespace geometry
@@ -0,0 +1,208 @@
+#include "job_system.h"
+#include <raylib.h>
+
+/// queue of the current thread: 0 for the main thread (and other threads), i for worker i
+static thread_local size_t t_jobQueue{0};
+
+static bool pushJob(JobQueue& queue, const Job& job)
+{
+    std::lock_guard lock{queue.mutex};
+    if (queue.bottom - queue.top >= JobQueueCapacity)
+    {
+        return false;
+    }
+    queue.jobs[queue.bottom % JobQueueCapacity] = job;
+    ++queue.bottom;
+    return true;
+}
+/// owner: newest job
+static bool popJob(JobQueue& queue, Job& job)
+{
+    std::lock_guard lock{queue.mutex};
+    if (queue.bottom == queue.top)
+    {
+        return false;
+    }
+    --queue.bottom;
+    job = queue.jobs[queue.bottom % JobQueueCapacity];
+    return true;
+}
+/// thieves: oldest job
+static bool stealJob(JobQueue& queue, Job& job)
+{
+    std::unique_lock lock{queue.mutex, std::try_to_lock};
+    if (!lock.owns_lock() || queue.bottom == queue.top)
+    {
+        return false;
+    }
+    job = queue.jobs[queue.top % JobQueueCapacity];
+    ++queue.top;
+    return true;
+}
+
+static void executeJob(JobSystem& jobs, const Job& job)
+{
+    job.function(job.data, job.begin, job.end);
+    jobs.executedJobs.fetch_add(1, std::memory_order_relaxed);
+    job.group->pending.fetch_sub(1, std::memory_order_release);
+}
+
+/// own deque first, then the other deques (starting with the next one)
+static bool findJob(JobSystem& jobs, Job& job)
+{
+    if (jobs.queuedJobs.load(std::memory_order_relaxed) <= 0)
+    {
+        return false;
+    }
+    const size_t own = t_jobQueue;
+    if (popJob(*jobs.queues[own], job))
+    {
+        jobs.queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    for (size_t i = 1; i < jobs.queues.size(); ++i)
+    {
+        if (stealJob(*jobs.queues[(own + i) % jobs.queues.size()], job))
+        {
+            jobs.queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            jobs.stolenJobs.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+static void runJobWorker(JobSystem& jobs, size_t queue)
+{
+    t_jobQueue = queue;
+    Job job;
+    while (!jobs.stop.load(std::memory_order_acquire))
+    {
+        if (findJob(jobs, job))
+        {
+            executeJob(jobs, job);
+            continue;
+        }
+        // sleep until jobs are queued (RunJob wakes one worker)
+        std::unique_lock lock{jobs.sleepMutex};
+        jobs.sleepingWorkers.fetch_add(1);
+        jobs.wake.wait(lock, [&]() { return jobs.stop.load() || jobs.queuedJobs.load() > 0; });
+        jobs.sleepingWorkers.fetch_sub(1);
+    }
+}
+
+void InitJobSystem(JobSystem& jobs, int workerCount)
+{
+    StopJobSystem(jobs);
+#if !defined(PLATFORM_WEB)
+    if (workerCount <= 0)
+    {
+        workerCount = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+    }
+    workerCount = std::clamp(workerCount, 0, JobSystemMaxWorkers);
+#else
+    workerCount = 0;
+#endif
+    jobs.queues.clear();
+    for (int i = 0; i <= workerCount; ++i)
+    {
+        jobs.queues.push_back(std::make_unique<JobQueue>());
+    }
+    jobs.stop = false;
+    jobs.plannedWorkers = workerCount;
+    TraceLog(LOG_INFO, "JOBS: up to %d workers, started by the first large job", workerCount);
+}
+
+void StartJobSystem(JobSystem& jobs, int workerCount)
+{
+    InitJobSystem(jobs, workerCount);
+    StartJobWorkers(jobs);
+}
+
+bool StartJobWorkers(JobSystem& jobs)
+{
+    if (jobs.workersStarted.load(std::memory_order_acquire))
+    {
+        return true;
+    }
+    std::lock_guard lock{jobs.startMutex};
+    if (!jobs.workersStarted.load(std::memory_order_relaxed) && jobs.plannedWorkers > 0)
+    {
+        for (int i = 1; i <= jobs.plannedWorkers; ++i)
+        {
+            jobs.workers.emplace_back(runJobWorker, std::ref(jobs), static_cast<size_t>(i));
+        }
+        jobs.plannedWorkers = 0;
+        jobs.workersStarted.store(true, std::memory_order_release);
+        TraceLog(LOG_INFO, "JOBS: %d workers started", static_cast<int>(jobs.workers.size()));
+    }
+    return jobs.workersStarted.load(std::memory_order_relaxed);
+}
+
+void StopJobSystem(JobSystem& jobs)
+{
+    std::lock_guard startLock{jobs.startMutex};
+    {
+        std::lock_guard lock{jobs.sleepMutex};
+        jobs.stop = true;
+    }
+    jobs.wake.notify_all();
+    for (auto& worker : jobs.workers)
+    {
+        worker.join();
+    }
+    jobs.workers.clear();
+    jobs.plannedWorkers = 0;
+    jobs.workersStarted = false;
+    for (auto& queue : jobs.queues)
+    {
+        queue->top = queue->bottom;
+    }
+    jobs.queuedJobs = 0;
+}
+
+int GetJobWorkerCount(const JobSystem& jobs)
+{
+    return jobs.workersStarted.load(std::memory_order_acquire) ? static_cast<int>(jobs.workers.size()) : 0;
+}
+
+void RunJob(JobSystem& jobs, JobGroup& group, JobFunction function, void* data, size_t begin, size_t end)
+{
+    const Job job{.function = function, .data = data, .begin = begin, .end = end, .group = &group};
+    group.pending.fetch_add(1, std::memory_order_relaxed);
+    if (!jobs.workersStarted.load(std::memory_order_acquire) || !pushJob(*jobs.queues[t_jobQueue], job))
+    {
+        executeJob(jobs, job);
+        return;
+    }
+    jobs.queuedJobs.fetch_add(1);
+    // a worker going to sleep counts itself before it checks queuedJobs (sleepMutex), no lost wake up
+    if (jobs.sleepingWorkers.load() > 0)
+    {
+        {
+            std::lock_guard lock{jobs.sleepMutex};
+        }
+        jobs.wake.notify_one();
+    }
+}
+
+void WaitJobGroup(JobSystem& jobs, JobGroup& group)
+{
+    Job job;
+    while (group.pending.load(std::memory_order_acquire) > 0)
+    {
+        if (!jobs.queues.empty() && findJob(jobs, job))
+        {
+            executeJob(jobs, job);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    StopJobSystem(*this);
+}
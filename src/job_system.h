@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/// fixed number of workers for short jobs within a frame (fork/join), every worker has its own deque:
+/// jobs forked on a thread go to its deque (newest first, warm caches),
+/// idle workers steal the oldest jobs of the others
+/// @NOTE: no threads on Web (no workers), the jobs run right away on the calling thread
+/// @NOTE: InitJobSystem starts no threads, the workers are started by the first ParallelFor with more than minBatch
+///        items (small forks never start them)
+inline constexpr int JobSystemMaxWorkers = 8;
+inline constexpr size_t JobQueueCapacity = 1024; ///< per thread, a job forked to a full deque runs right away
+inline constexpr size_t JobBatchesPerThread = 4; ///< ParallelFor: ranges per thread (work stealing evens them out)
+
+/// Types
+using JobFunction = void (*)(void* data, size_t begin, size_t end);
+
+/// fork/join: number of open jobs, see WaitJobGroup
+struct JobGroup
+{
+    std::atomic<int> pending{0};
+};
+
+struct Job
+{
+    JobFunction function{nullptr};
+    void* data{nullptr};
+    size_t begin{0};
+    size_t end{0};
+    JobGroup* group{nullptr};
+};
+
+/// bounded deque (ring buffer), the owner pushes and pops at the bottom, thieves take from the top
+struct JobQueue
+{
+    std::mutex mutex;
+    std::array<Job, JobQueueCapacity> jobs;
+    size_t top{0};
+    size_t bottom{0};
+};
+
+struct JobSystem
+{
+    /// [0]: main thread (and all other threads that are no workers), [i]: worker i
+    std::vector<std::unique_ptr<JobQueue>> queues;
+    std::vector<std::thread> workers; ///< only read after workersStarted (the workers may start on any thread)
+    int plannedWorkers{0}; ///< InitJobSystem, started by StartJobWorkers
+    std::mutex startMutex;
+    std::atomic<bool> workersStarted{false};
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<int> queuedJobs{0};
+    std::atomic<int> sleepingWorkers{0};
+    std::atomic<bool> stop{false};
+
+    // stats
+    std::atomic<uint64_t> executedJobs{0};
+    std::atomic<uint64_t> stolenJobs{0};
+
+    JobSystem() = default;
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+    ~JobSystem();
+};
+
+/// workerCount <= 0: one worker per hardware thread besides the main thread (up to JobSystemMaxWorkers)
+extern void StartJobSystem(JobSystem& jobs, int workerCount = 0);
+/// same as StartJobSystem, but the workers are started later (StartJobWorkers), no threads until then
+extern void InitJobSystem(JobSystem& jobs, int workerCount = 0);
+/// starts the workers of InitJobSystem (once, any thread), false when there are no workers (Web, stopped)
+extern bool StartJobWorkers(JobSystem& jobs);
+/// waits for the workers, queued jobs are dropped (join all groups before)
+extern void StopJobSystem(JobSystem& jobs);
+[[nodiscard]] extern int GetJobWorkerCount(const JobSystem& jobs);
+/// fork: function(data, begin, end) runs on any thread, right away when there are no workers
+extern void RunJob(JobSystem& jobs, JobGroup& group, JobFunction function, void* data, size_t begin, size_t end);
+/// join: runs queued jobs (own deque, then stealing) until all jobs of the group are done
+extern void WaitJobGroup(JobSystem& jobs, JobGroup& group);
+
+/// fork/join over [0, count): function(begin, end) for ranges of at least minBatch items on any thread,
+/// returns when all ranges are done, jobs == nullptr or count <= minBatch: function(0, count) on the calling thread
+/// (without starting the workers, see InitJobSystem)
+/// @NOTE: the ranges run at the same time, function must only write to its own items
+template<typename Function>
+void ParallelFor(JobSystem* jobs, size_t count, size_t minBatch, Function&& function)
+{
+    if (jobs == nullptr || count <= std::max<size_t>(minBatch, 1) || !StartJobWorkers(*jobs))
+    {
+        function(size_t{0}, count);
+        return;
+    }
+    const size_t threads = jobs->workers.size() + 1;
+    const size_t batches = std::min(count / std::max<size_t>(minBatch, 1), threads * JobBatchesPerThread);
+    const size_t batchSize = (count + batches - 1) / batches;
+    using FunctionType = std::remove_reference_t<Function>;
+    const JobFunction run = [](void* data, size_t begin, size_t end)
+    { (*static_cast<FunctionType*>(data))(begin, end); };
+
+    JobGroup group;
+    for (size_t begin = batchSize; begin < count; begin += batchSize)
+    {
+        RunJob(
+            *jobs,
+            group,
+            run,
+            const_cast<void*>(static_cast<const void*>(&function)),
+            begin,
+            std::min(begin + batchSize, count));
+    }
+    function(size_t{0}, std::min(batchSize, count));
+    WaitJobGroup(*jobs, group);
+}
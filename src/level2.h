@@ -2,36 +2,36 @@
 
 #include "types.h"
 
-namespace level2
+// level descriptor, see levels.h (LevelRegistry)
+struct Level2Data
 {
+    static constexpr Level_t MapData = {
+        // clang-format off
+        LevelLine_t{3, 3, 3, 3, 0, 0, 0, 3, 3, 3, 3},
+                  {3, 3, 3, 3, 0, 0, 0, 3, 3, 3, 3},
+                  {3, 3, 3, 3, 0, 0, 0, 3, 3, 3, 3},
+                  {3, 3, 3, 3, 0, 0, 0, 3, 3, 3, 3},
+                  {3, 3, 3, 3, 4, 4, 4, 3, 3, 3, 3},
+                  {3, 3, 3, 3, 0, 0, 0, 3, 0, 0, 0},
+                  {3, 3, 3, 3, 0, 0, 0, 3, 0, 0, 1},
+                  {3, 3, 3, 3, 0, 0, 0, 3, 0, 0, 0},
+                  {3, 3, 3, 3, 4, 4, 4, 3, 4, 4, 4},
+                  {3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3}
+        // clang-format on
+    };
 
-inline constexpr Level_t MapData = {
-    // clang-format off
-    LevelLine_t{3, 3, 3, 3, 0, 0, 0, 3, 3, 3, 3},
-              {3, 3, 3, 3, 0, 0, 0, 3, 3, 3, 3},
-              {3, 3, 3, 3, 0, 0, 0, 3, 3, 3, 3},
-              {3, 3, 3, 3, 0, 0, 0, 3, 3, 3, 3},
-              {3, 3, 3, 3, 4, 4, 4, 3, 3, 3, 3},
-              {3, 3, 3, 3, 0, 0, 0, 3, 0, 0, 0},
-              {3, 3, 3, 3, 0, 0, 0, 3, 0, 0, 1},
-              {3, 3, 3, 3, 0, 0, 0, 3, 0, 0, 0},
-              {3, 3, 3, 3, 4, 4, 4, 3, 4, 4, 4},
-              {3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3}
-    // clang-format on
-};
+    static constexpr Vector2 CharacterStartTilesPosition = {5, 0};
+    static constexpr CharacterDirection CharacterStartDirection = CharacterDirection::Down;
+    static constexpr int MaxNodeConnections = 3;
+    static constexpr int MaxActionsPerKey = 2;
+    static constexpr LevelGuidelines Guidelines = LevelGuidelines::Suggest;
 
-inline constexpr Vector2 CharacterStartTilesPosition = {5, 0};
-inline constexpr CharacterDirection CharacterStartDirection = CharacterDirection::Down;
-inline constexpr int MaxNodeConnections = 3;
-inline constexpr int MaxActionsPerKey = 2;
-
-inline constexpr std::array<NodeData, 6> NodesData = {
-    ActionNode({125, 165}, ConnectorAction::MovementRight),
-    ActionNode({90, 100}, ConnectorAction::MovementDown),
-    ActionNode({280, 230}, ConnectorAction::Jump),
-    KeyNode({230, 100}, ConnectorKey::J),
-    KeyNode({280, 100}, ConnectorKey::H),
-    KeyNode({240, 145}, ConnectorKey::B),
-};
-
-} // namespace level2
\ No newline at end of file
+    static constexpr std::array<NodeData, 6> NodesData = {
+        ActionNode({125, 165}, ConnectorAction::MovementRight),
+        ActionNode({90, 100}, ConnectorAction::MovementDown),
+        ActionNode({280, 230}, ConnectorAction::Jump),
+        KeyNode({230, 100}, ConnectorKey::J),
+        KeyNode({280, 100}, ConnectorKey::H),
+        KeyNode({240, 145}, ConnectorKey::B),
+    };
+};
\ No newline at end of file
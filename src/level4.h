@@ -2,36 +2,35 @@
 
 #include "types.h"
 
-namespace level4
+// level descriptor, see levels.h (LevelRegistry)
+struct Level4Data
 {
+    static constexpr Level_t MapData = {
+        // clang-format off
+        LevelLine_t{3, 3, 3, 3, 3, 3, 3, 0, 1, 3, 3},
+                  {3, 3, 3, 3, 3, 3, 3, 4, 4, 3, 3},
+                  {3, 3, 3, 3, 3, 3, 3, 0, 3, 3, 3},
+                  {3, 3, 3, 0, 0, 3, 0, 0, 3, 3, 3},
+                  {3, 3, 3, 4, 4, 3, 4, 4, 3, 3, 3},
+                  {3, 3, 3, 0, 3, 3, 3, 3, 3, 3, 3},
+                  {3, 3, 3, 0, 3, 3, 0, 0, 0, 0, 0},
+                  {0, 0, 0, 0, 3, 3, 0, 4, 4, 0, 0},
+                  {4, 4, 4, 4, 3, 3, 0, 3, 0, 4, 4},
+                  {3, 3, 3, 3, 3, 3, 4, 3, 4, 3, 3}
+        // clang-format on
+    };
 
-inline constexpr Level_t MapData = {
-    // clang-format off
-    LevelLine_t{3, 3, 3, 3, 3, 3, 3, 0, 1, 3, 3},
-              {3, 3, 3, 3, 3, 3, 3, 4, 4, 3, 3},
-              {3, 3, 3, 3, 3, 3, 3, 0, 3, 3, 3},
-              {3, 3, 3, 0, 0, 3, 0, 0, 3, 3, 3},
-              {3, 3, 3, 4, 4, 3, 4, 4, 3, 3, 3},
-              {3, 3, 3, 0, 3, 3, 3, 3, 3, 3, 3},
-              {3, 3, 3, 0, 3, 3, 0, 0, 0, 0, 0},
-              {0, 0, 0, 0, 3, 3, 0, 4, 4, 0, 0},
-              {4, 4, 4, 4, 3, 3, 0, 3, 0, 4, 4},
-              {3, 3, 3, 3, 3, 3, 4, 3, 4, 3, 3}
-    // clang-format on
-};
+    static constexpr Vector2 CharacterStartTilesPosition = {0, 7};
+    static constexpr CharacterDirection CharacterStartDirection = CharacterDirection::Right;
+    static constexpr int MaxNodeConnections = 3;
+    static constexpr int MaxActionsPerKey = 2;
 
-inline constexpr Vector2 CharacterStartTilesPosition = {0, 7};
-inline constexpr CharacterDirection CharacterStartDirection = CharacterDirection::Right;
-inline constexpr int MaxNodeConnections = 3;
-inline constexpr int MaxActionsPerKey = 2;
-
-inline constexpr std::array<NodeData, 6> NodesData = {
-    ActionNode({185, 135}, ConnectorAction::MovementUp),
-    ActionNode({280, 200}, ConnectorAction::MovementUp),
-    ActionNode({155, 200}, ConnectorAction::MovementRight),
-    ActionNode({220, 230}, ConnectorAction::Jump),
-    KeyNode({90, 100}, ConnectorKey::B),
-    KeyNode({280, 135}, ConnectorKey::K),
-};
-
-} // namespace level4
\ No newline at end of file
+    static constexpr std::array<NodeData, 6> NodesData = {
+        ActionNode({185, 135}, ConnectorAction::MovementUp),
+        ActionNode({280, 200}, ConnectorAction::MovementUp),
+        ActionNode({155, 200}, ConnectorAction::MovementRight),
+        ActionNode({220, 230}, ConnectorAction::Jump),
+        KeyNode({90, 100}, ConnectorKey::B),
+        KeyNode({280, 135}, ConnectorKey::K),
+    };
+};
\ No newline at end of file
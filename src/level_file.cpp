@@ -0,0 +1,465 @@
+#include "level_file.h"
+#include "constants.h"
+#include "level_pack.h"
+#include "level_validation.h"
+#include <raylib.h>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <string_view>
+#include <utility>
+
+inline constexpr std::array<const char*, 4> CharacterDirectionStrings{"Right", "Left", "Up", "Down"};
+inline constexpr std::array<const char*, 3> LevelGuidelinesStrings{"Keep", "Suggest", "Force"};
+inline constexpr std::array<std::pair<ConnectorAction, const char*>, 5> ConnectorActionStrings{{
+    {ConnectorAction::MovementRight, ConnectorActionMovementRightString},
+    {ConnectorAction::MovementLeft, ConnectorActionMovementLeftString},
+    {ConnectorAction::MovementDown, ConnectorActionMovementDownString},
+    {ConnectorAction::MovementUp, ConnectorActionMovementUpString},
+    {ConnectorAction::Jump, ConnectorActionJumpString},
+}};
+inline constexpr std::array<std::pair<ConnectionRule, const char*>, ConnectionRuleCount> ConnectionRuleStrings{{
+    {ConnectionRule::NodeTypes, "NodeTypes"},
+    {ConnectionRule::NodesInBetween, "NodesInBetween"},
+    {ConnectionRule::Crossings, "Crossings"},
+    {ConnectionRule::LevelConnections, "LevelConnections"},
+    {ConnectionRule::ActionsPerKey, "ActionsPerKey"},
+    {ConnectionRule::KeysPerAction, "KeysPerAction"},
+    {ConnectionRule::DirectActionsPerKey, "DirectActionsPerKey"},
+}};
+inline constexpr std::array<std::pair<ConnectorKey, const char*>, 6> ConnectorKeyStrings{{
+    {ConnectorKey::B, ConnectorKeyBString},
+    {ConnectorKey::H, ConnectorKeyHString},
+    {ConnectorKey::J, ConnectorKeyJString},
+    {ConnectorKey::K, ConnectorKeyKString},
+    {ConnectorKey::L, ConnectorKeyLString},
+    {ConnectorKey::G, ConnectorKeyGString},
+}};
+
+namespace
+{
+/// words and numbers, skips whitespace and comments (#)
+struct LevelFileReader
+{
+    const char* text{nullptr};
+    int line{1};
+
+    void skipSpace()
+    {
+        while (*text != '\0')
+        {
+            if (*text == '#')
+            {
+                while (*text != '\0' && *text != '\n')
+                {
+                    ++text;
+                }
+            }
+            else if (*text == ' ' || *text == '\t' || *text == '\r' || *text == '\n')
+            {
+                line += (*text == '\n') ? 1 : 0;
+                ++text;
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+    static bool isWordEnd(char c)
+    {
+        return c == '\0' || c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '#';
+    }
+    bool word(std::string_view& ret)
+    {
+        skipSpace();
+        const char* begin = text;
+        while (!isWordEnd(*text))
+        {
+            ++text;
+        }
+        ret = std::string_view{begin, static_cast<size_t>(text - begin)};
+        return !ret.empty();
+    }
+    /// the whole word (no "3abc")
+    bool number(int& ret)
+    {
+        std::string_view value;
+        if (!word(value))
+        {
+            return false;
+        }
+        const auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), ret);
+        return ec == std::errc{} && end == value.data() + value.size();
+    }
+    bool number(float& ret)
+    {
+        skipSpace();
+        char* end = nullptr;
+        ret = std::strtof(text, &end);
+        if (end == text || !isWordEnd(*end) || !std::isfinite(ret))
+        {
+            return false;
+        }
+        text = end;
+        return true;
+    }
+};
+
+template<typename T, size_t N>
+bool parseEnum(std::string_view word, const std::array<const char*, N>& strings, T& ret)
+{
+    for (size_t i = 0; i < strings.size(); ++i)
+    {
+        if (word == strings[i])
+        {
+            ret = static_cast<T>(i);
+            return true;
+        }
+    }
+    return false;
+}
+template<typename T, size_t N>
+bool parseEnum(std::string_view word, const std::array<std::pair<T, const char*>, N>& strings, T& ret)
+{
+    for (const auto& [value, string] : strings)
+    {
+        if (word == string)
+        {
+            ret = value;
+            return true;
+        }
+    }
+    return false;
+}
+template<typename T, size_t N>
+const char* enumString(T value, const std::array<std::pair<T, const char*>, N>& strings)
+{
+    for (const auto& [enumValue, string] : strings)
+    {
+        if (enumValue == value)
+        {
+            return string;
+        }
+    }
+    return "";
+}
+} // namespace
+
+/// level works in the game, but breaks the level rules (see level_validation.h)
+static void warnInvalidLevel(const char* fileName, const LevelData& level)
+{
+    if (!level_validation::NoOverlappingNodes(level))
+    {
+        TraceLog(LOG_WARNING, "LEVEL: [%s] nodes are overlapping", fileName);
+    }
+    if (!level_validation::HasDoor(level))
+    {
+        TraceLog(LOG_WARNING, "LEVEL: [%s] no door", fileName);
+    }
+    else if (!level_validation::IsSmallMap(level))
+    {
+        TraceLog(LOG_INFO, "LEVEL: [%s] large map, solvability is not checked", fileName);
+    }
+    else if (!level_validation::IsSolvable(level))
+    {
+        TraceLog(LOG_WARNING, "LEVEL: [%s] door can't be reached with the level limits", fileName);
+    }
+}
+
+int GetLevelFileNumber(const char* fileName)
+{
+    const std::string_view name = GetFileName(fileName);
+    const std::string_view prefix = LevelFilePrefix;
+    const std::string_view extension = LevelFileExtension;
+    if (!name.starts_with(prefix) || !name.ends_with(extension) || name.size() <= prefix.size() + extension.size())
+    {
+        return 0;
+    }
+    int ret = 0;
+    const char* first = name.data() + prefix.size();
+    const char* last = name.data() + name.size() - extension.size();
+    const auto [end, ec] = std::from_chars(first, last, ret);
+    return (ec == std::errc{} && end == last && ret > 0) ? ret : 0;
+}
+
+bool ParseLevelFile(const char* text, const char* fileName, LevelPackLevel& level)
+{
+    LevelFileReader reader{.text = text};
+    level.nodesData.clear();
+    level.data = {};
+    InitTileMap(level.tileMap, 0, 0);
+    int mapWidth = LevelMapWidth;
+    int mapHeight = LevelMapHeight;
+    bool hasMap = false;
+    bool hasStart = false;
+    const auto fail = [&](const char* message)
+    {
+        TraceLog(LOG_WARNING, "LEVEL: [%s:%d] %s", fileName, reader.line, message);
+        return false;
+    };
+
+    std::string_view word;
+    while (reader.word(word))
+    {
+        if (word == "size")
+        {
+            if (hasMap || !reader.number(mapWidth) || !reader.number(mapHeight) || mapWidth <= 0 || mapHeight <= 0 ||
+                mapWidth > MaxLevelMapSize || mapHeight > MaxLevelMapSize)
+            {
+                return fail("invalid size (width height up to MaxLevelMapSize, before map)");
+            }
+        }
+        else if (word == "map")
+        {
+            // large maps (any other size) are stored in chunks
+            const bool fixedSize = mapWidth == LevelMapWidth && mapHeight == LevelMapHeight;
+            if (!fixedSize)
+            {
+                InitTileMap(level.tileMap, mapWidth, mapHeight);
+            }
+            for (int y = 0; y < mapHeight; ++y)
+            {
+                for (int x = 0; x < mapWidth; ++x)
+                {
+                    int tile = 0;
+                    if (!reader.number(tile) || tile < 0 || tile > static_cast<int>(TileSet::Void2))
+                    {
+                        return fail("invalid tile");
+                    }
+                    if (fixedSize)
+                    {
+                        level.mapData[y][x] = tile;
+                    }
+                    else
+                    {
+                        SetTile(level.tileMap, x, y, static_cast<TileSet>(tile));
+                    }
+                }
+            }
+            hasMap = true;
+        }
+        else if (word == "start")
+        {
+            std::string_view direction;
+            if (!reader.number(level.data.characterStartTilesPosition.x) ||
+                !reader.number(level.data.characterStartTilesPosition.y) || !reader.word(direction) ||
+                !parseEnum(direction, CharacterDirectionStrings, level.data.characterStartDirection))
+            {
+                return fail("invalid start (x y direction)");
+            }
+            hasStart = true;
+        }
+        else if (word == "maxNodeConnections")
+        {
+            if (!reader.number(level.data.maxNodeConnections) || level.data.maxNodeConnections <= 0 ||
+                level.data.maxNodeConnections > level_validation::MaxEdges)
+            {
+                return fail("invalid maxNodeConnections (1 up to MaxEdges)");
+            }
+        }
+        else if (word == "maxActionsPerKey")
+        {
+            if (!reader.number(level.data.maxActionsPerKey) || level.data.maxActionsPerKey <= 0 ||
+                level.data.maxActionsPerKey > MaxLevelPackLimit)
+            {
+                return fail("invalid maxActionsPerKey (1 up to MaxLevelPackLimit)");
+            }
+        }
+        else if (word == "guidelines")
+        {
+            std::string_view guidelines;
+            if (!reader.word(guidelines) || !parseEnum(guidelines, LevelGuidelinesStrings, level.data.guidelines))
+            {
+                return fail("invalid guidelines (Keep, Suggest or Force)");
+            }
+        }
+        else if (word == "rule")
+        {
+            ConnectionRule rule{};
+            std::string_view name;
+            std::string_view value;
+            if (!reader.word(name) || !parseEnum(name, ConnectionRuleStrings, rule) || !reader.word(value))
+            {
+                return fail("invalid rule (name on/off/limit)");
+            }
+            auto& rules = level.data.connectionRules;
+            int limit = 0;
+            if (value == "on" || value == "off")
+            {
+                rules.rules = (value == "on") ? (rules.rules | static_cast<uint8_t>(rule))
+                                              : (rules.rules & ~static_cast<uint8_t>(rule));
+            }
+            else if (
+                (rule == ConnectionRule::KeysPerAction || rule == ConnectionRule::DirectActionsPerKey) &&
+                std::from_chars(value.data(), value.data() + value.size(), limit).ptr == value.data() + value.size() &&
+                limit > 0 && limit <= MaxLevelPackLimit)
+            {
+                rules.rules |= static_cast<uint8_t>(rule);
+                (rule == ConnectionRule::KeysPerAction ? rules.maxKeysPerAction : rules.maxDirectActionsPerKey) = limit;
+            }
+            else
+            {
+                return fail("invalid rule value (on, off or a limit up to MaxLevelPackLimit for KeysPerAction and "
+                            "DirectActionsPerKey)");
+            }
+        }
+        else if (word == "action" || word == "key")
+        {
+            if (level.nodesData.size() >= MaxNodesInLevel)
+            {
+                return fail("too many nodes");
+            }
+            Vector2 position{0, 0};
+            std::string_view value;
+            if (!reader.number(position.x) || !reader.number(position.y) || !reader.word(value))
+            {
+                return fail("invalid node (x y action/key)");
+            }
+            if (word == "action")
+            {
+                ConnectorAction action{ConnectorAction::NONE};
+                if (!parseEnum(value, ConnectorActionStrings, action))
+                {
+                    return fail("invalid action");
+                }
+                level.nodesData.push_back(ActionNode(position, action));
+            }
+            else
+            {
+                ConnectorKey key{ConnectorKey::NONE};
+                if (!parseEnum(value, ConnectorKeyStrings, key))
+                {
+                    return fail("invalid key");
+                }
+                level.nodesData.push_back(KeyNode(position, key));
+            }
+        }
+        else
+        {
+            // @NOTE: no TextFormat, files are parsed on the watcher thread
+            TraceLog(
+                LOG_WARNING,
+                "LEVEL: [%s:%d] unknown entry: %.*s",
+                fileName,
+                reader.line,
+                static_cast<int>(word.size()),
+                word.data());
+            return false;
+        }
+    }
+    if (!hasMap || !hasStart || level.nodesData.empty())
+    {
+        return fail("map, start and nodes are required");
+    }
+
+    if (level.tileMap.width > 0)
+    {
+        level.data.tileMap = &level.tileMap;
+    }
+    else
+    {
+        level.data.mapData = &level.mapData;
+    }
+    level.data.nodesData = level.nodesData;
+    // same as the level packs (decodeLevel in level_pack.cpp)
+    if (!level_validation::NodesInsideConnectorArea(level.data))
+    {
+        return fail("node is outside of the ConnectorArea");
+    }
+    if (!level_validation::ValidStartTile(level.data))
+    {
+        return fail("character starts outside the map or on a void tile");
+    }
+    warnInvalidLevel(fileName, level.data);
+    return true;
+}
+
+bool LoadLevelFile(const char* fileName, LevelPackLevel& level)
+{
+    char* text = LoadFileText(fileName);
+    if (text == nullptr)
+    {
+        return false;
+    }
+    const bool ret = ParseLevelFile(text, fileName, level);
+    UnloadFileText(text);
+    return ret;
+}
+
+std::string ExportLevelFile(const LevelData& level)
+{
+    std::string ret;
+    ret.reserve(1024);
+    ret += "# NeuroCircuit level\n";
+    if (level.tileMap != nullptr)
+    {
+        ret += TextFormat("size %d %d\n", level.tileMap->width, level.tileMap->height);
+    }
+    ret += "map\n";
+    for (int y = 0; y < level_validation::MapHeight(level); ++y)
+    {
+        for (int x = 0; x < level_validation::MapWidth(level); ++x)
+        {
+            ret += TextFormat((x == 0) ? "%d" : " %d", level_validation::TileAt(level, x, y));
+        }
+        ret += '\n';
+    }
+    ret += TextFormat(
+        "start %g %g %s\n",
+        level.characterStartTilesPosition.x,
+        level.characterStartTilesPosition.y,
+        CharacterDirectionStrings[static_cast<size_t>(level.characterStartDirection)]);
+    ret += TextFormat("maxNodeConnections %d\n", level.maxNodeConnections);
+    ret += TextFormat("maxActionsPerKey %d\n", level.maxActionsPerKey);
+    ret += TextFormat("guidelines %s\n", LevelGuidelinesStrings[static_cast<size_t>(level.guidelines)]);
+    // only the rules that differ from DefaultConnectionRules
+    const auto& rules = level.connectionRules;
+    for (const auto& [rule, name] : ConnectionRuleStrings)
+    {
+        if (!HasConnectionRule(rules.rules, rule))
+        {
+            ret += TextFormat("rule %s off\n", name);
+        }
+        else if (
+            rule == ConnectionRule::KeysPerAction && rules.maxKeysPerAction != DefaultConnectionRules.maxKeysPerAction)
+        {
+            ret += TextFormat("rule %s %d\n", name, rules.maxKeysPerAction);
+        }
+        else if (
+            rule == ConnectionRule::DirectActionsPerKey &&
+            rules.maxDirectActionsPerKey != DefaultConnectionRules.maxDirectActionsPerKey)
+        {
+            ret += TextFormat("rule %s %d\n", name, rules.maxDirectActionsPerKey);
+        }
+    }
+    for (const auto& node : level.nodesData)
+    {
+        switch (node.type)
+        {
+            case ConnectorType::DISABLED: break;
+            case ConnectorType::Action:
+                ret += TextFormat(
+                    "action %g %g %s\n",
+                    node.position.x,
+                    node.position.y,
+                    enumString(node.action, ConnectorActionStrings));
+                break;
+            case ConnectorType::Key:
+                ret += TextFormat(
+                    "key %g %g %s\n",
+                    node.position.x,
+                    node.position.y,
+                    enumString(node.key, ConnectorKeyStrings));
+                break;
+        }
+    }
+    return ret;
+}
+
+bool SaveLevelFile(const char* fileName, const LevelData& level)
+{
+    std::string text = ExportLevelFile(level);
+    return SaveFileText(fileName, text.data());
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "level_pack.h"
+#include "types.h"
+#include <string>
+
+/// level file (levelN.txt), text version of a level for level design (see --level-dir and level_watcher.h)
+///
+/// # comment
+/// size 11 10                (map width and height, optional, LevelMapWidth x LevelMapHeight by default)
+/// map
+/// 3 3 3 3 3 3 3 3 3 3 3     (height lines with width tiles, TileSet)
+/// ...
+/// start 0 4 Right           (character start tile and direction)
+/// maxNodeConnections 2
+/// maxActionsPerKey 2
+/// guidelines Keep           (Keep, Suggest or Force, optional)
+/// rule Crossings off        (ConnectionRule on/off, or the limit of KeysPerAction and DirectActionsPerKey, optional)
+/// action 120 100 Right      (position and action: Right, Left, Down, Up or Jump)
+/// key 280 100 J             (position and key: B, H, J, K, L or G)
+inline constexpr const char* LevelFilePrefix = "level";
+inline constexpr const char* LevelFileExtension = ".txt";
+
+/// level number from the file name (levelN.txt), 0 when it's not a level file
+[[nodiscard]] extern int GetLevelFileNumber(const char* fileName);
+
+/// parse a level file, level owns the data (same as a decoded level pack level)
+[[nodiscard]] extern bool LoadLevelFile(const char* fileName, LevelPackLevel& level);
+/// parse level file content (text), fileName is only used for error messages
+[[nodiscard]] extern bool ParseLevelFile(const char* text, const char* fileName, LevelPackLevel& level);
+
+[[nodiscard]] extern std::string ExportLevelFile(const LevelData& level);
+[[nodiscard]] extern bool SaveLevelFile(const char* fileName, const LevelData& level);
@@ -0,0 +1,381 @@
+#include "level_pack.h"
+#include "constants.h"
+#include <raylib.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+inline constexpr int LevelPackMaxRunLength = 255;
+inline constexpr int LevelPackMaxTile = static_cast<int>(TileSet::Void2);
+inline constexpr std::array<uint16_t, 6> LevelPackKeys{
+    static_cast<uint16_t>(ConnectorKey::B),
+    static_cast<uint16_t>(ConnectorKey::H),
+    static_cast<uint16_t>(ConnectorKey::J),
+    static_cast<uint16_t>(ConnectorKey::K),
+    static_cast<uint16_t>(ConnectorKey::L),
+    static_cast<uint16_t>(ConnectorKey::G)};
+
+template<typename T>
+static void appendBytes(std::vector<unsigned char>& data, const T& value)
+{
+    const auto* bytes = reinterpret_cast<const unsigned char*>(&value);
+    data.insert(data.end(), bytes, bytes + sizeof(T));
+}
+
+/// same nodes as the level files: an action node (no key) or a key node (no action)
+static bool isValidNode(const LevelPackNode& node)
+{
+    if (!std::isfinite(node.x) || !std::isfinite(node.y))
+    {
+        return false;
+    }
+    switch (static_cast<ConnectorType>(node.type))
+    {
+        case ConnectorType::Action:
+            return node.action >= static_cast<int8_t>(ConnectorAction::MovementRight) &&
+                   node.action <= static_cast<int8_t>(ConnectorAction::Jump) &&
+                   node.key == static_cast<uint16_t>(ConnectorKey::NONE);
+        case ConnectorType::Key:
+            return node.action == static_cast<int8_t>(ConnectorAction::NONE) &&
+                   std::find(LevelPackKeys.begin(), LevelPackKeys.end(), node.key) != LevelPackKeys.end();
+        case ConnectorType::DISABLED: break;
+    }
+    return false;
+}
+
+static bool decodeLevel(const LevelPack& pack, int levelIndex, LevelPackLevel& level)
+{
+    const auto& entry = pack.index[levelIndex];
+    if (entry.size < sizeof(LevelPackLevelHeader) || entry.offset > pack.file.size ||
+        entry.size > pack.file.size - entry.offset)
+    {
+        return false;
+    }
+    const unsigned char* record = pack.file.data + entry.offset;
+    const unsigned char* recordEnd = record + entry.size;
+
+    LevelPackLevelHeader header{};
+    std::memcpy(&header, record, sizeof(header));
+    record += sizeof(header);
+    // start tile inside the map (fixed size), NaN fails too
+    const bool validStart = header.characterStartX >= 0.0f && header.characterStartX < LevelMapWidth &&
+                            header.characterStartY >= 0.0f && header.characterStartY < LevelMapHeight;
+    if (header.nodeCount == 0 || header.nodeCount > MaxNodesInLevel || !validStart ||
+        header.maxNodeConnections == 0 || header.maxNodeConnections > MaxNodesInLevel || header.maxActionsPerKey == 0 ||
+        header.characterStartDirection > static_cast<uint8_t>(CharacterDirection::Down) ||
+        header.guidelines > static_cast<uint8_t>(LevelGuidelines::Force) ||
+        (header.connectionRules & ~AllConnectionRules) != 0 || header.maxConnectionsPerNode == 0 ||
+        header.maxConnectionsPerNode > MaxNodeConnections || header.maxKeysPerAction == 0 ||
+        header.maxDirectActionsPerKey == 0 ||
+        static_cast<size_t>(recordEnd - record) < header.nodeCount * sizeof(LevelPackNode) + header.tilesSize)
+    {
+        return false;
+    }
+
+    // nodes
+    level.nodesData.resize(header.nodeCount);
+    for (auto& node : level.nodesData)
+    {
+        LevelPackNode packNode{};
+        std::memcpy(&packNode, record, sizeof(packNode));
+        record += sizeof(packNode);
+        if (!isValidNode(packNode))
+        {
+            return false;
+        }
+        node.position = {packNode.x, packNode.y};
+        node.action = static_cast<ConnectorAction>(packNode.action);
+        node.key = static_cast<ConnectorKey>(packNode.key);
+        node.type = static_cast<ConnectorType>(packNode.type);
+    }
+
+    // tiles (RLE, row by row)
+    int tileIndex = 0;
+    const unsigned char* tilesEnd = record + header.tilesSize;
+    for (; record + 1 < tilesEnd; record += 2)
+    {
+        const int count = record[0];
+        const int tile = record[1];
+        if (tile > LevelPackMaxTile || tileIndex + count > LevelMapWidth * LevelMapHeight)
+        {
+            return false;
+        }
+        for (int i = 0; i < count; ++i, ++tileIndex)
+        {
+            level.mapData[tileIndex / LevelMapWidth][tileIndex % LevelMapWidth] = tile;
+        }
+    }
+    if (tileIndex != LevelMapWidth * LevelMapHeight)
+    {
+        return false;
+    }
+
+    level.data.mapData = &level.mapData;
+    level.data.nodesData = level.nodesData;
+    level.data.characterStartTilesPosition = {header.characterStartX, header.characterStartY};
+    level.data.characterStartDirection = static_cast<CharacterDirection>(header.characterStartDirection);
+    level.data.maxNodeConnections = header.maxNodeConnections;
+    level.data.maxActionsPerKey = header.maxActionsPerKey;
+    level.data.guidelines = static_cast<LevelGuidelines>(header.guidelines);
+    level.data.connectionRules = {
+        .rules = header.connectionRules,
+        .maxConnectionsPerNode = header.maxConnectionsPerNode,
+        .maxKeysPerAction = header.maxKeysPerAction,
+        .maxDirectActionsPerKey = header.maxDirectActionsPerKey,
+    };
+    return true;
+}
+
+bool OpenLevelPack(const char* fileName, LevelPack& pack)
+{
+    CloseLevelPack(pack);
+    if (!OpenMappedFile(fileName, pack.file))
+    {
+        TraceLog(LOG_WARNING, "LEVEL: [%s] failed to open level pack", fileName);
+        return false;
+    }
+
+    LevelPackHeader header{};
+    if (pack.file.size >= sizeof(header))
+    {
+        std::memcpy(&header, pack.file.data, sizeof(header));
+    }
+    if (std::memcmp(header.magic, LevelPackMagic, sizeof(LevelPackMagic)) != 0 || header.version != LevelPackVersion ||
+        header.mapWidth != LevelMapWidth || header.mapHeight != LevelMapHeight ||
+        header.levelCount > (pack.file.size - sizeof(header)) / sizeof(LevelPackIndexEntry))
+    {
+        TraceLog(LOG_WARNING, "LEVEL: [%s] invalid level pack", fileName);
+        CloseLevelPack(pack);
+        return false;
+    }
+
+    // index is read in place (mapped), entries are 4-byte aligned after the header
+    pack.index = reinterpret_cast<const LevelPackIndexEntry*>(pack.file.data + sizeof(header));
+    pack.levelCount = static_cast<int>(header.levelCount);
+    pack.levels.clear();
+    pack.levels.resize(header.levelCount);
+    TraceLog(LOG_INFO, "LEVEL: [%s] level pack with %d levels", fileName, pack.levelCount);
+    return true;
+}
+
+void CloseLevelPack(LevelPack& pack)
+{
+    pack.levels.clear();
+    pack.index = nullptr;
+    pack.levelCount = 0;
+    CloseMappedFile(pack.file);
+}
+
+LevelPack::~LevelPack()
+{
+    CloseLevelPack(*this);
+}
+
+const LevelData* GetLevelPackLevel(LevelPack& pack, int level)
+{
+    if (const LevelData* cached = FindLevelPackLevel(pack, level))
+    {
+        return cached;
+    }
+    auto decoded = std::make_unique<LevelPackLevel>();
+    if (!DecodeLevelPackLevel(pack, level, *decoded))
+    {
+        return nullptr;
+    }
+    return AddLevelPackLevel(pack, level, std::move(decoded));
+}
+
+const LevelData* FindLevelPackLevel(const LevelPack& pack, int level)
+{
+    const int levelIndex = level - 1;
+    if (levelIndex < 0 || levelIndex >= pack.levelCount || pack.levels[levelIndex] == nullptr)
+    {
+        return nullptr;
+    }
+    return &pack.levels[levelIndex]->data;
+}
+
+bool DecodeLevelPackLevel(const LevelPack& pack, int level, LevelPackLevel& decoded)
+{
+    const int levelIndex = level - 1;
+    if (levelIndex < 0 || levelIndex >= pack.levelCount)
+    {
+        return false;
+    }
+    if (!decodeLevel(pack, levelIndex, decoded))
+    {
+        TraceLog(LOG_ERROR, "LEVEL: level %i in level pack is broken", level);
+        return false;
+    }
+    return true;
+}
+
+const LevelData* AddLevelPackLevel(LevelPack& pack, int level, std::unique_ptr<LevelPackLevel> decoded)
+{
+    const int levelIndex = level - 1;
+    if (levelIndex < 0 || levelIndex >= pack.levelCount || decoded == nullptr)
+    {
+        return nullptr;
+    }
+    // decoded twice (prefetch and main thread), keep the first, it may be in use
+    if (pack.levels[levelIndex] == nullptr)
+    {
+        pack.levels[levelIndex] = std::move(decoded);
+    }
+    return &pack.levels[levelIndex]->data;
+}
+
+static LevelPackHeader makeHeader(size_t levelCount)
+{
+    LevelPackHeader header{};
+    std::memcpy(header.magic, LevelPackMagic, sizeof(LevelPackMagic));
+    header.version = LevelPackVersion;
+    header.levelCount = static_cast<uint32_t>(levelCount);
+    header.mapWidth = LevelMapWidth;
+    header.mapHeight = LevelMapHeight;
+    return header;
+}
+
+/// append the level record (4-byte aligned)
+static void encodeLevel(std::vector<unsigned char>& data, const LevelData& level)
+{
+    // RLE, row by row
+    std::vector<unsigned char> tiles;
+    int runTile = -1;
+    int runLength = 0;
+    const auto flushRun = [&]()
+    {
+        if (runLength > 0)
+        {
+            tiles.push_back(static_cast<unsigned char>(runLength));
+            tiles.push_back(static_cast<unsigned char>(runTile));
+        }
+    };
+    for (const auto& line : *level.mapData)
+    {
+        for (const int tile : line)
+        {
+            if (tile != runTile || runLength == LevelPackMaxRunLength)
+            {
+                flushRun();
+                runTile = tile;
+                runLength = 0;
+            }
+            ++runLength;
+        }
+    }
+    flushRun();
+
+    LevelPackLevelHeader levelHeader{};
+    levelHeader.characterStartX = level.characterStartTilesPosition.x;
+    levelHeader.characterStartY = level.characterStartTilesPosition.y;
+    levelHeader.characterStartDirection = static_cast<uint8_t>(level.characterStartDirection);
+    levelHeader.maxNodeConnections = static_cast<uint8_t>(level.maxNodeConnections);
+    levelHeader.maxActionsPerKey = static_cast<uint8_t>(level.maxActionsPerKey);
+    levelHeader.nodeCount = static_cast<uint8_t>(level.nodesData.size());
+    levelHeader.guidelines = static_cast<uint8_t>(level.guidelines);
+    levelHeader.connectionRules = level.connectionRules.rules;
+    levelHeader.maxConnectionsPerNode = static_cast<uint8_t>(level.connectionRules.maxConnectionsPerNode);
+    levelHeader.maxKeysPerAction = static_cast<uint8_t>(level.connectionRules.maxKeysPerAction);
+    levelHeader.maxDirectActionsPerKey = static_cast<uint8_t>(level.connectionRules.maxDirectActionsPerKey);
+    levelHeader.tilesSize = static_cast<uint16_t>(tiles.size());
+
+    appendBytes(data, levelHeader);
+    for (const auto& node : level.nodesData)
+    {
+        const LevelPackNode packNode{
+            .x = node.position.x,
+            .y = node.position.y,
+            .action = static_cast<int8_t>(node.action),
+            .type = static_cast<uint8_t>(node.type),
+            .key = static_cast<uint16_t>(node.key),
+        };
+        appendBytes(data, packNode);
+    }
+    data.insert(data.end(), tiles.begin(), tiles.end());
+    // keep the next record 4-byte aligned
+    while (data.size() % 4 != 0)
+    {
+        data.push_back(0);
+    }
+}
+
+std::vector<unsigned char> EncodeLevelPack(std::span<const LevelData> levels)
+{
+    const LevelPackHeader header = makeHeader(levels.size());
+    std::vector<LevelPackIndexEntry> index(levels.size());
+    std::vector<unsigned char> ret(sizeof(header) + index.size() * sizeof(LevelPackIndexEntry));
+    for (size_t i = 0; i < levels.size(); ++i)
+    {
+        index[i].offset = static_cast<uint32_t>(ret.size());
+        encodeLevel(ret, levels[i]);
+        index[i].size = static_cast<uint32_t>(ret.size()) - index[i].offset;
+    }
+
+    std::memcpy(ret.data(), &header, sizeof(header));
+    std::memcpy(ret.data() + sizeof(header), index.data(), index.size() * sizeof(LevelPackIndexEntry));
+    return ret;
+}
+
+bool OpenLevelPackWriter(LevelPackWriter& writer, const char* fileName, size_t maxLevelCount)
+{
+    CloseLevelPackWriter(writer);
+    writer.file = std::fopen(fileName, "wb");
+    if (writer.file == nullptr)
+    {
+        TraceLog(LOG_WARNING, "LEVEL: [%s] failed to write level pack", fileName);
+        return false;
+    }
+    writer.maxLevelCount = maxLevelCount;
+    writer.index.clear();
+    writer.index.reserve(maxLevelCount);
+    // header and index are written on close
+    writer.offset = static_cast<uint32_t>(sizeof(LevelPackHeader) + maxLevelCount * sizeof(LevelPackIndexEntry));
+    writer.failed = std::fseek(writer.file, static_cast<long>(writer.offset), SEEK_SET) != 0;
+    return !writer.failed;
+}
+
+bool WriteLevelPackLevel(LevelPackWriter& writer, const LevelData& level)
+{
+    if (writer.file == nullptr || writer.failed || writer.index.size() >= writer.maxLevelCount ||
+        level.mapData == nullptr)
+    {
+        return false;
+    }
+    writer.record.clear();
+    encodeLevel(writer.record, level);
+    if (std::fwrite(writer.record.data(), 1, writer.record.size(), writer.file) != writer.record.size())
+    {
+        writer.failed = true;
+        return false;
+    }
+    writer.index.push_back({.offset = writer.offset, .size = static_cast<uint32_t>(writer.record.size())});
+    writer.offset += static_cast<uint32_t>(writer.record.size());
+    return true;
+}
+
+bool CloseLevelPackWriter(LevelPackWriter& writer)
+{
+    if (writer.file == nullptr)
+    {
+        return false;
+    }
+    // unused index entries (less levels than maxLevelCount) stay in the file, they are skipped by levelCount
+    const LevelPackHeader header = makeHeader(writer.index.size());
+    bool ok = !writer.failed && std::fseek(writer.file, 0, SEEK_SET) == 0 &&
+              std::fwrite(&header, sizeof(header), 1, writer.file) == 1 &&
+              std::fwrite(writer.index.data(), sizeof(LevelPackIndexEntry), writer.index.size(), writer.file) ==
+                  writer.index.size();
+    ok = (std::fclose(writer.file) == 0) && ok;
+    writer.file = nullptr;
+    writer.index.clear();
+    return ok;
+}
+
+LevelPackWriter::~LevelPackWriter()
+{
+    CloseLevelPackWriter(*this);
+}
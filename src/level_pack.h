@@ -0,0 +1,125 @@
+#pragma once
+
+#include "mapped_file.h"
+#include "tile_map.h"
+#include "types.h"
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <span>
+#include <vector>
+
+/// level pack (*.pack), memory-mapped, levels are decoded on first use
+/// @NOTE: little-endian, all offsets are relative to the start of the file
+///
+/// | LevelPackHeader | LevelPackIndexEntry[levelCount] | level records ... |
+/// level record: | LevelPackLevelHeader | LevelPackNode[nodeCount] | RLE tiles (count, tile)... |
+inline constexpr char LevelPackMagic[4] = {'N', 'C', 'L', 'P'};
+inline constexpr uint32_t LevelPackVersion = 2; ///< 2: connection rules
+/// level limits (maxActionsPerKey, connection rule limits) are stored as uint8_t (LevelPackLevelHeader)
+inline constexpr int MaxLevelPackLimit = UINT8_MAX;
+
+struct LevelPackHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t levelCount;
+    uint16_t mapWidth; ///< same as LevelMapWidth
+    uint16_t mapHeight; ///< same as LevelMapHeight
+};
+static_assert(sizeof(LevelPackHeader) == 16);
+
+struct LevelPackIndexEntry
+{
+    uint32_t offset;
+    uint32_t size;
+};
+static_assert(sizeof(LevelPackIndexEntry) == 8);
+
+struct LevelPackLevelHeader
+{
+    float characterStartX;
+    float characterStartY;
+    uint8_t characterStartDirection; ///< CharacterDirection
+    uint8_t maxNodeConnections;
+    uint8_t maxActionsPerKey;
+    uint8_t nodeCount;
+    uint8_t guidelines; ///< LevelGuidelines
+    uint8_t connectionRules; ///< ConnectionRule flags
+    uint16_t tilesSize; ///< RLE bytes
+    uint8_t maxConnectionsPerNode;
+    uint8_t maxKeysPerAction;
+    uint8_t maxDirectActionsPerKey;
+    uint8_t reserved;
+};
+static_assert(sizeof(LevelPackLevelHeader) == 20);
+
+struct LevelPackNode
+{
+    float x;
+    float y;
+    int8_t action; ///< ConnectorAction
+    uint8_t type; ///< ConnectorType
+    uint16_t key; ///< ConnectorKey
+};
+static_assert(sizeof(LevelPackNode) == 12);
+
+/// Types
+struct LevelPackLevel
+{
+    Level_t mapData{};
+    TileMap tileMap; ///< maps of any size (level files)
+    std::vector<NodeData> nodesData;
+    LevelData data; ///< points into mapData (or tileMap) and nodesData
+};
+
+struct LevelPack
+{
+    MappedFile file;
+    const LevelPackIndexEntry* index{nullptr};
+    int levelCount{0};
+    std::vector<std::unique_ptr<LevelPackLevel>> levels; ///< decoded levels, nullptr until used
+
+    LevelPack() = default;
+    LevelPack(const LevelPack&) = delete;
+    LevelPack& operator=(const LevelPack&) = delete;
+    ~LevelPack();
+};
+
+/// writes a level pack level by level (level generator), the index is written on close
+struct LevelPackWriter
+{
+    std::FILE* file{nullptr};
+    size_t maxLevelCount{0};
+    std::vector<LevelPackIndexEntry> index;
+    uint32_t offset{0}; ///< next level record
+    std::vector<unsigned char> record;
+    bool failed{false};
+
+    LevelPackWriter() = default;
+    LevelPackWriter(const LevelPackWriter&) = delete;
+    LevelPackWriter& operator=(const LevelPackWriter&) = delete;
+    ~LevelPackWriter();
+};
+
+[[nodiscard]] extern bool OpenLevelPack(const char* fileName, LevelPack& pack);
+extern void CloseLevelPack(LevelPack& pack);
+/// decodes the level on first use, level starts at 1 (same as GameContext::level), nullptr when missing or broken
+[[nodiscard]] extern const LevelData* GetLevelPackLevel(LevelPack& pack, int level);
+/// already decoded level, nullptr when not used yet
+[[nodiscard]] extern const LevelData* FindLevelPackLevel(const LevelPack& pack, int level);
+/// decodes the level into decoded, not cached
+/// @NOTE: only reads the mapped file, can run on another thread while the pack is open (level prefetch)
+[[nodiscard]] extern bool DecodeLevelPackLevel(const LevelPack& pack, int level, LevelPackLevel& decoded);
+/// caches a level of DecodeLevelPackLevel (same as decoded by GetLevelPackLevel), returns the cached level
+extern const LevelData* AddLevelPackLevel(LevelPack& pack, int level, std::unique_ptr<LevelPackLevel> decoded);
+
+/// write levels into a level pack (converter), returns the file content
+/// @NOTE: only fixed-size maps (mapData), see LevelPackHeader::mapWidth
+[[nodiscard]] extern std::vector<unsigned char> EncodeLevelPack(std::span<const LevelData> levels);
+
+/// space for maxLevelCount levels is reserved (index)
+[[nodiscard]] extern bool OpenLevelPackWriter(LevelPackWriter& writer, const char* fileName, size_t maxLevelCount);
+[[nodiscard]] extern bool WriteLevelPackLevel(LevelPackWriter& writer, const LevelData& level);
+/// writes the header and index, false when writing failed
+extern bool CloseLevelPackWriter(LevelPackWriter& writer);
@@ -0,0 +1,120 @@
+#include "level_prefetch.h"
+#include <utility>
+
+static void prepareLevel(PreparedLevel& prepared, const LevelPack* pack)
+{
+    if (prepared.data == nullptr && pack != nullptr)
+    {
+        auto decoded = std::make_unique<LevelPackLevel>();
+        if (DecodeLevelPackLevel(*pack, prepared.level, *decoded))
+        {
+            prepared.data = &decoded->data;
+            prepared.decoded = std::move(decoded);
+        }
+    }
+    // also frees the nodes and map of the previous level (swapped in by TakePreparedLevel)
+    prepared.nodes = (prepared.data != nullptr) ? CreateLevelNodes(prepared.data->nodesData) : GameLevelNodes{};
+    if (prepared.data != nullptr)
+    {
+        LoadLevelTileMap(prepared.map, *prepared.data);
+    }
+    else
+    {
+        InitTileMap(prepared.map, 0, 0);
+    }
+}
+
+static void runLevelPrefetch(LevelPrefetch& prefetch)
+{
+    std::unique_lock lock{prefetch.mutex};
+    while (true)
+    {
+        prefetch.wake.wait(lock, [&]() { return prefetch.stop || prefetch.pending; });
+        if (prefetch.stop)
+        {
+            return;
+        }
+        prefetch.pending = false;
+        prefetch.busy = true;
+        lock.unlock();
+        prepareLevel(prefetch.prepared, prefetch.pack);
+        lock.lock();
+        prefetch.busy = false;
+        prefetch.ready = true;
+        prefetch.wake.notify_all();
+    }
+}
+
+void StartLevelPrefetch(LevelPrefetch& prefetch, int level, const LevelData* data, const LevelPack* pack)
+{
+    CancelLevelPrefetch(prefetch);
+    {
+        std::lock_guard lock{prefetch.mutex};
+        prefetch.prepared.level = level;
+        prefetch.prepared.data = data;
+        prefetch.pack = pack;
+        prefetch.pending = true;
+    }
+#if !defined(PLATFORM_WEB)
+    if (!prefetch.worker.joinable())
+    {
+        prefetch.worker = std::thread{runLevelPrefetch, std::ref(prefetch)};
+    }
+    prefetch.wake.notify_all();
+#endif
+}
+
+void CancelLevelPrefetch(LevelPrefetch& prefetch)
+{
+    std::unique_lock lock{prefetch.mutex};
+    prefetch.wake.wait(lock, [&]() { return !prefetch.busy; });
+    prefetch.pending = false;
+    prefetch.ready = false;
+    prefetch.pack = nullptr;
+    prefetch.prepared.level = 0;
+    prefetch.prepared.data = nullptr;
+    prefetch.prepared.decoded.reset();
+}
+
+void UpdateLevelPrefetch([[maybe_unused]] LevelPrefetch& prefetch)
+{
+#if defined(PLATFORM_WEB)
+    if (prefetch.pending)
+    {
+        prefetch.pending = false;
+        prepareLevel(prefetch.prepared, prefetch.pack);
+        prefetch.ready = true;
+    }
+#endif
+}
+
+PreparedLevel* TakePreparedLevel(LevelPrefetch& prefetch, int level)
+{
+    if (prefetch.prepared.level != level)
+    {
+        return nullptr;
+    }
+    // not done yet (short level), still no work on the main thread besides waiting
+    UpdateLevelPrefetch(prefetch);
+    std::unique_lock lock{prefetch.mutex};
+    prefetch.wake.wait(lock, [&]() { return !prefetch.pending && !prefetch.busy; });
+    if (!prefetch.ready || prefetch.prepared.data == nullptr)
+    {
+        return nullptr;
+    }
+    prefetch.ready = false;
+    return &prefetch.prepared;
+}
+
+LevelPrefetch::~LevelPrefetch()
+{
+    {
+        std::lock_guard lock{mutex};
+        stop = true;
+    }
+    wake.notify_all();
+    if (worker.joinable())
+    {
+        worker.join();
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "level_pack.h"
+#include "tile_map.h"
+#include "types.h"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/// Types
+/// level built ahead of time, the level transition swaps the nodes and map in (no allocations on that frame)
+struct PreparedLevel
+{
+    int level{0};
+    const LevelData* data{nullptr};
+    std::unique_ptr<LevelPackLevel> decoded; ///< level pack level decoded by the worker (data), see AddLevelPackLevel
+    GameLevelNodes nodes{}; ///< same as CreateLevelNodes(data->nodesData)
+    TileMap map; ///< same as LoadLevelTileMap
+};
+
+/// prepares the next level on a worker while the current level is played, one worker for all levels
+/// @NOTE: the worker never touches the game context, the level is resolved before (or decoded from the level pack,
+///        read-only), the caller owns the level sources
+/// @NOTE: no threads on Web, the level is prepared on the main thread one frame later (UpdateLevelPrefetch)
+struct LevelPrefetch
+{
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool pending{false}; ///< requested, not started yet
+    bool busy{false}; ///< worker prepares the level
+    bool ready{false};
+    bool stop{false};
+    const LevelPack* pack{nullptr}; ///< decode the level from here when data is not resolved yet
+    PreparedLevel prepared; ///< written by the worker while pending or busy
+
+    LevelPrefetch() = default;
+    LevelPrefetch(const LevelPrefetch&) = delete;
+    LevelPrefetch& operator=(const LevelPrefetch&) = delete;
+    ~LevelPrefetch();
+};
+
+/// data: resolved level (level file, compiled-in or already decoded), nullptr: decoded from the pack on the worker
+/// @NOTE: data and pack must stay valid, cancel the prefetch before changing the level sources
+extern void StartLevelPrefetch(LevelPrefetch& prefetch, int level, const LevelData* data, const LevelPack* pack);
+/// waits for the worker, drops the prepared level
+extern void CancelLevelPrefetch(LevelPrefetch& prefetch);
+/// call every frame, prepares a pending level (Web)
+extern void UpdateLevelPrefetch(LevelPrefetch& prefetch);
+/// prepared level (waits for the worker when it's not done yet), nullptr when level was not prefetched
+/// @NOTE: the level stays valid until the next StartLevelPrefetch or CancelLevelPrefetch,
+///        move a decoded level into the level pack (AddLevelPackLevel)
+[[nodiscard]] extern PreparedLevel* TakePreparedLevel(LevelPrefetch& prefetch, int level);
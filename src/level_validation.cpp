@@ -0,0 +1,27 @@
+#include "level_validation.h"
+#include "levels.h"
+
+/// compile-time checks for the compiled-in levels (BuiltinLevels), only this TU pays for the solver
+/// @NOTE: clang and MSVC need a higher constexpr limit, see CMakeLists.txt (-fconstexpr-steps, /constexpr:steps)
+template<LevelDescriptor Level>
+struct LevelValidation
+{
+    static constexpr LevelData Data = MakeLevelData<Level>();
+
+    static_assert(level_validation::ValidNodes(Data), "level: invalid node (type, action or key)");
+    static_assert(level_validation::NodesInsideConnectorArea(Data), "level: node is outside of the ConnectorArea");
+    static_assert(level_validation::NoOverlappingNodes(Data), "level: nodes are overlapping");
+    static_assert(level_validation::ValidStartTile(Data), "level: character starts outside the map or on a void tile");
+    static_assert(level_validation::HasDoor(Data), "level: no door");
+    static_assert(level_validation::ValidLimits(Data), "level: invalid MaxNodeConnections or MaxActionsPerKey");
+    static_assert(level_validation::IsSolvable(Data), "level: door can't be reached with the level limits");
+
+    static constexpr bool Valid = true;
+};
+
+template<LevelDescriptor... LevelTypes>
+consteval bool ValidateLevels(LevelRegistry<LevelTypes...>)
+{
+    return (LevelValidation<LevelTypes>::Valid && ...);
+}
+static_assert(ValidateLevels(BuiltinLevels{}));
@@ -0,0 +1,433 @@
+#pragma once
+
+#include "constants.h"
+#include "geometry.h"
+#include "tile_map.h"
+#include "types.h"
+#include <array>
+
+/// level checks, constexpr so the compiled-in levels are checked at compile-time (see level_validation.cpp),
+/// also usable at runtime (level pack, generated levels)
+namespace level_validation
+{
+inline constexpr int MaxChainLength = MaxIndirectConnections;
+inline constexpr int MaxEdges = MaxNodesInLevel;
+
+inline constexpr bool IsVoidTile(int tile)
+{
+    return tile == static_cast<int>(TileSet::Void1) || tile == static_cast<int>(TileSet::Void2);
+}
+inline constexpr int MapWidth(const LevelData& level)
+{
+    return (level.tileMap != nullptr) ? level.tileMap->width : ((level.mapData != nullptr) ? LevelMapWidth : 0);
+}
+inline constexpr int MapHeight(const LevelData& level)
+{
+    return (level.tileMap != nullptr) ? level.tileMap->height : ((level.mapData != nullptr) ? LevelMapHeight : 0);
+}
+inline constexpr bool IsInsideMap(const LevelData& level, int x, int y)
+{
+    return x >= 0 && y >= 0 && x < MapWidth(level) && y < MapHeight(level);
+}
+/// @NOTE: x, y must be inside the map
+inline constexpr int TileAt(const LevelData& level, int x, int y)
+{
+    return (level.tileMap != nullptr) ? static_cast<int>(GetTile(*level.tileMap, x, y)) : (*level.mapData)[y][x];
+}
+/// map fits into the solver (LevelMapWidth x LevelMapHeight), large maps are not checked for solvability
+inline constexpr bool IsSmallMap(const LevelData& level)
+{
+    return MapWidth(level) <= LevelMapWidth && MapHeight(level) <= LevelMapHeight;
+}
+
+/// every node is an Action- or Key-Node with an action/key
+inline constexpr bool ValidNodes(const LevelData& level)
+{
+    if (level.nodesData.empty() || level.nodesData.size() > MaxNodesInLevel)
+    {
+        return false;
+    }
+    for (const auto& node : level.nodesData)
+    {
+        switch (node.type)
+        {
+            case ConnectorType::DISABLED: return false;
+            case ConnectorType::Action:
+                if (node.action == ConnectorAction::NONE || node.key != ConnectorKey::NONE)
+                {
+                    return false;
+                }
+                break;
+            case ConnectorType::Key:
+                if (node.key == ConnectorKey::NONE || node.action != ConnectorAction::NONE)
+                {
+                    return false;
+                }
+                break;
+        }
+    }
+    return true;
+}
+
+/// nodes (circles) are inside the ConnectorArea
+inline constexpr bool NodesInsideConnectorArea(const LevelData& level)
+{
+    for (const auto& node : level.nodesData)
+    {
+        if (!geometry::CircleInsideRec(node.position, static_cast<float>(geometry::NodeRadius(node)), ConnectorArea))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// nodes (circles) don't overlap
+inline constexpr bool NoOverlappingNodes(const LevelData& level)
+{
+    for (size_t i = 0; i < level.nodesData.size(); ++i)
+    {
+        for (size_t j = i + 1; j < level.nodesData.size(); ++j)
+        {
+            const auto& node1 = level.nodesData[i];
+            const auto& node2 = level.nodesData[j];
+            if (geometry::CheckCollisionCircles(
+                    node1.position,
+                    static_cast<float>(geometry::NodeRadius(node1)),
+                    node2.position,
+                    static_cast<float>(geometry::NodeRadius(node2))))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/// character starts inside the map and not on a void tile
+inline constexpr bool ValidStartTile(const LevelData& level)
+{
+    const int x = static_cast<int>(level.characterStartTilesPosition.x);
+    const int y = static_cast<int>(level.characterStartTilesPosition.y);
+    return IsInsideMap(level, x, y) && !IsVoidTile(TileAt(level, x, y));
+}
+
+inline constexpr bool HasDoor(const LevelData& level)
+{
+    for (int y = 0; y < MapHeight(level); ++y)
+    {
+        for (int x = 0; x < MapWidth(level); ++x)
+        {
+            if (TileAt(level, x, y) == static_cast<int>(TileSet::Door))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+inline constexpr bool ValidLimits(const LevelData& level)
+{
+    const auto& rules = level.connectionRules;
+    return level.maxNodeConnections > 0 && level.maxNodeConnections <= MaxEdges && level.maxActionsPerKey > 0 &&
+           (rules.rules & ~AllConnectionRules) == 0 && rules.maxConnectionsPerNode > 0 &&
+           rules.maxConnectionsPerNode <= MaxNodeConnections && rules.maxKeysPerAction > 0 &&
+           rules.maxDirectActionsPerKey > 0;
+}
+
+/// Solver
+/// bounded search over all connections the game rules allow (LevelData::connectionRules, see main_scene.cpp):
+/// every key gets a chain of actions (key - action1 - action2 - ...),
+/// actions are executed in chain order (same as updateNodeConnections in game.cpp),
+/// then a search over the reachable character states (tile and direction)
+/// @NOTE: chains follow the default KeysPerAction and DirectActionsPerKey rules, relaxed rules only allow more
+/// one bit per tile (bit x of row y), all character positions with the same direction at once
+using SolverBoard = std::array<uint32_t, LevelMapHeight>;
+inline constexpr int SolverDirectionCount = 4;
+using SolverBoards = std::array<SolverBoard, SolverDirectionCount>; ///< per CharacterDirection
+static_assert(LevelMapWidth <= 32, "map rows must fit into SolverBoard rows");
+
+/// tile masks of the level map (precomputed once per level)
+struct SolverMap
+{
+    SolverBoard inside{};
+    SolverBoard walkable{}; ///< inside and not void
+    SolverBoard door{};
+};
+
+inline constexpr SolverMap MakeSolverMap(const LevelData& level)
+{
+    SolverMap ret;
+    for (int y = 0; y < MapHeight(level); ++y)
+    {
+        for (int x = 0; x < MapWidth(level); ++x)
+        {
+            const int tile = TileAt(level, x, y);
+            const uint32_t bit = 1u << x;
+            ret.inside[y] |= bit;
+            ret.walkable[y] |= IsVoidTile(tile) ? 0u : bit;
+            ret.door[y] |= (tile == static_cast<int>(TileSet::Door)) ? bit : 0u;
+        }
+    }
+    return ret;
+}
+
+struct SolverChain
+{
+    int keyNode{-1};
+    std::array<ConnectorAction, MaxChainLength> actions{};
+    int length{0};
+};
+struct SolverEdge
+{
+    int node1{-1};
+    int node2{-1};
+};
+struct SolverState
+{
+    std::array<SolverChain, MaxNodesInLevel> chains{};
+    int chainCount{0};
+    std::array<SolverEdge, MaxEdges> edges{};
+    int edgeCount{0};
+    std::array<bool, MaxNodesInLevel> usedNodes{};
+    std::array<int, MaxNodesInLevel> connections{}; ///< per node, at most ConnectionRules::maxConnectionsPerNode
+    SolverMap map{};
+};
+
+/// new connection between node1 and node2 is allowed (with the already existing connections)
+inline constexpr bool SolverValidEdge(const LevelData& level, const SolverState& state, int node1, int node2)
+{
+    const auto& data1 = level.nodesData[node1];
+    const auto& data2 = level.nodesData[node2];
+    const uint8_t rules = level.connectionRules.rules;
+    // always active (same as validateConnection)
+    const int maxConnectionsPerNode = level.connectionRules.maxConnectionsPerNode;
+    if (state.connections[node1] >= maxConnectionsPerNode || state.connections[node2] >= maxConnectionsPerNode)
+    {
+        return false;
+    }
+    if (HasConnectionRule(rules, ConnectionRule::NodeTypes) && data1.type == data2.type &&
+        data1.type != ConnectorType::Action)
+    {
+        return false;
+    }
+    // nodes in between
+    for (size_t i = 0; HasConnectionRule(rules, ConnectionRule::NodesInBetween) && i < level.nodesData.size(); ++i)
+    {
+        if (static_cast<int>(i) != node1 && static_cast<int>(i) != node2 &&
+            geometry::CheckCollisionLineNode(data1.position, data2.position, level.nodesData[i]))
+        {
+            return false;
+        }
+    }
+    // crossing connections
+    for (int i = 0; HasConnectionRule(rules, ConnectionRule::Crossings) && i < state.edgeCount; ++i)
+    {
+        const auto& edge = state.edges[i];
+        if (edge.node1 != node1 && edge.node1 != node2 && edge.node2 != node1 && edge.node2 != node2 &&
+            geometry::CheckCollisionLines(
+                data1.position,
+                data2.position,
+                level.nodesData[edge.node1].position,
+                level.nodesData[edge.node2].position))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// move all positions of the board one step (tiles) in direction, positions outside of the map are dropped
+inline constexpr SolverBoard SolverShiftBoard(const SolverBoard& board, CharacterDirection direction, int tiles)
+{
+    SolverBoard ret{};
+    for (int y = 0; y < LevelMapHeight; ++y)
+    {
+        switch (direction)
+        {
+            case CharacterDirection::Right: ret[y] = board[y] << tiles; break;
+            case CharacterDirection::Left: ret[y] = board[y] >> tiles; break;
+            case CharacterDirection::Up: ret[y] = (y + tiles < LevelMapHeight) ? board[y + tiles] : 0u; break;
+            case CharacterDirection::Down: ret[y] = (y - tiles >= 0) ? board[y - tiles] : 0u; break;
+        }
+    }
+    return ret;
+}
+
+/// move the characters (all positions and directions of the boards) with all actions of the chain (key press),
+/// dead characters are removed from the boards
+/// @return true when a character stops on the door
+inline constexpr bool SolverRunChain(const SolverMap& map, const SolverChain& chain, SolverBoards& boards)
+{
+    for (int i = 0; i < chain.length; ++i)
+    {
+        SolverBoards next{};
+        const auto moveAll = [&](CharacterDirection direction)
+        {
+            auto& nextBoard = next[static_cast<int>(direction)];
+            for (const auto& board : boards)
+            {
+                const SolverBoard moved = SolverShiftBoard(board, direction, 1);
+                for (int y = 0; y < LevelMapHeight; ++y)
+                {
+                    nextBoard[y] |= moved[y];
+                }
+            }
+        };
+        switch (chain.actions[i])
+        {
+            case ConnectorAction::NONE: next = boards; break;
+            case ConnectorAction::MovementRight: moveAll(CharacterDirection::Right); break;
+            case ConnectorAction::MovementLeft: moveAll(CharacterDirection::Left); break;
+            case ConnectorAction::MovementDown: moveAll(CharacterDirection::Down); break;
+            case ConnectorAction::MovementUp: moveAll(CharacterDirection::Up); break;
+            case ConnectorAction::Jump:
+                for (int d = 0; d < SolverDirectionCount; ++d)
+                {
+                    next[d] = SolverShiftBoard(boards[d], static_cast<CharacterDirection>(d), JumpFactor);
+                }
+                break;
+        }
+        // tile is checked after every action
+        uint32_t reachedDoor = 0;
+        for (auto& board : next)
+        {
+            for (int y = 0; y < LevelMapHeight; ++y)
+            {
+                board[y] &= map.inside[y];
+                reachedDoor |= board[y] & map.door[y];
+                board[y] &= map.walkable[y];
+            }
+        }
+        if (reachedDoor != 0)
+        {
+            return true;
+        }
+        boards = next;
+    }
+    return false;
+}
+
+/// breadth-first search over the character states (tile, direction) with the current key binds,
+/// bit-parallel: the whole frontier is moved at once
+inline constexpr bool SolverReachesDoor(const SolverMap& map, const LevelData& level, const SolverState& state)
+{
+    SolverBoards visited{};
+    SolverBoards frontier{};
+    const int startX = static_cast<int>(level.characterStartTilesPosition.x);
+    const int startY = static_cast<int>(level.characterStartTilesPosition.y);
+    frontier[static_cast<int>(level.characterStartDirection)][startY] = 1u << startX;
+    visited = frontier;
+    bool hasFrontier = true;
+    while (hasFrontier)
+    {
+        SolverBoards reached{};
+        for (int c = 0; c < state.chainCount; ++c)
+        {
+            SolverBoards boards = frontier;
+            if (SolverRunChain(map, state.chains[c], boards))
+            {
+                return true;
+            }
+            for (int d = 0; d < SolverDirectionCount; ++d)
+            {
+                for (int y = 0; y < LevelMapHeight; ++y)
+                {
+                    reached[d][y] |= boards[d][y];
+                }
+            }
+        }
+        hasFrontier = false;
+        for (int d = 0; d < SolverDirectionCount; ++d)
+        {
+            for (int y = 0; y < LevelMapHeight; ++y)
+            {
+                frontier[d][y] = reached[d][y] & ~visited[d][y];
+                visited[d][y] |= frontier[d][y];
+                hasFrontier = hasFrontier || frontier[d][y] != 0;
+            }
+        }
+    }
+    return false;
+}
+
+inline constexpr bool SolverBindKey(const LevelData& level, SolverState& state, int nodeIndex);
+
+/// extend the chain of the current key (last chain) with one more action node, after lastNode
+inline constexpr bool SolverExtendChain(const LevelData& level, SolverState& state, int nodeIndex, int lastNode)
+{
+    auto& chain = state.chains[state.chainCount - 1];
+    const int maxChainLength = (level.maxActionsPerKey < MaxChainLength) ? level.maxActionsPerKey : MaxChainLength;
+    if (chain.length >= maxChainLength || state.edgeCount >= level.maxNodeConnections)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < level.nodesData.size(); ++i)
+    {
+        const int actionNode = static_cast<int>(i);
+        if (level.nodesData[i].type != ConnectorType::Action || state.usedNodes[i] ||
+            !SolverValidEdge(level, state, lastNode, actionNode))
+        {
+            continue;
+        }
+        state.usedNodes[i] = true;
+        state.edges[state.edgeCount++] = {lastNode, actionNode};
+        ++state.connections[lastNode];
+        ++state.connections[actionNode];
+        chain.actions[chain.length++] = level.nodesData[i].action;
+
+        if (SolverBindKey(level, state, nodeIndex + 1) || SolverExtendChain(level, state, nodeIndex, actionNode))
+        {
+            return true;
+        }
+
+        --chain.length;
+        --state.connections[actionNode];
+        --state.connections[lastNode];
+        --state.edgeCount;
+        state.usedNodes[i] = false;
+    }
+    return false;
+}
+
+/// bind the next key (from nodeIndex), try all chains first, then leave the key unbound
+inline constexpr bool SolverBindKey(const LevelData& level, SolverState& state, int nodeIndex)
+{
+    while (nodeIndex < static_cast<int>(level.nodesData.size()) &&
+           level.nodesData[nodeIndex].type != ConnectorType::Key)
+    {
+        ++nodeIndex;
+    }
+    if (nodeIndex >= static_cast<int>(level.nodesData.size()))
+    {
+        return state.chainCount > 0 && SolverReachesDoor(state.map, level, state);
+    }
+
+    state.chains[state.chainCount++] = {.keyNode = nodeIndex};
+    if (SolverExtendChain(level, state, nodeIndex, nodeIndex))
+    {
+        return true;
+    }
+    --state.chainCount;
+
+    return SolverBindKey(level, state, nodeIndex + 1);
+}
+
+/// there are connections (in the level limits) to reach the door
+inline constexpr bool IsSolvable(const LevelData& level)
+{
+    if (!ValidNodes(level) || !ValidStartTile(level) || !ValidLimits(level) || !IsSmallMap(level))
+    {
+        return false;
+    }
+    SolverState state{.map = MakeSolverMap(level)};
+    return SolverBindKey(level, state, 0);
+}
+
+inline constexpr bool IsValidLevel(const LevelData& level)
+{
+    return ValidNodes(level) && NodesInsideConnectorArea(level) && NoOverlappingNodes(level) &&
+           ValidStartTile(level) && HasDoor(level) && ValidLimits(level) && IsSolvable(level);
+}
+} // namespace level_validation
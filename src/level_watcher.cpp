@@ -0,0 +1,144 @@
+#include "level_watcher.h"
+#include "level_file.h"
+#include <raylib.h>
+#include <array>
+#include <cstdint>
+
+#if defined(__linux__) && !defined(PLATFORM_WEB)
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#define LEVEL_WATCHER_INOTIFY
+#endif
+
+static void loadLevel(LevelWatcher& watcher, const char* fileName)
+{
+    const int level = GetLevelFileNumber(fileName);
+    if (level <= 0)
+    {
+        return;
+    }
+    auto levelFile = std::make_unique<LevelPackLevel>();
+    if (!LoadLevelFile(fileName, *levelFile))
+    {
+        // keep the last working version
+        return;
+    }
+    TraceLog(LOG_INFO, "LEVEL: [%s] loaded level %d", fileName, level);
+    std::lock_guard lock{watcher.mutex};
+    watcher.reloaded.emplace_back(level, std::move(levelFile));
+    watcher.hasReloaded.store(true, std::memory_order_release);
+}
+
+#if defined(LEVEL_WATCHER_INOTIFY)
+static void watchLevels(LevelWatcher& watcher)
+{
+    alignas(inotify_event) char buffer[4096];
+    std::array<pollfd, 2> fds{{
+        {.fd = watcher.watchFd, .events = POLLIN, .revents = 0},
+        {.fd = watcher.wakeFd, .events = POLLIN, .revents = 0},
+    }};
+    while (!watcher.stop.load(std::memory_order_acquire))
+    {
+        if (poll(fds.data(), fds.size(), -1) <= 0 || (fds[1].revents & POLLIN) != 0)
+        {
+            continue;
+        }
+        const ssize_t size = read(watcher.watchFd, buffer, sizeof(buffer));
+        for (ssize_t offset = 0; offset < size;)
+        {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+            // written (saved) or moved into the directory (editors saving with rename)
+            if (event->len > 0 && (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) != 0)
+            {
+                // @NOTE: no TextFormat on this thread (shared buffers)
+                const std::string fileName = watcher.directory + "/" + event->name;
+                loadLevel(watcher, fileName.c_str());
+            }
+        }
+    }
+}
+#endif
+
+bool StartLevelWatcher(LevelWatcher& watcher, const char* directory)
+{
+    StopLevelWatcher(watcher);
+    if (!DirectoryExists(directory))
+    {
+        TraceLog(LOG_WARNING, "LEVEL: [%s] level directory not found", directory);
+        return false;
+    }
+    watcher.directory = directory;
+
+    const FilePathList files = LoadDirectoryFilesEx(directory, LevelFileExtension, false);
+    for (unsigned int i = 0; i < files.count; ++i)
+    {
+        loadLevel(watcher, files.paths[i]);
+    }
+    UnloadDirectoryFiles(files);
+
+#if defined(LEVEL_WATCHER_INOTIFY)
+    watcher.watchFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    watcher.wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (watcher.watchFd < 0 || watcher.wakeFd < 0 ||
+        inotify_add_watch(watcher.watchFd, directory, IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+    {
+        TraceLog(LOG_WARNING, "LEVEL: [%s] failed to watch level directory", directory);
+        StopLevelWatcher(watcher);
+        return false;
+    }
+    watcher.stop = false;
+    watcher.thread = std::thread{watchLevels, std::ref(watcher)};
+    TraceLog(LOG_INFO, "LEVEL: [%s] watching level files", directory);
+#else
+    TraceLog(LOG_WARNING, "LEVEL: [%s] level files are not watched on this platform (no hot-reload)", directory);
+#endif
+    return true;
+}
+
+void StopLevelWatcher(LevelWatcher& watcher)
+{
+    watcher.stop = true;
+#if defined(LEVEL_WATCHER_INOTIFY)
+    if (watcher.wakeFd >= 0)
+    {
+        const uint64_t wake = 1;
+        [[maybe_unused]] const ssize_t written = write(watcher.wakeFd, &wake, sizeof(wake));
+    }
+#endif
+    if (watcher.thread.joinable())
+    {
+        watcher.thread.join();
+    }
+#if defined(LEVEL_WATCHER_INOTIFY)
+    if (watcher.watchFd >= 0)
+    {
+        close(watcher.watchFd);
+    }
+    if (watcher.wakeFd >= 0)
+    {
+        close(watcher.wakeFd);
+    }
+#endif
+    watcher.watchFd = -1;
+    watcher.wakeFd = -1;
+}
+
+LevelWatcher::~LevelWatcher()
+{
+    StopLevelWatcher(*this);
+}
+
+void TakeReloadedLevels(LevelWatcher& watcher, std::vector<ReloadedLevel>& levels)
+{
+    levels.clear();
+    if (!watcher.hasReloaded.load(std::memory_order_acquire))
+    {
+        return;
+    }
+    std::lock_guard lock{watcher.mutex};
+    levels.swap(watcher.reloaded);
+    watcher.hasReloaded.store(false, std::memory_order_release);
+}
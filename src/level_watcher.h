@@ -0,0 +1,43 @@
+#pragma once
+
+#include "level_pack.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/// Types
+using ReloadedLevel = std::pair<int, std::unique_ptr<LevelPackLevel>>; ///< level number, parsed level file
+
+/// level design (dev mode, --level-dir): loads level files (levelN.txt, see level_file.h) and watches the directory,
+/// changed files are parsed on the watcher thread, the game picks them up with TakeReloadedLevels (main thread)
+/// @NOTE: watching needs inotify (Linux), other platforms only load the files once
+struct LevelWatcher
+{
+    std::string directory;
+    std::thread thread;
+    std::atomic<bool> stop{false};
+
+    // filled by the watcher thread
+    std::mutex mutex;
+    std::vector<ReloadedLevel> reloaded;
+    std::atomic<bool> hasReloaded{false};
+
+    // platform handles
+    int watchFd{-1};
+    int wakeFd{-1};
+
+    LevelWatcher() = default;
+    LevelWatcher(const LevelWatcher&) = delete;
+    LevelWatcher& operator=(const LevelWatcher&) = delete;
+    ~LevelWatcher();
+};
+
+/// loads all level files in directory and starts watching it
+[[nodiscard]] extern bool StartLevelWatcher(LevelWatcher& watcher, const char* directory);
+extern void StopLevelWatcher(LevelWatcher& watcher);
+/// levels (re)loaded since the last call, cheap when nothing changed (call every frame)
+extern void TakeReloadedLevels(LevelWatcher& watcher, std::vector<ReloadedLevel>& levels);
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "types.h"
+#include <array>
+#include <concepts>
+// Levels
+#include "level1.h"
+#include "level2.h"
+#include "level3.h"
+#include "level4.h"
+#include "level5.h"
+
+/// level descriptor (LevelNData struct), see level1.h
+/// optional: Guidelines (LevelGuidelines), Rules (ConnectionRules, e.g. more keys per action)
+template<typename Level>
+concept LevelDescriptor = requires {
+    { Level::MapData } -> std::convertible_to<const Level_t&>;
+    { Level::CharacterStartTilesPosition } -> std::convertible_to<Vector2>;
+    { Level::CharacterStartDirection } -> std::convertible_to<CharacterDirection>;
+    { Level::MaxNodeConnections } -> std::convertible_to<int>;
+    { Level::MaxActionsPerKey } -> std::convertible_to<int>;
+    Level::NodesData.size();
+} && (Level::NodesData.size() <= MaxNodesInLevel);
+
+template<LevelDescriptor Level>
+inline constexpr LevelData MakeLevelData()
+{
+    LevelData ret{
+        .mapData = &Level::MapData,
+        .nodesData = Level::NodesData,
+        .characterStartTilesPosition = Level::CharacterStartTilesPosition,
+        .characterStartDirection = Level::CharacterStartDirection,
+        .maxNodeConnections = Level::MaxNodeConnections,
+        .maxActionsPerKey = Level::MaxActionsPerKey,
+    };
+    // optional, keep the guide lines by default
+    if constexpr (requires { Level::Guidelines; })
+    {
+        ret.guidelines = Level::Guidelines;
+    }
+    // optional, DefaultConnectionRules by default
+    if constexpr (requires { Level::Rules; })
+    {
+        ret.connectionRules = Level::Rules;
+    }
+    return ret;
+}
+
+/// all levels in order (level 1 first), precomputed at compile-time
+template<LevelDescriptor... LevelTypes>
+struct LevelRegistry
+{
+    static constexpr std::array<LevelData, sizeof...(LevelTypes)> Levels{MakeLevelData<LevelTypes>()...};
+    static constexpr int Count = static_cast<int>(sizeof...(LevelTypes));
+};
+
+/// @NOTE: add (new) levels here
+using BuiltinLevels = LevelRegistry<Level1Data, Level2Data, Level3Data, Level4Data, Level5Data>;
+
+inline constexpr int MaxLevels = BuiltinLevels::Count;
+static_assert(MaxLevels > 0);
+
+/// compiled-in levels, level starts at 1, nullptr when there is no such level
+[[nodiscard]] inline constexpr const LevelData* GetBuiltinLevel(int level)
+{
+    return (level >= 1 && level <= MaxLevels) ? &BuiltinLevels::Levels[level - 1] : nullptr;
+}
@@ -0,0 +1,100 @@
+#include "logic_thread.h"
+#include <raylib.h>
+#include <utility>
+
+static void runLogicThread(LogicThread& thread)
+{
+    FrameInput input;
+    while (true)
+    {
+        {
+            std::unique_lock lock{thread.mutex};
+            thread.wake.wait(lock, [&]() { return thread.stop || thread.hasInput; });
+            if (thread.stop)
+            {
+                return;
+            }
+            input = thread.pendingInput;
+            // presses are handled once, the time counts from here
+            thread.pendingInput.keysPressed.reset();
+            thread.pendingInput.mouseButtonsPressed.reset();
+            thread.pendingInput.mouseButtonsReleased.reset();
+            thread.pendingInput.frameTime = 0.0f;
+            thread.hasInput = false;
+        }
+
+        thread.tick(input);
+
+        {
+            std::lock_guard lock{thread.mutex};
+            std::swap(*thread.recording, thread.published);
+            thread.hasPublished = true;
+        }
+        thread.ticks.fetch_add(1, std::memory_order_relaxed);
+        thread.wake.notify_all();
+    }
+}
+
+void StartLogicThread(LogicThread& thread, RenderQueue& recording, LogicTickFunction tick)
+{
+    StopLogicThread(thread);
+    thread.tick = std::move(tick);
+    thread.recording = &recording;
+    thread.pendingInput = {};
+    thread.hasInput = false;
+    thread.hasPublished = false;
+    thread.hasFrame = false;
+    thread.stop = false;
+    thread.worker = std::thread{runLogicThread, std::ref(thread)};
+    TraceLog(LOG_INFO, "LOGIC: game logic on its own thread");
+}
+
+void StopLogicThread(LogicThread& thread)
+{
+    {
+        std::lock_guard lock{thread.mutex};
+        thread.stop = true;
+    }
+    thread.wake.notify_all();
+    if (thread.worker.joinable())
+    {
+        thread.worker.join();
+    }
+}
+
+void SubmitLogicInput(LogicThread& thread, const FrameInput& input)
+{
+    {
+        std::lock_guard lock{thread.mutex};
+        MergeFrameInput(thread.pendingInput, input);
+        thread.hasInput = true;
+    }
+    thread.wake.notify_all();
+}
+
+RenderQueue& TakeLogicFrame(LogicThread& thread)
+{
+    std::unique_lock lock{thread.mutex};
+    if (!thread.hasFrame)
+    {
+        // nothing to draw yet
+        thread.wake.wait(lock, [&]() { return thread.stop || thread.hasPublished; });
+    }
+    if (thread.hasPublished)
+    {
+        std::swap(thread.front, thread.published);
+        thread.hasPublished = false;
+        thread.hasFrame = true;
+    }
+    else
+    {
+        ++thread.repeatedFrames;
+    }
+    ++thread.frames;
+    return thread.front;
+}
+
+LogicThread::~LogicThread()
+{
+    StopLogicThread(*this);
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "frame_input.h"
+#include "render_queue.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/// game logic on its own thread (--logic-thread): every tick updates the game with the input of the frames since the
+/// last tick and records the frame (RenderQueue), the finished frame is published as a snapshot,
+/// the main thread polls the input and draws the newest snapshot (FlushRenderQueue), it never waits for a tick
+/// @NOTE: three queues (recording, published, front), a slow tick (validation, level load) only repeats the last frame
+/// @NOTE: no threads on Web, the logic runs in UpdateDrawFrame
+
+/// Types
+/// one tick: update with the input, record the frame into the recording queue
+using LogicTickFunction = std::function<void(const FrameInput& input)>;
+
+struct LogicThread
+{
+    std::thread worker;
+    LogicTickFunction tick;
+    RenderQueue* recording{nullptr}; ///< filled by tick (logic thread), swapped with published
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    FrameInput pendingInput; ///< merged input of the frames since the last tick
+    bool hasInput{false};
+    RenderQueue published; ///< newest complete frame
+    bool hasPublished{false};
+    bool stop{false};
+
+    RenderQueue front; ///< drawn by the main thread, kept until a newer frame is published
+    bool hasFrame{false};
+
+    // stats
+    std::atomic<uint64_t> ticks{0};
+    uint64_t frames{0}; ///< drawn by the main thread
+    uint64_t repeatedFrames{0}; ///< no new snapshot, last frame drawn again
+
+    LogicThread() = default;
+    LogicThread(const LogicThread&) = delete;
+    LogicThread& operator=(const LogicThread&) = delete;
+    ~LogicThread();
+};
+
+/// the logic thread waits for the first input (SubmitLogicInput)
+extern void StartLogicThread(LogicThread& thread, RenderQueue& recording, LogicTickFunction tick);
+/// waits for the current tick
+extern void StopLogicThread(LogicThread& thread);
+/// main thread, every frame: input for the next tick
+extern void SubmitLogicInput(LogicThread& thread, const FrameInput& input);
+/// main thread: newest snapshot (front), only waits for the first tick, the queue stays valid until the next call
+[[nodiscard]] extern RenderQueue& TakeLogicFrame(LogicThread& thread);
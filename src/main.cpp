@@ -18,10 +18,15 @@
 #include <emscripten/emscripten.h> // Emscripten library - LLVM to JavaScript compiler
 #endif
 
+#include <array>
 #include <cassert>
 #include <chrono>
+#include <cstdio>
 #include <cstdlib>
 #include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 //----------------------------------------------------------------------------------
 // Defines and Macros
@@ -42,8 +47,14 @@
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
+#include "asset_loader.h"
+#include "atlas.h"
 #include "constants.h"
+#include "frame_input.h"
 #include "game.h"
+#include "level_watcher.h"
+#include "logic_thread.h"
+#include "render_queue.h"
 #include "types.h"
 
 //----------------------------------------------------------------------------------
@@ -52,13 +63,29 @@
 
 /// @NOTE: game needs to be global for emscripten, see UpdateDrawFrame (no parameter passing)
 static std::unique_ptr<GameContext> g_gameContext{nullptr};
+/// @NOTE: assets are decoded in the background, the start scene shows up when the atlas (logo) is ready
+static std::unique_ptr<AssetLoader> g_assetLoader{nullptr};
+static int g_atlasAssetId{-1};
+inline constexpr int AssetLoaderMaxWorkers = 4;
+inline constexpr const char* AssetCacheDirectoryName = "cache";
+/// @NOTE: level design (dev mode), level files are reloaded while playing, see --level-dir
+static std::unique_ptr<LevelWatcher> g_levelWatcher{nullptr};
+static std::vector<ReloadedLevel> g_reloadedLevels;
+/// input of the frame, polled on the main thread
+static FrameInput g_frameInput;
+/// @NOTE: game logic on its own thread (--logic-thread),
+///        started when the assets are loaded (the textures are uploaded on the main thread)
+static std::unique_ptr<LogicThread> g_logicThread{nullptr};
+[[maybe_unused]] static bool g_useLogicThread{false};
+static bool g_assetsLoaded{false};
 void UpdateGameLogic();
+void RecordFrame(); // scene into the render queue (main thread or logic thread)
 void UpdateDrawFrame(); // Update and Draw one frame
 
 //------------------------------------------------------------------------------------
 // Program main entry point
 //------------------------------------------------------------------------------------
-int main(int /*argc*/, char** /*argv*/)
+int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv)
 {
 #if !defined(PLATFORM_WEB)
 #ifndef NDEBUG
@@ -81,18 +108,61 @@ int main(int /*argc*/, char** /*argv*/)
     /// @NOTE: use unique_ptr, init game context AFTER init window to avoid some init. fiasco ... (problems with font loading...) ???
     g_gameContext = std::make_unique<GameContext>();
 
-    //g_gameContext->font = LoadFontEx("resources/MonaspaceArgon-ExtraBold.otf", 32, 0, 250);
     g_gameContext->font = GetFontDefault();
+    // no threads until a fork is large enough (levels are small, see UpdateNodesMinBatch)
+    InitJobSystem(g_gameContext->jobs);
 
-    g_gameContext->logoTexture = LoadTexture("resources/logo.png");
-    g_gameContext->instruction1Texture = LoadTexture("resources/instruction1.png");
-    g_gameContext->instruction2Texture = LoadTexture("resources/instruction2.png");
-    g_gameContext->tilesetTexture = LoadTexture("resources/tileset.png");
-    g_gameContext->characterSpriteSheetTexture = LoadTexture("resources/character.png");
-    g_gameContext->iconsSpriteSheetTexture = LoadTexture("resources/icons.png");
-    g_gameContext->iconsControlSpriteSheetTexture = LoadTexture("resources/icons-control.png");
-    g_gameContext->endTexture = LoadTexture("resources/end.png");
-
+    g_assetLoader = std::make_unique<AssetLoader>();
+#if !defined(PLATFORM_WEB)
+    // command line
+    // decoded texture cache (next to the executable), --asset-cache=<dir> to move it, --no-asset-cache to disable it
+    g_assetLoader->cacheDirectory = TextFormat("%s%s", GetApplicationDirectory(), AssetCacheDirectoryName);
+    for (int i = 1; i < argc; ++i)
+    {
+        constexpr std::string_view AssetCacheArg = "--asset-cache=";
+        constexpr std::string_view LevelPackArg = "--level-pack=";
+        constexpr std::string_view LevelDirArg = "--level-dir=";
+        const std::string_view arg = argv[i];
+        if (arg == "--no-asset-cache")
+        {
+            g_assetLoader->cacheDirectory.clear();
+        }
+        // update the game on its own thread, the main thread only draws
+        else if (arg == "--logic-thread")
+        {
+            g_useLogicThread = true;
+        }
+        else if (arg.starts_with(AssetCacheArg))
+        {
+            g_assetLoader->cacheDirectory = arg.substr(AssetCacheArg.size());
+        }
+        // levels from a level pack instead of the compiled-in levels
+        else if (arg.starts_with(LevelPackArg))
+        {
+            if (!OpenLevelPack(argv[i] + LevelPackArg.size(), g_gameContext->levelPack))
+            {
+                TraceLog(LOG_WARNING, "LEVEL: using the compiled-in levels");
+            }
+        }
+        // level files (levelN.txt), replace levels and are reloaded on save
+        else if (arg.starts_with(LevelDirArg))
+        {
+            g_levelWatcher = std::make_unique<LevelWatcher>();
+            if (!StartLevelWatcher(*g_levelWatcher, argv[i] + LevelDirArg.size()))
+            {
+                g_levelWatcher.reset();
+            }
+            else
+            {
+                g_gameContext->levelDirectory = g_levelWatcher->directory;
+            }
+        }
+    }
+#endif
+    //QueueFontAsset(*g_assetLoader, "resources/MonaspaceArgon-ExtraBold.otf", 32, 250, &g_gameContext->font);
+    g_atlasAssetId =
+        QueueTextureAsset(*g_assetLoader, TextFormat("resources/%s", AtlasFileName), &g_gameContext->atlasTexture);
+    StartAssetLoader(*g_assetLoader, AssetLoaderMaxWorkers);
 
     constexpr int FPS = 60;
 #if defined(PLATFORM_WEB)
@@ -111,15 +181,12 @@ int main(int /*argc*/, char** /*argv*/)
     // De-Initialization
     //--------------------------------------------------------------------------------------
 
+    g_logicThread.reset();
+    g_levelWatcher.reset();
+    g_assetLoader.reset();
+    StopJobSystem(g_gameContext->jobs);
     UnloadFont(g_gameContext->font);
-    UnloadTexture(g_gameContext->logoTexture);
-    UnloadTexture(g_gameContext->instruction1Texture);
-    UnloadTexture(g_gameContext->instruction2Texture);
-    UnloadTexture(g_gameContext->tilesetTexture);
-    UnloadTexture(g_gameContext->characterSpriteSheetTexture);
-    UnloadTexture(g_gameContext->iconsSpriteSheetTexture);
-    UnloadTexture(g_gameContext->iconsControlSpriteSheetTexture);
-    UnloadTexture(g_gameContext->endTexture);
+    UnloadTexture(g_gameContext->atlasTexture);
 
     // CloseAudioDevice();
     CloseWindow(); // Close window and OpenGL context
@@ -135,9 +202,27 @@ void UpdateGameLogic()
 {
     assert(g_gameContext != nullptr);
     using fsec = std::chrono::duration<float>;
-    g_gameContext->delta = std::chrono::duration_cast<std::chrono::milliseconds>(fsec{GetFrameTime()});
+    g_gameContext->delta =
+        std::chrono::duration_cast<std::chrono::milliseconds>(fsec{g_gameContext->input.frameTime});
+    const auto mousePos = g_gameContext->input.mousePosition;
+    g_gameContext->mouse = {.x = mousePos.x, .y = mousePos.y, .width = 8, .height = 8};
+    UpdateLevelPrefetch(g_gameContext->levelPrefetch);
+    if (g_levelWatcher != nullptr)
+    {
+        TakeReloadedLevels(*g_levelWatcher, g_reloadedLevels);
+        for (auto& [level, levelFile] : g_reloadedLevels)
+        {
+            ReloadLevel(*g_gameContext, level, std::move(levelFile));
+        }
+    }
     switch (g_gameContext->state)
     {
+        case GameState::Loading:
+            if (IsAssetReady(*g_assetLoader, g_atlasAssetId))
+            {
+                g_gameContext->state = GameState::Start;
+            }
+            break;
         case GameState::Start: UpdateStartScene(*g_gameContext); break;
         case GameState::NodesMain: UpdateMainSceneNodes(*g_gameContext); break;
         case GameState::CharacterMain: UpdateMainSceneMap(*g_gameContext); break;
@@ -146,22 +231,33 @@ void UpdateGameLogic()
     if (g_gameContext->state == GameState::NodesMain || g_gameContext->state == GameState::CharacterMain)
     {
         // help icon
-        if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) && CheckCollisionRecs(Help1IconArea, g_gameContext->mouse))
+        if (IsFrameMouseButtonPressed(g_gameContext->input, MOUSE_BUTTON_LEFT) &&
+            CheckCollisionRecs(Help1IconArea, g_gameContext->mouse))
         {
             g_gameContext->showHelp1 = !g_gameContext->showHelp1;
         }
         // guide line icon
-        if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) && CheckCollisionRecs(Help2IconArea, g_gameContext->mouse))
+        if (IsFrameMouseButtonPressed(g_gameContext->input, MOUSE_BUTTON_LEFT) &&
+            CheckCollisionRecs(Help2IconArea, g_gameContext->mouse))
         {
             g_gameContext->showHelp2 = !g_gameContext->showHelp2;
             g_gameContext->manuelHelp = true;
         }
     }
 
-    // dev tools (debug)
+    // dev tools
 #if !defined(PLATFORM_WEB)
+    // level design (--level-dir only, the editor saves into the level directory)
+    if (g_levelWatcher != nullptr && IsFrameKeyPressed(g_gameContext->input, KEY_F5))
+    {
+        ToggleNodeEditor(*g_gameContext);
+    }
+    if (g_levelWatcher != nullptr && IsFrameKeyPressed(g_gameContext->input, KEY_F6))
+    {
+        ToggleNodeSandbox(*g_gameContext);
+    }
 #ifndef NDEBUG
-    if (IsKeyPressed(KEY_F3))
+    if (IsFrameKeyPressed(g_gameContext->input, KEY_F3))
     {
         NextLevel(*g_gameContext);
     }
@@ -169,28 +265,32 @@ void UpdateGameLogic()
 #endif
 }
 
-// Update and draw frame
-void UpdateDrawFrame()
+void RecordFrame()
 {
     assert(g_gameContext != nullptr);
-    auto mousePos = GetMousePosition();
-    g_gameContext->mouse = {.x = mousePos.x, .y = mousePos.y, .width = 8, .height = 8};
-
-    // Update
-    UpdateGameLogic();
-
-    // Draw
-    //----------------------------------------------------------------------------------
-    // Render to screen (main framebuffer)
-    BeginDrawing();
-    ClearBackground(BackgroundColor);
+    BeginRenderQueue(g_gameContext->renderQueue);
 
     // borders
-    DrawRectangleLinesEx(ConnectorArea, WindowBorderLineThick, BorderColor);
-    DrawRectangleLinesEx(LevelArea, WindowBorderLineThick, BorderColor);
+    QueueRectangleLinesEx(
+        g_gameContext->renderQueue,
+        RenderLayer::Background,
+        ConnectorArea,
+        WindowBorderLineThick,
+        BorderColor);
+    QueueRectangleLinesEx(
+        g_gameContext->renderQueue,
+        RenderLayer::Background,
+        LevelArea,
+        WindowBorderLineThick,
+        BorderColor);
 
+    // render loading screen
+    if (g_gameContext->state == GameState::Loading)
+    {
+        RenderLoadingScene(*g_gameContext);
+    }
     // render start scene
-    if (g_gameContext->state == GameState::Start)
+    else if (g_gameContext->state == GameState::Start)
     {
         RenderStartScene(*g_gameContext);
     }
@@ -204,7 +304,92 @@ void UpdateDrawFrame()
     {
         RenderEndScene(*g_gameContext);
     }
+}
+
+static void drawDevTools([[maybe_unused]] const RenderQueueStats& stats)
+{
+    // dev tools (debug)
+#if !defined(PLATFORM_WEB)
+#ifndef NDEBUG
+    if (IsFrameKeyDown(g_frameInput, KEY_F4))
+    {
+        // @NOTE: no TextFormat, the logic thread may use it at the same time
+        std::array<char, 128> text{};
+        snprintf(
+            text.data(),
+            text.size(),
+            "draws: %d, batches: %d (unsorted: %d)",
+            stats.commands,
+            stats.batchFlushes,
+            stats.unsortedBatchFlushes);
+        DrawText(text.data(), 8, 8, 10, RED);
+        if (g_logicThread != nullptr)
+        {
+            snprintf(
+                text.data(),
+                text.size(),
+                "logic ticks: %llu, repeated frames: %llu",
+                static_cast<unsigned long long>(g_logicThread->ticks.load()),
+                static_cast<unsigned long long>(g_logicThread->repeatedFrames));
+            DrawText(text.data(), 8, 20, 10, RED);
+        }
+    }
+#endif
+#endif
+}
+
+// Update and draw frame
+void UpdateDrawFrame()
+{
+    assert(g_gameContext != nullptr);
+    PollFrameInput(g_frameInput);
+
+    // game logic on its own thread, draw the newest frame it has published
+    if (g_logicThread != nullptr)
+    {
+        SubmitLogicInput(*g_logicThread, g_frameInput);
+        RenderQueue& frame = TakeLogicFrame(*g_logicThread);
+        BeginDrawing();
+        ClearBackground(BackgroundColor);
+        FlushRenderQueue(frame, true);
+        drawDevTools(frame.stats);
+        EndDrawing();
+        return;
+    }
+
+    // Update
+    g_assetsLoaded = UpdateAssetLoader(*g_assetLoader);
+    g_gameContext->input = g_frameInput;
+    UpdateGameLogic();
+
+    // Draw
+    //----------------------------------------------------------------------------------
+    // Render to screen (main framebuffer)
+    BeginDrawing();
+    ClearBackground(BackgroundColor);
+    RecordFrame();
+
+    // draw everything sorted by layer and texture (less batch breaks)
+    FlushRenderQueue(g_gameContext->renderQueue);
+    drawDevTools(g_gameContext->renderQueue.stats);
 
     EndDrawing();
     //----------------------------------------------------------------------------------
+
+#if !defined(PLATFORM_WEB)
+    // the textures are uploaded, from now on the logic thread updates the game
+    if (g_useLogicThread && g_assetsLoaded && g_gameContext->state != GameState::Loading)
+    {
+        g_logicThread = std::make_unique<LogicThread>();
+        StartLogicThread(
+            *g_logicThread,
+            g_gameContext->renderQueue,
+            [](const FrameInput& input)
+            {
+                g_gameContext->input = input;
+                UpdateGameLogic();
+                RecordFrame();
+            });
+    }
+#endif
 }
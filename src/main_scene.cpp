@@ -1,53 +1,62 @@
 #include "constants.h"
 #include "game.h"
+#include "geometry.h"
+#include "spatial_grid.h"
+#include "tile_map.h"
 #include "types.h"
 #include <raylib.h>
 #include <raymath.h>
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <utility>
 
 
 // pre define internal functions
-[[nodiscard]] static bool
-validPreConnections(GameContext& gameContext, ConnectorNode* clicked_node, ConnectorNode* other_node);
-[[nodiscard]] static bool validConnection(GameContext& gameContext, int node_selected1, int node_selected2);
-[[nodiscard]] static bool validPostConnections(GameContext& gameContext, int node_selected1, int node_selected2);
+/// add the connection (both directions), false when a node has no free connection
 static bool linkNodes(GameContext& gameContext, int node_selected1, int node_selected2);
 static void unlinkNode(GameContext& gameContext, ConnectorNode& node);
+/// nodes (center) in this area can collide with the mouse
+static Rectangle pickArea(Rectangle mouse)
+{
+    return {
+        mouse.x - MaxNodeRadius,
+        mouse.y - MaxNodeRadius,
+        mouse.width + 2 * MaxNodeRadius,
+        mouse.height + 2 * MaxNodeRadius};
+}
 
 void UpdateMainSceneNodes(GameContext& gameContext)
 {
     // update timer
     using fsec = std::chrono::duration<float>;
-    const auto endTime = std::chrono::duration_cast<std::chrono::milliseconds>(fsec{GetTime()});
+    const auto endTime = std::chrono::duration_cast<std::chrono::milliseconds>(fsec{gameContext.input.time});
     gameContext.timer = endTime - gameContext.startTime;
 
+    // level design, no connections and no GO while editing
+    if (gameContext.editorMode)
+    {
+        UpdateNodeEditorScene(gameContext);
+        return;
+    }
+
     // Connector Area
-    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
+    if (IsFrameMouseButtonPressed(gameContext.input, MOUSE_BUTTON_LEFT))
     {
-        const auto mouse = GetMousePosition();
-        ConnectorNode* nodeClicked = nullptr;
-        ConnectorNode* otherNode = nullptr;
-        for (auto& node : gameContext.nodes)
-        {
-            if (node.data.type != ConnectorType::DISABLED)
+        const auto mouse = gameContext.input.mousePosition;
+        // only the nodes near the mouse (nodeGrid)
+        QuerySpatialGridRect(
+            gameContext.nodeGrid,
+            pickArea(gameContext.mouse),
+            [&](uint32_t index)
             {
-                const auto radius = [&]()
-                {
-                    switch (node.data.type)
-                    {
-                        case ConnectorType::DISABLED: break;
-                        case ConnectorType::Action: return ActionNodeRadius;
-                        case ConnectorType::Key: return KeyNodeRadius;
-                    }
-                    return 0;
-                }();
-                if (CheckCollisionCircleRec(node.data.position, radius, gameContext.mouse))
+                auto& node = gameContext.nodes[index];
+                if (CheckCollisionCircleRec(node.data.position, geometry::NodeRadius(node.data), gameContext.mouse))
                 {
                     node.is_selected = true;
-                    nodeClicked = &node;
                 }
-            }
-        }
+                return false;
+            });
         int node_selected1 = -1;
         int node_selected2 = -1;
         for (size_t i = 0; i < gameContext.nodes.size(); ++i)
@@ -55,10 +64,6 @@ void UpdateMainSceneNodes(GameContext& gameContext)
             if (gameContext.nodes[i].is_selected)
             {
                 node_selected1 = i;
-                if (nodeClicked != &gameContext.nodes[i])
-                {
-                    otherNode = &gameContext.nodes[i];
-                }
                 break;
             }
         }
@@ -67,10 +72,6 @@ void UpdateMainSceneNodes(GameContext& gameContext)
             if (i != node_selected1 && gameContext.nodes[i].is_selected)
             {
                 node_selected2 = i;
-                if (nodeClicked != &gameContext.nodes[i])
-                {
-                    otherNode = &gameContext.nodes[i];
-                }
                 break;
             }
         }
@@ -78,37 +79,27 @@ void UpdateMainSceneNodes(GameContext& gameContext)
         if (node_selected1 != -1 && node_selected2 != -1)
         {
             UpdateAllNodes(gameContext);
-            if (validPreConnections(gameContext, otherNode, nodeClicked))
-            {
-                const auto rollback_nodes = gameContext.nodes;
-                linkNodes(gameContext, node_selected1, node_selected2);
-                UpdateAllNodes(gameContext);
-                // check after constrains
-                if (!validPostConnections(gameContext, node_selected1, node_selected2))
-                {
-                    // rollback to old state
-                    gameContext.nodes = rollback_nodes;
-                }
-            }
+            ConnectNodes(gameContext, node_selected1, node_selected2);
             gameContext.nodes[node_selected1].is_selected = false;
             gameContext.nodes[node_selected2].is_selected = false;
             gameContext.nodeSelectionMode = false;
         }
         UpdateAllNodes(gameContext);
     }
-    else if (IsMouseButtonPressed(MOUSE_BUTTON_RIGHT))
+    else if (IsFrameMouseButtonPressed(gameContext.input, MOUSE_BUTTON_RIGHT))
     {
-        for (size_t i = 0; i < gameContext.nodes.size(); ++i)
-        {
-            auto& node = gameContext.nodes[i];
-            if (node.data.type != ConnectorType::DISABLED)
+        QuerySpatialGridRect(
+            gameContext.nodeGrid,
+            pickArea(gameContext.mouse),
+            [&](uint32_t index)
             {
+                auto& node = gameContext.nodes[index];
                 if (CheckCollisionCircleRec(node.data.position, 16, gameContext.mouse))
                 {
                     unlinkNode(gameContext, node);
                 }
-            }
-        }
+                return false;
+            });
 
         // deselect all nodes
         for (auto& node : gameContext.nodes)
@@ -120,8 +111,9 @@ void UpdateMainSceneNodes(GameContext& gameContext)
         UpdateAllNodes(gameContext);
     }
 
-    if ((IsMouseButtonPressed(MOUSE_BUTTON_LEFT) && CheckCollisionRecs(GoButtonRect, gameContext.mouse)) ||
-        IsKeyPressed(KEY_ENTER))
+    if ((IsFrameMouseButtonPressed(gameContext.input, MOUSE_BUTTON_LEFT) &&
+         CheckCollisionRecs(GoButtonRect, gameContext.mouse)) ||
+        IsFrameKeyPressed(gameContext.input, KEY_ENTER))
     {
         gameContext.state = GameState::CharacterMain;
         gameContext.leftHelperText = TextFormat(LeftHelperCharacterTextFormat);
@@ -140,7 +132,7 @@ void UpdateMainSceneMap(GameContext& gameContext)
     {
         for (const auto& [key, actions] : gameContext.keyBinds)
         {
-            if (gameContext.playerActionIndex == -1 && IsKeyPressed(static_cast<int>(key)))
+            if (gameContext.playerActionIndex == -1 && IsFrameKeyPressed(gameContext.input, static_cast<int>(key)))
             {
                 gameContext.playerCurrentKey = key;
                 gameContext.playerActionIndex = 0;
@@ -155,35 +147,10 @@ void UpdateMainSceneMap(GameContext& gameContext)
         {
             if (gameContext.playerActionIndex < gameContext.keyBinds[gameContext.playerCurrentKey].size())
             {
-                switch (gameContext.keyBinds[gameContext.playerCurrentKey][gameContext.playerActionIndex])
-                {
-                    case ConnectorAction::NONE: break;
-                    case ConnectorAction::MovementLeft:
-                        gameContext.playerTilesPosition.x -= 1;
-                        gameContext.playerDirection = CharacterDirection::Left;
-                        break;
-                    case ConnectorAction::MovementRight:
-                        gameContext.playerTilesPosition.x += 1;
-                        gameContext.playerDirection = CharacterDirection::Right;
-                        break;
-                    case ConnectorAction::MovementUp:
-                        gameContext.playerTilesPosition.y -= 1;
-                        gameContext.playerDirection = CharacterDirection::Up;
-                        break;
-                    case ConnectorAction::MovementDown:
-                        gameContext.playerTilesPosition.y += 1;
-                        gameContext.playerDirection = CharacterDirection::Down;
-                        break;
-                    case ConnectorAction::Jump:
-                        switch (gameContext.playerDirection)
-                        {
-                            case CharacterDirection::Right: gameContext.playerTilesPosition.x += JumpFactor; break;
-                            case CharacterDirection::Left: gameContext.playerTilesPosition.x -= JumpFactor; break;
-                            case CharacterDirection::Up: gameContext.playerTilesPosition.y -= JumpFactor; break;
-                            case CharacterDirection::Down: gameContext.playerTilesPosition.y += JumpFactor; break;
-                        }
-                        break;
-                }
+                MoveTile(
+                    gameContext.playerTilesPosition,
+                    gameContext.playerDirection,
+                    gameContext.keyBinds[gameContext.playerCurrentKey][gameContext.playerActionIndex]);
             }
             gameContext.playerActionIndex++;
             gameContext.turnCooldown = TurnCooldown;
@@ -195,23 +162,11 @@ void UpdateMainSceneMap(GameContext& gameContext)
     }
 
     // check map conditions
-    if (gameContext.mapData != nullptr)
+    if (gameContext.map.width > 0)
     {
-        const auto* playerMapTileIndex = [&]() -> const int*
-        {
-            if (gameContext.mapData != nullptr &&
-                (gameContext.playerTilesPosition.x >= 0 && gameContext.playerTilesPosition.y >= 0 &&
-                 gameContext.playerTilesPosition.y < gameContext.mapData->size() &&
-                 gameContext.playerTilesPosition.x < (*gameContext.mapData)[gameContext.playerTilesPosition.y].size()))
-            {
-                return &(*gameContext.mapData)[gameContext.playerTilesPosition.y][gameContext.playerTilesPosition.x];
-            }
-            return nullptr;
-        }();
-        const auto playerMapTile =
-            (playerMapTileIndex != nullptr) ? static_cast<TileSet>(*playerMapTileIndex) : TileSet::Void1;
-        gameContext.playerOnVoidTile = playerMapTile == TileSet::Void1 || playerMapTile == TileSet::Void2;
-        gameContext.playerOnDoorTile = playerMapTile == TileSet::Door;
+        // outside of the map is void
+        gameContext.playerOnVoidTile = IsVoidAt(gameContext.map, gameContext.playerTilesPosition);
+        gameContext.playerOnDoorTile = IsDoorAt(gameContext.map, gameContext.playerTilesPosition);
 
         // reset action (animation)
         if (gameContext.playerCurrentKey != ConnectorKey::NONE &&
@@ -232,15 +187,14 @@ void UpdateMainSceneMap(GameContext& gameContext)
 
         if (gameContext.turnCooldown <= std::chrono::milliseconds::zero())
         {
-            switch (playerMapTile)
+            /// @TODO: collect key (TileSet::Key)
+            if (gameContext.playerOnDoorTile)
             {
-                case TileSet::Floor: break;
-                case TileSet::Door: NextLevel(gameContext); break;
-                case TileSet::Key:
-                    /// @TODO: collect key
-                    break;
-                case TileSet::Void1:
-                case TileSet::Void2: playerDie(gameContext); break;
+                NextLevel(gameContext);
+            }
+            else if (gameContext.playerOnVoidTile)
+            {
+                playerDie(gameContext);
             }
         }
 
@@ -250,14 +204,15 @@ void UpdateMainSceneMap(GameContext& gameContext)
     }
 
     // reset button
-    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) && CheckCollisionRecs(ResetButtonRect, gameContext.mouse))
+    if (IsFrameMouseButtonPressed(gameContext.input, MOUSE_BUTTON_LEFT) &&
+        CheckCollisionRecs(ResetButtonRect, gameContext.mouse))
     {
         gameContext.state = GameState::NodesMain;
         playerReset(gameContext);
         UpdateAllNodes(gameContext);
         return;
     }
-    if (IsKeyPressed(KEY_BACKSPACE))
+    if (IsFrameKeyPressed(gameContext.input, KEY_BACKSPACE))
     {
         playerReset(gameContext);
         gameContext.state = GameState::CharacterMain;
@@ -270,31 +225,71 @@ void UpdateMainSceneMap(GameContext& gameContext)
 static void renderNodeLines(GameContext& gameContext, const ConnectorNode& node);
 static void renderNode(GameContext& gameContext, const ConnectorNode& node);
 static void renderMap(GameContext& gameContext);
+/// preview lines of a key, only writes preview (job system)
+static void updateKeyPreview(const GameContext& gameContext, Rectangle character_pos, KeyPreview& preview);
 void RenderMainScene(GameContext& gameContext)
 {
-    DrawRectangleLinesEx(LeftTextArea, BorderLineThick, BorderColor);
-    DrawRectangleLinesEx(RightTextArea, BorderLineThick, BorderColor);
+    QueueRectangleLinesEx(gameContext.renderQueue, RenderLayer::Background, LeftTextArea, BorderLineThick, BorderColor);
+    QueueRectangleLinesEx(
+        gameContext.renderQueue,
+        RenderLayer::Background,
+        RightTextArea,
+        BorderLineThick,
+        BorderColor);
 
-    for (const auto& node : gameContext.nodes)
+    if (gameContext.editorMode)
     {
-        renderNodeLines(gameContext, node);
+        RenderNodeEditorScene(gameContext);
+    }
+    else
+    {
+        for (const auto& node : gameContext.nodes)
+        {
+            renderNodeLines(gameContext, node);
+        }
     }
     // pre-view line
     if (gameContext.nodeSelectionMode && CheckCollisionRecs(ConnectorArea, gameContext.mouse))
     {
-        const auto mousePos = GetMousePosition();
+        const auto mousePos = gameContext.input.mousePosition;
         for (const auto& node : gameContext.nodes)
         {
             if (node.is_selected)
             {
-                DrawLineEx(node.data.position, mousePos, BorderLineThick, DisabledColor);
+                QueueLineEx(
+                    gameContext.renderQueue,
+                    RenderLayer::NodeLines,
+                    node.data.position,
+                    mousePos,
+                    BorderLineThick,
+                    DisabledColor);
             }
         }
     }
 
-    for (const auto& node : gameContext.nodes)
+    if (gameContext.sandboxMode)
     {
-        renderNode(gameContext, node);
+        // nodes of the sandbox graph instead of the level nodes
+        const auto& editor = gameContext.nodeEditor;
+        ConnectorNode sandboxNode;
+        for (uint32_t i = 0; i < editor.pool.nodes.size(); ++i)
+        {
+            const auto& poolNode = editor.pool.nodes[i];
+            if (poolNode.alive)
+            {
+                sandboxNode.index = static_cast<int>(i);
+                sandboxNode.data = poolNode.data;
+                sandboxNode.is_selected = editor.linkNode == NodeHandle{i, poolNode.generation};
+                renderNode(gameContext, sandboxNode);
+            }
+        }
+    }
+    else
+    {
+        for (const auto& node : gameContext.nodes)
+        {
+            renderNode(gameContext, node);
+        }
     }
 
     // level text
@@ -303,7 +298,9 @@ void RenderMainScene(GameContext& gameContext)
         gameContext.levelHelperText.c_str(),
         LevelHelperTextFontSize,
         LevelHelperTextFontSize / FontSpacingFactor);
-    DrawTextEx(
+    QueueTextEx(
+        gameContext.renderQueue,
+        RenderLayer::Ui,
         gameContext.font,
         gameContext.levelHelperText.c_str(),
         {LevelArea.x + LevelArea.width / 2 - startButtonTextSize.x / 2, LevelArea.y + 8},
@@ -312,7 +309,9 @@ void RenderMainScene(GameContext& gameContext)
         TextFontColor);
 
     // helper text (connections, node info)
-    DrawTextEx(
+    QueueTextEx(
+        gameContext.renderQueue,
+        RenderLayer::Ui,
         gameContext.font,
         gameContext.leftHelperText.c_str(),
         {LeftTextArea.x + 8, LeftTextArea.y + 8},
@@ -329,8 +328,10 @@ void RenderMainScene(GameContext& gameContext)
             StartButtonTextFontSize,
             StartButtonTextFontSize / FontSpacingFactor);
         const auto buttonColor = (CheckCollisionRecs(GoButtonRect, gameContext.mouse)) ? ButtonHoverColor : ButtonColor;
-        DrawRectangleLinesEx(GoButtonRect, ButtonLineThick, buttonColor);
-        DrawTextEx(
+        QueueRectangleLinesEx(gameContext.renderQueue, RenderLayer::Ui, GoButtonRect, ButtonLineThick, buttonColor);
+        QueueTextEx(
+            gameContext.renderQueue,
+            RenderLayer::Ui,
             gameContext.font,
             GoButtonText,
             {GoButtonRect.x + GoButtonRect.width / 2 - goButtonTextSize.x / 2,
@@ -349,8 +350,10 @@ void RenderMainScene(GameContext& gameContext)
             StartButtonTextFontSize / FontSpacingFactor);
         const auto buttonColor =
             (CheckCollisionRecs(ResetButtonRect, gameContext.mouse)) ? ButtonHoverColor : ButtonColor;
-        DrawRectangleLinesEx(ResetButtonRect, ButtonLineThick, buttonColor);
-        DrawTextEx(
+        QueueRectangleLinesEx(gameContext.renderQueue, RenderLayer::Ui, ResetButtonRect, ButtonLineThick, buttonColor);
+        QueueTextEx(
+            gameContext.renderQueue,
+            RenderLayer::Ui,
             gameContext.font,
             RestartButtonText,
             {ResetButtonRect.x + ResetButtonRect.width / 2 - restartButtonTextSize.x / 2,
@@ -361,7 +364,9 @@ void RenderMainScene(GameContext& gameContext)
     }
 
     // helper text (actions, key binds)
-    DrawTextEx(
+    QueueTextEx(
+        gameContext.renderQueue,
+        RenderLayer::Ui,
         gameContext.font,
         gameContext.rightHelperText.c_str(),
         {RightHelperTextAreaRect.x, RightHelperTextAreaRect.y},
@@ -373,15 +378,19 @@ void RenderMainScene(GameContext& gameContext)
 
     if (gameContext.showHelp1)
     {
-        DrawTexture(
-            gameContext.instruction1Texture,
-            InGameHelpInstruction1Area.x,
-            InGameHelpInstruction1Area.y,
+        QueueTextureRec(
+            gameContext.renderQueue,
+            RenderLayer::Help,
+            gameContext.atlasTexture,
+            AtlasInstruction1Rect,
+            {InGameHelpInstruction1Area.x, InGameHelpInstruction1Area.y},
             NeutralTintColor);
-        DrawTexture(
-            gameContext.instruction2Texture,
-            InGameHelpInstruction2Area.x,
-            InGameHelpInstruction2Area.y,
+        QueueTextureRec(
+            gameContext.renderQueue,
+            RenderLayer::Help,
+            gameContext.atlasTexture,
+            AtlasInstruction2Rect,
+            {InGameHelpInstruction2Area.x, InGameHelpInstruction2Area.y},
             NeutralTintColor);
 
         // guidelines help icon
@@ -390,7 +399,9 @@ void RenderMainScene(GameContext& gameContext)
             Help3TipString,
             SmallHelperTextFontSize,
             SmallHelperTextFontSize / FontSpacingFactor);
-        DrawTextEx(
+        QueueTextEx(
+            gameContext.renderQueue,
+            RenderLayer::Help,
             gameContext.font,
             Help3TipString,
             {Help3Area.x, Help3Area.y + Help3Area.height / 2 - help3TextSize.y / 2},
@@ -399,9 +410,11 @@ void RenderMainScene(GameContext& gameContext)
             TextFontColor);
 
         // controls
-        DrawRectangleRec(Help4Area, BackgroundColor);
-        DrawRectangleLinesEx(Help4Area, BorderLineThick, BorderColor);
-        DrawTextEx(
+        QueueRectangleRec(gameContext.renderQueue, RenderLayer::HelpBackground, Help4Area, BackgroundColor);
+        QueueRectangleLinesEx(gameContext.renderQueue, RenderLayer::Help, Help4Area, BorderLineThick, BorderColor);
+        QueueTextEx(
+            gameContext.renderQueue,
+            RenderLayer::Help,
             gameContext.font,
             Help4TipString,
             {Help4Area.x + 7, Help4Area.y + 4},
@@ -409,12 +422,15 @@ void RenderMainScene(GameContext& gameContext)
             SmallHelperTextFontSize / FontSpacingFactor,
             TextFontColor);
         //// controls icons
-        DrawTexturePro(
-            gameContext.iconsControlSpriteSheetTexture,
-            {static_cast<int>(ControlIcons::LMB) * ControlIconSpriteWidth,
-             0,
-             ControlIconSpriteWidth,
-             ControlIconSpriteHeight},
+        QueueTexturePro(
+            gameContext.renderQueue,
+            RenderLayer::Help,
+            gameContext.atlasTexture,
+            SpriteSheetRect(
+                AtlasIconsControlRect,
+                static_cast<int>(ControlIcons::LMB),
+                ControlIconSpriteWidth,
+                ControlIconSpriteHeight),
             {Help4Area.x + 4,
              Help4Area.y + 4 + 2 * SmallHelperTextFontSize + 3,
              ControlIconSpriteWidth,
@@ -422,12 +438,15 @@ void RenderMainScene(GameContext& gameContext)
             {0, 0},
             0,
             NeutralTintColor);
-        DrawTexturePro(
-            gameContext.iconsControlSpriteSheetTexture,
-            {static_cast<int>(ControlIcons::RMB) * ControlIconSpriteWidth,
-             0,
-             ControlIconSpriteWidth,
-             ControlIconSpriteHeight},
+        QueueTexturePro(
+            gameContext.renderQueue,
+            RenderLayer::Help,
+            gameContext.atlasTexture,
+            SpriteSheetRect(
+                AtlasIconsControlRect,
+                static_cast<int>(ControlIcons::RMB),
+                ControlIconSpriteWidth,
+                ControlIconSpriteHeight),
             {Help4Area.x + 4,
              Help4Area.y + 4 + 3 * SmallHelperTextFontSize + 5,
              ControlIconSpriteWidth,
@@ -435,12 +454,15 @@ void RenderMainScene(GameContext& gameContext)
             {0, 0},
             0,
             NeutralTintColor);
-        DrawTexturePro(
-            gameContext.iconsControlSpriteSheetTexture,
-            {static_cast<int>(ControlIcons::Enter) * ControlIconSpriteWidth,
-             0,
-             ControlIconSpriteWidth,
-             ControlIconSpriteHeight},
+        QueueTexturePro(
+            gameContext.renderQueue,
+            RenderLayer::Help,
+            gameContext.atlasTexture,
+            SpriteSheetRect(
+                AtlasIconsControlRect,
+                static_cast<int>(ControlIcons::Enter),
+                ControlIconSpriteWidth,
+                ControlIconSpriteHeight),
             {Help4Area.x + 4,
              Help4Area.y + 4 + 4 * SmallHelperTextFontSize + 8,
              ControlIconSpriteWidth,
@@ -448,12 +470,15 @@ void RenderMainScene(GameContext& gameContext)
             {0, 0},
             0,
             NeutralTintColor);
-        DrawTexturePro(
-            gameContext.iconsControlSpriteSheetTexture,
-            {static_cast<int>(ControlIcons::Backspace) * ControlIconSpriteWidth,
-             0,
-             ControlIconSpriteWidth,
-             ControlIconSpriteHeight},
+        QueueTexturePro(
+            gameContext.renderQueue,
+            RenderLayer::Help,
+            gameContext.atlasTexture,
+            SpriteSheetRect(
+                AtlasIconsControlRect,
+                static_cast<int>(ControlIcons::Backspace),
+                ControlIconSpriteWidth,
+                ControlIconSpriteHeight),
             {Help4Area.x + 4,
              Help4Area.y + 4 + 5 * SmallHelperTextFontSize + 10,
              ControlIconSpriteWidth,
@@ -464,9 +489,11 @@ void RenderMainScene(GameContext& gameContext)
 
 
         // Tips
-        DrawRectangleRec(Help5Area, BackgroundColor);
-        DrawRectangleLinesEx(Help5Area, BorderLineThick, BorderColor);
-        DrawTextEx(
+        QueueRectangleRec(gameContext.renderQueue, RenderLayer::HelpBackground, Help5Area, BackgroundColor);
+        QueueRectangleLinesEx(gameContext.renderQueue, RenderLayer::Help, Help5Area, BorderLineThick, BorderColor);
+        QueueTextEx(
+            gameContext.renderQueue,
+            RenderLayer::Help,
             gameContext.font,
             Help5TipString,
             {Help5Area.x + 4, Help5Area.y + 4},
@@ -493,13 +520,25 @@ void RenderMainScene(GameContext& gameContext)
             Help1IconArea.y + Help1IconArea.height / 2};
         if (gameContext.showHelp1)
         {
-            DrawCircle(icon_pos_center.x, icon_pos_center.y, HelpIconRadius, ButtonActiveColor);
+            QueueCircle(
+                gameContext.renderQueue,
+                RenderLayer::UiBackground,
+                icon_pos_center,
+                HelpIconRadius,
+                ButtonActiveColor);
         }
         else
         {
-            DrawCircleLines(icon_pos_center.x, icon_pos_center.y, HelpIconRadius, buttonColor);
+            QueueCircleLines(
+                gameContext.renderQueue,
+                RenderLayer::UiBackground,
+                icon_pos_center,
+                HelpIconRadius,
+                buttonColor);
         }
-        DrawTextEx(
+        QueueTextEx(
+            gameContext.renderQueue,
+            RenderLayer::Ui,
             gameContext.font,
             Help1IconString,
             {Help1IconArea.x + Help1IconArea.width / 2 - helpButtonTextSize.x / 2,
@@ -526,13 +565,25 @@ void RenderMainScene(GameContext& gameContext)
             Help2IconArea.y + Help2IconArea.height / 2};
         if (gameContext.showHelp2)
         {
-            DrawCircle(icon_pos_center.x, icon_pos_center.y, HelpIconRadius, ButtonActiveColor);
+            QueueCircle(
+                gameContext.renderQueue,
+                RenderLayer::UiBackground,
+                icon_pos_center,
+                HelpIconRadius,
+                ButtonActiveColor);
         }
         else
         {
-            DrawCircleLines(icon_pos_center.x, icon_pos_center.y, HelpIconRadius, buttonColor);
+            QueueCircleLines(
+                gameContext.renderQueue,
+                RenderLayer::UiBackground,
+                icon_pos_center,
+                HelpIconRadius,
+                buttonColor);
         }
-        DrawTextEx(
+        QueueTextEx(
+            gameContext.renderQueue,
+            RenderLayer::Ui,
             gameContext.font,
             Help2IconString,
             {Help2IconArea.x + Help2IconArea.width / 2 - helpButtonTextSize.x / 2,
@@ -546,256 +597,320 @@ void RenderMainScene(GameContext& gameContext)
 //
 // internal game logic
 //
-bool validPreConnections(GameContext& gameContext, ConnectorNode* clicked_node, ConnectorNode* other_node)
+//// connection rules (ConnectionRules), checked after the connection is added
+/// max connections (per level)
+static bool validConnectionCount(const GameContext& gameContext)
+{
+    return gameContext.levelConnections <= gameContext.levelMaxNodeConnections;
+}
+/// max actions (key bind)
+static bool validKeyBind(const GameContext& gameContext, const std::vector<ConnectorAction>& actions)
+{
+    return actions.size() <= gameContext.levelMaxActionsPerKey;
+}
+/// already connected key (in action), one key in action (line)
+static bool validActionKeys(const GameContext& gameContext, const ConnectorNode& node)
 {
-    if (clicked_node != nullptr && other_node != nullptr)
+    if (node.data.type != ConnectorType::Action)
     {
-        Vector2 startPos1 = other_node->data.position;
-        Vector2 endPos1 = clicked_node->data.position;
-        for (const auto& node : gameContext.nodes)
+        return true;
+    }
+    int countKeys = 0;
+    for (const auto& connectedNodeIndex : node.connected_nodes)
+    {
+        const auto& connectedNode = gameContext.nodes[connectedNodeIndex];
+        if (connectedNode.data.type == ConnectorType::Key)
         {
-            if (node.index != other_node->index && node.index != clicked_node->index)
-            {
-                for (const auto& connectedNodeIndex : node.direct_connections)
-                {
-                    if (connectedNodeIndex != -1 && connectedNodeIndex != other_node->index &&
-                        connectedNodeIndex != clicked_node->index)
-                    {
-                        const auto& connectedNode = gameContext.nodes[connectedNodeIndex];
-                        const Vector2 startPos2 = node.data.position;
-                        const Vector2 endPos2 = connectedNode.data.position;
-
-                        if (CheckCollisionLines(startPos1, endPos1, startPos2, endPos2, nullptr))
-                        {
-                            return false;
-                        }
-                    }
-                }
-            }
+            ++countKeys;
         }
-        return true;
     }
-    return false;
+    return countKeys <= gameContext.levelConnectionRules.maxKeysPerAction;
 }
-bool validConnection(GameContext& gameContext, int node_selected1, int node_selected2)
+/// direct connections (key)
+static bool validKeyDirectActions(const GameContext& gameContext, const ConnectorNode& node)
 {
-    if (node_selected1 != -1 && node_selected2 != -1)
+    if (node.data.type != ConnectorType::Key)
     {
-        const auto& node1 = gameContext.nodes[node_selected1];
-        const auto& node2 = gameContext.nodes[node_selected2];
-
-        TraceLog(LOG_DEBUG, "Node1: type: %d, connected_counter: %d", node1.data.type, node1.connected_counter);
-        TraceLog(LOG_DEBUG, "Node2: type: %d, connected_counter: %d", node2.data.type, node2.connected_counter);
-        TraceLog(
-            LOG_DEBUG,
-            "Level: level_connections: %d/%d ",
-            gameContext.levelConnections,
-            gameContext.levelMaxNodeConnections);
-
-        if (node1.data.type != node2.data.type ||
-            (node1.data.type == ConnectorType::Action && node2.data.type == ConnectorType::Action))
+        return true;
+    }
+    int countActions = 0;
+    for (const auto& directConnectedNodeIndex : node.direct_connections)
+    {
+        if (directConnectedNodeIndex != -1)
         {
-            if (node1.connected_counter >= MaxNodeConnections)
+            const auto& directConnectedNode = gameContext.nodes[directConnectedNodeIndex];
+            if (directConnectedNode.data.type == ConnectorType::Action)
             {
-                return false;
-            }
-            if (node2.connected_counter >= MaxNodeConnections)
-            {
-                return false;
+                ++countActions;
             }
+        }
+    }
+    return countActions <= gameContext.levelConnectionRules.maxDirectActionsPerKey;
+}
+/// nodes in between the connection (not selected nodes)
+static bool validNodesInBetween(const GameContext& gameContext, const ConnectorNode& node1, const ConnectorNode& node2)
+{
+    // only the nodes along the line (nodeGrid)
+    return !QuerySpatialGridSegment(
+        gameContext.nodeGrid,
+        node1.data.position,
+        node2.data.position,
+        MaxNodeRadius,
+        [&](uint32_t index)
+        {
+            const auto& otherNode = gameContext.nodes[index];
+            return otherNode.index != node1.index && otherNode.index != node2.index && !otherNode.is_selected &&
+                   geometry::CheckCollisionLineNode(node1.data.position, node2.data.position, otherNode.data);
+        });
+}
+/// connection crossing with nodes (only selected nodes)
+static bool validSelectedConnections(const GameContext& gameContext, const ConnectorNode& node1)
+{
+    if (!node1.is_selected)
+    {
+        return true;
+    }
+    for (const auto& node1ConnectedNodeIndex : node1.connected_nodes)
+    {
+        // skip self and is not selected nodes
+        const auto& node1ConnectedNode = gameContext.nodes[node1ConnectedNodeIndex];
+        if (node1.index == node1ConnectedNodeIndex || !node1ConnectedNode.is_selected)
+        {
+            continue;
+        }
 
-            // check nodes in between lines
-            for (const auto& otherNode : gameContext.nodes)
+        const bool nodeInBetween = QuerySpatialGridSegment(
+            gameContext.nodeGrid,
+            node1.data.position,
+            node1ConnectedNode.data.position,
+            MaxNodeRadius,
+            [&](uint32_t index)
             {
-                if ((otherNode.index != node1.index && otherNode.index != node2.index) && !otherNode.is_selected)
-                {
-                    const Vector2 startPos1 = node1.data.position;
-                    const Vector2 endPos1 = node2.data.position;
-
-                    const auto otherNodeSize = [&]()
-                    {
-                        switch (otherNode.data.type)
-                        {
-                            case ConnectorType::DISABLED: break;
-                            case ConnectorType::Action: return ActionNodeRadius;
-                            case ConnectorType::Key: return KeyNodeRadius;
-                        }
-                        return 0;
-                    }();
-                    const Vector2 topLeft = {
-                        otherNode.data.position.x - otherNodeSize / 2,
-                        otherNode.data.position.y - otherNodeSize / 2};
-                    const Vector2 topRight = {
-                        otherNode.data.position.x + otherNodeSize / 2,
-                        otherNode.data.position.y - otherNodeSize / 2};
-                    const Vector2 bottomLeft = {
-                        otherNode.data.position.x - otherNodeSize / 2,
-                        otherNode.data.position.y + otherNodeSize / 2};
-                    const Vector2 bottomRight = {
-                        otherNode.data.position.x + otherNodeSize / 2,
-                        otherNode.data.position.y + otherNodeSize / 2};
-
-                    // check lines with rectangle lines (for both action and key node)
-                    if (CheckCollisionLines(startPos1, endPos1, topLeft, topRight, nullptr) ||
-                        CheckCollisionLines(startPos1, endPos1, topRight, bottomRight, nullptr) ||
-                        CheckCollisionLines(startPos1, endPos1, bottomRight, bottomLeft, nullptr) ||
-                        CheckCollisionLines(startPos1, endPos1, bottomLeft, topLeft, nullptr))
-                    {
-                        return false;
-                    }
-                }
-            }
-
-            return true;
+                const auto& node2 = gameContext.nodes[index];
+                return node2.index != node1.index && node2.index != node1ConnectedNodeIndex && node2.is_selected &&
+                       geometry::CheckCollisionLineNode(
+                           node1.data.position, node1ConnectedNode.data.position, node2.data);
+            });
+        if (nodeInBetween)
+        {
+            return false;
         }
     }
-
-    return false;
+    return true;
 }
-bool validPostConnections(GameContext& gameContext, int node_selected1, int node_selected2)
+/// connections of the node don't cross the connection node1 - node2 (unless they share a node)
+static bool validCrossings(
+    const GameContext& gameContext, const ConnectorNode& node, const ConnectorNode& node1, const ConnectorNode& node2)
 {
-    // check max connections (per level)
-    if (gameContext.levelConnections > gameContext.levelMaxNodeConnections)
+    if (node.index == node1.index || node.index == node2.index)
     {
-        return false;
+        return true;
     }
+    for (const auto& connectedNodeIndex : node.direct_connections)
+    {
+        if (connectedNodeIndex != -1 && connectedNodeIndex != node1.index && connectedNodeIndex != node2.index &&
+            CheckCollisionLines(
+                node1.data.position,
+                node2.data.position,
+                node.data.position,
+                gameContext.nodes[connectedNodeIndex].data.position,
+                nullptr))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// all active rules (Rules, ConnectionRule flags) in one pass over the nodes, the rules are resolved at compile-time
+/// @NOTE: Full checks all nodes, otherwise only the nodes in the component of the connection
+///        (indirect connections and key binds only change there, the connections before were valid)
+template<uint8_t Rules, bool Full>
+static bool validateConnection(const GameContext& gameContext, int node_selected1, int node_selected2)
+{
+    const auto& node1 = gameContext.nodes[node_selected1];
+    const auto& node2 = gameContext.nodes[node_selected2];
 
-    // check max actions
-    for (const auto& [key, actions] : gameContext.keyBinds)
+    // the connection
+    if constexpr (HasConnectionRule(Rules, ConnectionRule::NodeTypes))
+    {
+        if (node1.data.type == node2.data.type && node1.data.type != ConnectorType::Action)
+        {
+            return false;
+        }
+    }
+    const int maxConnectionsPerNode = gameContext.levelConnectionRules.maxConnectionsPerNode;
+    if (node1.connected_counter > maxConnectionsPerNode || node2.connected_counter > maxConnectionsPerNode)
+    {
+        return false;
+    }
+    if constexpr (HasConnectionRule(Rules, ConnectionRule::NodesInBetween))
     {
-        if (actions.size() > gameContext.levelMaxActionsPerKey)
+        if (!validNodesInBetween(gameContext, node1, node2))
+        {
+            return false;
+        }
+    }
+    if constexpr (HasConnectionRule(Rules, ConnectionRule::LevelConnections))
+    {
+        if (!validConnectionCount(gameContext))
         {
             return false;
         }
     }
 
-    constexpr int MaxKeysPerAction = 1;
-    constexpr int MaxDirectActionPerKey = 1;
-    for (const auto& node : gameContext.nodes)
+    std::array<bool, MaxNodesInLevel> changed{};
+    if constexpr (Full)
     {
-        // check for already connected key (in action), one key in action (line)
-        if (node.data.type == ConnectorType::Action)
+        changed.fill(true);
+    }
+    else
+    {
+        std::array<int, MaxNodesInLevel> stack{};
+        int stackSize = 0;
+        changed[node_selected1] = true;
+        stack[stackSize++] = node_selected1;
+        if (!changed[node_selected2])
         {
-            int countKeys = 0;
-            for (const auto& connectedNodeIndex : node.connected_nodes)
+            changed[node_selected2] = true;
+            stack[stackSize++] = node_selected2;
+        }
+        while (stackSize > 0)
+        {
+            for (const auto& connectedNodeIndex : gameContext.nodes[stack[--stackSize]].direct_connections)
             {
-                const auto& connectedNode = gameContext.nodes[connectedNodeIndex];
-                if (connectedNode.data.type == ConnectorType::Key)
+                if (connectedNodeIndex != -1 && !changed[connectedNodeIndex])
                 {
-                    ++countKeys;
+                    changed[connectedNodeIndex] = true;
+                    stack[stackSize++] = connectedNodeIndex;
                 }
             }
-            if (countKeys > MaxKeysPerAction)
+        }
+    }
+
+    for (const auto& node : gameContext.nodes)
+    {
+        if constexpr (HasConnectionRule(Rules, ConnectionRule::Crossings))
+        {
+            if (!validCrossings(gameContext, node, node1, node2))
             {
                 return false;
             }
         }
-        // check direct connections
-        if (node.data.type == ConnectorType::Key)
+        if (!changed[node.index])
+        {
+            continue;
+        }
+        if constexpr (HasConnectionRule(Rules, ConnectionRule::ActionsPerKey))
         {
-            int countActions = 0;
-            for (const auto& directConnectedNodeIndex : node.direct_connections)
+            if (node.data.type == ConnectorType::Key)
             {
-                if (directConnectedNodeIndex != -1)
+                const auto keyBind = gameContext.keyBinds.find(node.data.key);
+                if (keyBind != gameContext.keyBinds.end() && !validKeyBind(gameContext, keyBind->second))
                 {
-                    const auto& directConnectedNode = gameContext.nodes[directConnectedNodeIndex];
-                    if (directConnectedNode.data.type == ConnectorType::Action)
-                    {
-                        ++countActions;
-                    }
+                    return false;
                 }
             }
-            if (countActions > MaxDirectActionPerKey)
+        }
+        if constexpr (HasConnectionRule(Rules, ConnectionRule::KeysPerAction))
+        {
+            if (!validActionKeys(gameContext, node))
             {
                 return false;
             }
         }
-    }
-
-    // check connection crossing with nodes
-    for (const auto& node1 : gameContext.nodes)
-    {
-        for (const auto& node1ConnectedNodeIndex : node1.connected_nodes)
+        if constexpr (HasConnectionRule(Rules, ConnectionRule::NodesInBetween))
         {
-            // skip self and is not selected nodes
-            if (node1.index == node1ConnectedNodeIndex || !node1.is_selected)
-            {
-                continue;
-            }
-
-            const auto& node1ConnectedNode = gameContext.nodes[node1ConnectedNodeIndex];
-            // check only selected nodes
-            if (!node1ConnectedNode.is_selected)
+            if (!validSelectedConnections(gameContext, node))
             {
-                continue;
+                return false;
             }
-
-            for (const auto& node2 : gameContext.nodes)
+        }
+        if constexpr (HasConnectionRule(Rules, ConnectionRule::DirectActionsPerKey))
+        {
+            // direct connections only changed on the nodes of the connection
+            if ((Full || node.index == node_selected1 || node.index == node_selected2) &&
+                !validKeyDirectActions(gameContext, node))
             {
-                if ((node2.index != node1.index && node2.index != node1ConnectedNodeIndex) && node2.is_selected)
-                {
-                    const Vector2 startPos1 = node1.data.position;
-                    const Vector2 endPos1 = node1ConnectedNode.data.position;
-
-                    const auto node2Size = [&]()
-                    {
-                        switch (node2.data.type)
-                        {
-                            case ConnectorType::DISABLED: break;
-                            case ConnectorType::Action: return ActionNodeRadius;
-                            case ConnectorType::Key: return KeyNodeRadius;
-                        }
-                        return 0;
-                    }();
-                    Vector2 topLeft = {node2.data.position.x - node2Size / 2, node2.data.position.y - node2Size / 2};
-                    Vector2 topRight = {node2.data.position.x + node2Size / 2, node2.data.position.y - node2Size / 2};
-                    Vector2 bottomLeft = {node2.data.position.x - node2Size / 2, node2.data.position.y + node2Size / 2};
-                    Vector2 bottomRight = {
-                        node2.data.position.x + node2Size / 2,
-                        node2.data.position.y + node2Size / 2};
-
-                    // check lines with rectangle lines (for both action and key node)
-                    if (CheckCollisionLines(startPos1, endPos1, topLeft, topRight, nullptr) ||
-                        CheckCollisionLines(startPos1, endPos1, topRight, bottomRight, nullptr) ||
-                        CheckCollisionLines(startPos1, endPos1, bottomRight, bottomLeft, nullptr) ||
-                        CheckCollisionLines(startPos1, endPos1, bottomLeft, topLeft, nullptr))
-                    {
-                        return false;
-                    }
-                }
+                return false;
             }
         }
     }
+    return true;
+}
+/// component of the connection, debug builds check it against all nodes
+template<uint8_t Rules>
+static bool checkedValidateConnection(const GameContext& gameContext, int node_selected1, int node_selected2)
+{
+    const bool valid = validateConnection<Rules, false>(gameContext, node_selected1, node_selected2);
+#ifndef NDEBUG
+    const bool fullValid = validateConnection<Rules, true>(gameContext, node_selected1, node_selected2);
+    if (valid != fullValid)
+    {
+        TraceLog(
+            LOG_WARNING,
+            "NODES: delta validation (%d) differs from full validation (%d), connection %d - %d",
+            valid,
+            fullValid,
+            node_selected1,
+            node_selected2);
+        return fullValid;
+    }
+#endif
+    return valid;
+}
+/// one validation per rule set (index: ConnectionRule flags)
+template<size_t... Rules>
+static constexpr std::array<ConnectionValidator, sizeof...(Rules)>
+makeConnectionValidators(std::index_sequence<Rules...>)
+{
+    return {&checkedValidateConnection<static_cast<uint8_t>(Rules)>...};
+}
+static constexpr auto ConnectionValidators =
+    makeConnectionValidators(std::make_index_sequence<AllConnectionRules + 1>{});
+ConnectionValidator GetConnectionValidator(const ConnectionRules& rules)
+{
+    return ConnectionValidators[rules.rules & AllConnectionRules];
+}
 
+bool ConnectNodes(GameContext& gameContext, int node1, int node2)
+{
+    const auto rollback_nodes = gameContext.nodes;
+    // check the rules of the level with the new connection
+    if (!linkNodes(gameContext, node1, node2) || !gameContext.validateConnection(gameContext, node1, node2))
+    {
+        // rollback to old state
+        gameContext.nodes = rollback_nodes;
+        UpdateAllNodes(gameContext);
+        return false;
+    }
     return true;
 }
 bool linkNodes(GameContext& gameContext, int node_selected1, int node_selected2)
 {
-    /// @TODO: validate connection
-    if (validConnection(gameContext, node_selected1, node_selected2))
+    bool linked1 = false;
+    bool linked2 = false;
+    for (auto& connectedNodeIndex : gameContext.nodes[node_selected1].direct_connections)
     {
-        for (auto& connectedNodeIndex : gameContext.nodes[node_selected1].direct_connections)
+        if (connectedNodeIndex == -1)
         {
-            if (connectedNodeIndex == -1)
-            {
-                connectedNodeIndex = node_selected2;
-                break;
-            }
+            connectedNodeIndex = node_selected2;
+            linked1 = true;
+            break;
         }
-        for (auto& connectedNodeIndex : gameContext.nodes[node_selected2].direct_connections)
+    }
+    for (auto& connectedNodeIndex : gameContext.nodes[node_selected2].direct_connections)
+    {
+        if (connectedNodeIndex == -1)
         {
-            if (connectedNodeIndex == -1)
-            {
-                connectedNodeIndex = node_selected1;
-                break;
-            }
+            connectedNodeIndex = node_selected1;
+            linked2 = true;
+            break;
         }
-
-        UpdateAllNodes(gameContext);
-        return true;
     }
 
-    return false;
+    UpdateAllNodes(gameContext);
+    return linked1 && linked2;
 }
 void unlinkNode(GameContext& gameContext, ConnectorNode& node)
 {
@@ -881,7 +996,13 @@ void renderNodeLines(GameContext& gameContext, const ConnectorNode& node)
         if (directConnectedNodeIndex != -1)
         {
             const auto& siblingConnected = gameContext.nodes[directConnectedNodeIndex];
-            DrawLineEx(node.data.position, siblingConnected.data.position, NodeLineThick, lineColor);
+            QueueLineEx(
+                gameContext.renderQueue,
+                RenderLayer::NodeLines,
+                node.data.position,
+                siblingConnected.data.position,
+                NodeLineThick,
+                lineColor);
         }
     }
 }
@@ -899,7 +1020,7 @@ void renderNode(GameContext& gameContext, const ConnectorNode& node)
             {
 #if !defined(PLATFORM_WEB)
 #ifndef NDEBUG
-                if (IsKeyDown(KEY_F1))
+                if (IsFrameKeyDown(gameContext.input, KEY_F1))
                 {
                     // debug
                     return TextFormat("%i", node.index);
@@ -922,14 +1043,34 @@ void renderNode(GameContext& gameContext, const ConnectorNode& node)
                 MeasureTextEx(gameContext.font, innerTextAction, NodeFontSize, NodeFontSize / FontSpacingFactor);
 
             // draw background color on overlapping line
-            DrawRing(node.data.position, 0, ActionNodeRadius, 0, 360, ActionNodeSides, BackgroundColor);
+            QueueRing(
+                gameContext.renderQueue,
+                RenderLayer::NodeBackground,
+                node.data.position,
+                0,
+                ActionNodeRadius,
+                0,
+                360,
+                ActionNodeSides,
+                BackgroundColor);
             if (node.is_selected)
             {
-                DrawRing(node.data.position, 0, ActionNodeRadius, 0, 360, ActionNodeSides, actionColor);
+                QueueRing(
+                    gameContext.renderQueue,
+                    RenderLayer::Nodes,
+                    node.data.position,
+                    0,
+                    ActionNodeRadius,
+                    0,
+                    360,
+                    ActionNodeSides,
+                    actionColor);
             }
             else
             {
-                DrawRing(
+                QueueRing(
+                    gameContext.renderQueue,
+                    RenderLayer::Nodes,
                     node.data.position,
                     ActionNodeRadius,
                     ActionNodeRadius - ActionNodeRadiusThick,
@@ -948,11 +1089,13 @@ void renderNode(GameContext& gameContext, const ConnectorNode& node)
                 case ConnectorAction::Jump:
 #if !defined(PLATFORM_WEB)
 #ifndef NDEBUG
-                    if (IsKeyDown(KEY_F1))
+                    if (IsFrameKeyDown(gameContext.input, KEY_F1))
                     {
                         if (node.is_selected)
                         {
-                            DrawTextEx(
+                            QueueTextEx(
+                                gameContext.renderQueue,
+                                RenderLayer::NodeLabels,
                                 gameContext.font,
                                 innerTextAction,
                                 {node.data.position.x - innerTextActionSize.x / 2,
@@ -963,7 +1106,9 @@ void renderNode(GameContext& gameContext, const ConnectorNode& node)
                         }
                         else
                         {
-                            DrawTextEx(
+                            QueueTextEx(
+                                gameContext.renderQueue,
+                                RenderLayer::NodeLabels,
                                 gameContext.font,
                                 innerTextAction,
                                 {node.data.position.x - innerTextActionSize.x / 2,
@@ -978,12 +1123,15 @@ void renderNode(GameContext& gameContext, const ConnectorNode& node)
 #endif
                     // Render Action Icon
                     auto iconColor = node.is_selected ? BackgroundColor : actionColor;
-                    DrawTexturePro(
-                        gameContext.iconsSpriteSheetTexture,
-                        {static_cast<float>(static_cast<int>(node.data.action) * ActionIconSpriteWidth),
-                         0,
-                         ActionIconSpriteWidth,
-                         ActionIconSpriteHeight},
+                    QueueTexturePro(
+                        gameContext.renderQueue,
+                        RenderLayer::NodeLabels,
+                        gameContext.atlasTexture,
+                        SpriteSheetRect(
+                            AtlasIconsRect,
+                            static_cast<int>(node.data.action),
+                            ActionIconSpriteWidth,
+                            ActionIconSpriteHeight),
                         {node.data.position.x, node.data.position.y, ActionIconSpriteWidth, ActionIconSpriteHeight},
                         {ActionIconSpriteWidth / 2, ActionIconSpriteHeight / 2},
                         0,
@@ -999,7 +1147,7 @@ void renderNode(GameContext& gameContext, const ConnectorNode& node)
             {
 #if !defined(PLATFORM_WEB)
 #ifndef NDEBUG
-                if (IsKeyDown(KEY_F1))
+                if (IsFrameKeyDown(gameContext.input, KEY_F1))
                 {
                     // debug
                     return TextFormat("%i", node.index);
@@ -1023,14 +1171,41 @@ void renderNode(GameContext& gameContext, const ConnectorNode& node)
                 MeasureTextEx(gameContext.font, innerTextKey, NodeFontSize, NodeFontSize / FontSpacingFactor);
 
             // draw background color on overlapping line
-            DrawRing(node.data.position, 0, KeyNodeRadius, 0, 360, 0, BackgroundColor);
+            QueueRing(
+                gameContext.renderQueue,
+                RenderLayer::NodeBackground,
+                node.data.position,
+                0,
+                KeyNodeRadius,
+                0,
+                360,
+                0,
+                BackgroundColor);
             if (node.is_selected)
             {
-                DrawRing(node.data.position, 0, KeyNodeRadius, 0, 360, 0, keyColor);
+                QueueRing(
+                    gameContext.renderQueue,
+                    RenderLayer::Nodes,
+                    node.data.position,
+                    0,
+                    KeyNodeRadius,
+                    0,
+                    360,
+                    0,
+                    keyColor);
             }
             else
             {
-                DrawRing(node.data.position, KeyNodeRadius, KeyNodeRadius - KeyNodeRadiusThick, 0, 360, 0, keyColor);
+                QueueRing(
+                    gameContext.renderQueue,
+                    RenderLayer::Nodes,
+                    node.data.position,
+                    KeyNodeRadius,
+                    KeyNodeRadius - KeyNodeRadiusThick,
+                    0,
+                    360,
+                    0,
+                    keyColor);
             }
             switch (node.data.key)
             {
@@ -1043,7 +1218,9 @@ void renderNode(GameContext& gameContext, const ConnectorNode& node)
                 case ConnectorKey::G:
                     if (node.is_selected)
                     {
-                        DrawTextEx(
+                        QueueTextEx(
+                            gameContext.renderQueue,
+                            RenderLayer::NodeLabels,
                             gameContext.font,
                             innerTextKey,
                             {node.data.position.x - innerTextKeySize.x / 2,
@@ -1054,7 +1231,9 @@ void renderNode(GameContext& gameContext, const ConnectorNode& node)
                     }
                     else
                     {
-                        DrawTextEx(
+                        QueueTextEx(
+                            gameContext.renderQueue,
+                            RenderLayer::NodeLabels,
                             gameContext.font,
                             innerTextKey,
                             {node.data.position.x - innerTextKeySize.x / 2,
@@ -1069,38 +1248,164 @@ void renderNode(GameContext& gameContext, const ConnectorNode& node)
         }
     }
 }
-void renderMap(GameContext& gameContext)
+void updateKeyPreview(const GameContext& gameContext, Rectangle character_pos, KeyPreview& preview)
 {
-    // Render Map
-    if (gameContext.mapData != nullptr)
+    preview.lines.clear();
+    TilePosition tile_position = gameContext.playerTilesPosition;
+    Vector2 startPosLine{
+        character_pos.x + character_pos.width / 2,
+        character_pos.y + character_pos.height / 2};
+    Vector2 endPosLine{
+        character_pos.x + character_pos.width / 2,
+        character_pos.y + character_pos.height / 2};
+    auto preview_direction = gameContext.playerDirection;
+
+    bool preview_on_void_tile = false;
+    const auto isTileVoid = [&](TilePosition tp) { return IsVoidAt(gameContext.map, tp); };
+
+    const auto movePosLineByAction = [&](Vector2& pos, TilePosition* tp, auto action)
     {
-        // render level
-        for (int y = 0; y < LevelMapHeight; y++)
+        switch (action)
+        {
+            case ConnectorAction::NONE: break;
+            case ConnectorAction::MovementRight:
+                pos.x += LevelTileWidth;
+                if (tp != nullptr) tp->x++;
+                preview_direction = CharacterDirection::Right;
+                return Vector2{1, 0};
+            case ConnectorAction::MovementLeft:
+                pos.x -= LevelTileWidth;
+                if (tp != nullptr) tp->x--;
+                preview_direction = CharacterDirection::Left;
+                return Vector2{-1, 0};
+            case ConnectorAction::MovementDown:
+                pos.y += LevelTileWidth;
+                if (tp != nullptr) tp->y++;
+                preview_direction = CharacterDirection::Down;
+                return Vector2{0, 1};
+            case ConnectorAction::MovementUp:
+                pos.y -= LevelTileWidth;
+                if (tp != nullptr) tp->y--;
+                preview_direction = CharacterDirection::Up;
+                return Vector2{0, .1};
+            case ConnectorAction::Jump:
+                switch (preview_direction)
+                {
+                    case CharacterDirection::Right:
+                        pos.x += JumpFactor * LevelTileWidth;
+                        if (tp != nullptr) tp->x += JumpFactor;
+                        preview_direction = CharacterDirection::Right;
+                        return Vector2{1, 0};
+                    case CharacterDirection::Left:
+                        pos.x -= JumpFactor * LevelTileWidth;
+                        if (tp != nullptr) tp->x -= JumpFactor;
+                        preview_direction = CharacterDirection::Left;
+                        return Vector2{-1, 0};
+                    case CharacterDirection::Up:
+                        pos.y -= JumpFactor * LevelTileWidth;
+                        if (tp != nullptr) tp->y -= JumpFactor;
+                        preview_direction = CharacterDirection::Up;
+                        return Vector2{0, -1};
+                    case CharacterDirection::Down:
+                        pos.y += JumpFactor * LevelTileWidth;
+                        if (tp != nullptr) tp->y += JumpFactor;
+                        preview_direction = CharacterDirection::Down;
+                        return Vector2{0, 1};
+                }
+                break;
+        }
+        return Vector2{1, 1};
+    };
+    Vector2 direction_vector{1, 1};
+    for (const auto& action : *preview.actions)
+    {
+        if (!preview_on_void_tile)
+        {
+            direction_vector = movePosLineByAction(endPosLine, &tile_position, action);
+            if (CheckCollisionPointRec(endPosLine, LevelMapArea))
+            {
+                preview.lines.emplace_back(startPosLine, endPosLine);
+            }
+            direction_vector = movePosLineByAction(startPosLine, nullptr, action);
+        }
+        else
         {
-            for (int x = 0; x < LevelMapWidth; x++)
+            direction_vector = movePosLineByAction(endPosLine, &tile_position, action);
+            // make dotted line
+            const auto max_step = Vector2Distance(startPosLine, endPosLine);
+            auto innerStartPosLine = startPosLine;
+            auto innerEndPosLine = Vector2MoveTowards(startPosLine, endPosLine, 2);
+            for (int step = 0; step < max_step && Vector2Distance(innerEndPosLine, endPosLine) > 0;
+                 step += 2 * PreviewLineThick)
             {
-                const auto& tile = (*gameContext.mapData)[y][x];
+                if (CheckCollisionPointRec(innerEndPosLine, LevelMapArea))
+                {
+                    preview.lines.emplace_back(innerStartPosLine, innerEndPosLine);
+                }
+                innerStartPosLine = Vector2MoveTowards(innerEndPosLine, endPosLine, PreviewLineThick);
+                innerEndPosLine = Vector2MoveTowards(innerStartPosLine, endPosLine, 2 * PreviewLineThick);
+            }
+            if (CheckCollisionPointRec(endPosLine, LevelMapArea))
+            {
+                preview.lines.emplace_back(innerEndPosLine, endPosLine);
+            }
+            direction_vector = movePosLineByAction(startPosLine, nullptr, action);
+        }
+        preview_on_void_tile = preview_on_void_tile || isTileVoid(tile_position);
+    }
 
-                float sx = tile * LevelTileWidth;
-                float sy = 0;
+    preview.textPosition = startPosLine;
+    preview.textDirection = direction_vector;
+}
 
-                float dx = LevelMapArea.x + x * LevelTileWidth;
-                float dy = LevelMapArea.y + y * LevelTileHeight;
+void renderMap(GameContext& gameContext)
+{
+    // Render Map
+    if (gameContext.map.width > 0)
+    {
+        // camera follows the player (large maps), only the visible chunks/tiles are rendered
+        const auto camera = FollowTileMapCamera(
+            gameContext.map, gameContext.playerTilesPosition.x, gameContext.playerTilesPosition.y);
+        const int viewEndX = std::min(camera.x + LevelViewWidth, gameContext.map.width);
+        const int viewEndY = std::min(camera.y + LevelViewHeight, gameContext.map.height);
 
-                DrawTexturePro(
-                    gameContext.tilesetTexture,
-                    {sx, sy, LevelTileWidth, LevelTileHeight},
-                    {dx, dy, LevelTileWidth, LevelTileHeight},
-                    {0, 0},
-                    0,
-                    NeutralTintColor);
+        // render level
+        for (int chunkY = camera.y / TileChunkSize; chunkY * TileChunkSize < viewEndY; chunkY++)
+        {
+            for (int chunkX = camera.x / TileChunkSize; chunkX * TileChunkSize < viewEndX; chunkX++)
+            {
+                const TileChunk* chunk = GetTileChunk(gameContext.map, chunkX, chunkY);
+                const int beginX = std::max(camera.x, chunkX * TileChunkSize);
+                const int beginY = std::max(camera.y, chunkY * TileChunkSize);
+                const int endX = std::min(viewEndX, (chunkX + 1) * TileChunkSize);
+                const int endY = std::min(viewEndY, (chunkY + 1) * TileChunkSize);
+                for (int y = beginY; y < endY; y++)
+                {
+                    for (int x = beginX; x < endX; x++)
+                    {
+                        const int tile = chunk->tiles[(y % TileChunkSize) * TileChunkSize + (x % TileChunkSize)];
+
+                        float dx = LevelMapArea.x + (x - camera.x) * LevelTileWidth;
+                        float dy = LevelMapArea.y + (y - camera.y) * LevelTileHeight;
+
+                        QueueTexturePro(
+                            gameContext.renderQueue,
+                            RenderLayer::Map,
+                            gameContext.atlasTexture,
+                            SpriteSheetRect(AtlasTilesetRect, tile, LevelTileWidth, LevelTileHeight),
+                            {dx, dy, LevelTileWidth, LevelTileHeight},
+                            {0, 0},
+                            0,
+                            NeutralTintColor);
+                    }
+                }
             }
         }
 
         const float character_scale = (gameContext.playerOnVoidTile) ? PlayerOnVoidTileScale : 1.0f;
         const Rectangle character_pos{
-            LevelMapArea.x + gameContext.playerTilesPosition.x * LevelTileWidth,
-            LevelMapArea.y + gameContext.playerTilesPosition.y * LevelTileHeight,
+            LevelMapArea.x + static_cast<float>((gameContext.playerTilesPosition.x - camera.x) * LevelTileWidth),
+            LevelMapArea.y + static_cast<float>((gameContext.playerTilesPosition.y - camera.y) * LevelTileHeight),
             CharacterSpriteWidth * character_scale,
             CharacterSpriteHeight * character_scale};
 
@@ -1109,164 +1414,82 @@ void renderMap(GameContext& gameContext)
         {
             if (gameContext.playerActionIndex == -1 && gameContext.turnCooldown <= std::chrono::milliseconds::zero())
             {
+                // the lines of every key on their own, queued in the order of the keyBinds
+                // @NOTE: less keys than KeyPreviewsMinBatch, no jobs (not worth it for a few keys)
+                size_t previewCount = 0;
                 for (const auto& [key, actions] : gameContext.keyBinds)
                 {
                     if (!actions.empty())
                     {
-                        Vector2 tile_position = gameContext.playerTilesPosition;
-                        Vector2 startPosLine{
-                            character_pos.x + character_pos.width / 2,
-                            character_pos.y + character_pos.height / 2};
-                        Vector2 endPosLine{
-                            character_pos.x + character_pos.width / 2,
-                            character_pos.y + character_pos.height / 2};
-                        auto preview_direction = gameContext.playerDirection;
-
-                        bool preview_on_void_tile = false;
-                        const auto isTileVoid = [&](Vector2 tp)
+                        if (previewCount == gameContext.keyPreviews.size())
                         {
-                            if (gameContext.mapData != nullptr && tile_position.x >= 0 && tile_position.y >= 0 &&
-                                tile_position.y < gameContext.mapData->size() &&
-                                tile_position.x < (*gameContext.mapData)[tile_position.y].size())
-                            {
-                                const auto& tile =
-                                    static_cast<TileSet>((*gameContext.mapData)[tile_position.y][tile_position.x]);
-                                return tile == TileSet::Void1 || tile == TileSet::Void2;
-                            }
-                            return true;
-                        };
-
-                        const auto movePosLineByAction = [&](Vector2& pos, Vector2* tp, auto action)
-                        {
-                            switch (action)
-                            {
-                                case ConnectorAction::NONE: break;
-                                case ConnectorAction::MovementRight:
-                                    pos.x += LevelTileWidth;
-                                    if (tp != nullptr) tp->x++;
-                                    preview_direction = CharacterDirection::Right;
-                                    return Vector2{1, 0};
-                                case ConnectorAction::MovementLeft:
-                                    pos.x -= LevelTileWidth;
-                                    if (tp != nullptr) tp->x--;
-                                    preview_direction = CharacterDirection::Left;
-                                    return Vector2{-1, 0};
-                                case ConnectorAction::MovementDown:
-                                    pos.y += LevelTileWidth;
-                                    if (tp != nullptr) tp->y++;
-                                    preview_direction = CharacterDirection::Down;
-                                    return Vector2{0, 1};
-                                case ConnectorAction::MovementUp:
-                                    pos.y -= LevelTileWidth;
-                                    if (tp != nullptr) tp->y--;
-                                    preview_direction = CharacterDirection::Up;
-                                    return Vector2{0, .1};
-                                case ConnectorAction::Jump:
-                                    switch (preview_direction)
-                                    {
-                                        case CharacterDirection::Right:
-                                            pos.x += JumpFactor * LevelTileWidth;
-                                            if (tp != nullptr) tp->x += JumpFactor;
-                                            preview_direction = CharacterDirection::Right;
-                                            return Vector2{1, 0};
-                                        case CharacterDirection::Left:
-                                            pos.x -= JumpFactor * LevelTileWidth;
-                                            if (tp != nullptr) tp->x -= JumpFactor;
-                                            preview_direction = CharacterDirection::Left;
-                                            return Vector2{-1, 0};
-                                        case CharacterDirection::Up:
-                                            pos.y -= JumpFactor * LevelTileWidth;
-                                            if (tp != nullptr) tp->y -= JumpFactor;
-                                            preview_direction = CharacterDirection::Up;
-                                            return Vector2{0, -1};
-                                        case CharacterDirection::Down:
-                                            pos.y += JumpFactor * LevelTileWidth;
-                                            if (tp != nullptr) tp->y += JumpFactor;
-                                            preview_direction = CharacterDirection::Down;
-                                            return Vector2{0, 1};
-                                    }
-                                    break;
-                            }
-                            return Vector2{1, 1};
-                        };
-                        Vector2 direction_vector{1, 1};
-                        for (const auto& action : actions)
+                            gameContext.keyPreviews.emplace_back();
+                        }
+                        gameContext.keyPreviews[previewCount].key = key;
+                        gameContext.keyPreviews[previewCount].actions = &actions;
+                        ++previewCount;
+                    }
+                }
+                ParallelFor(
+                    &gameContext.jobs,
+                    previewCount,
+                    KeyPreviewsMinBatch,
+                    [&](size_t begin, size_t end)
+                    {
+                        for (size_t i = begin; i < end; ++i)
                         {
-                            if (!preview_on_void_tile)
-                            {
-                                direction_vector = movePosLineByAction(endPosLine, &tile_position, action);
-                                if (CheckCollisionPointRec(endPosLine, LevelMapArea))
-                                {
-                                    DrawLineEx(startPosLine, endPosLine, PreviewLineThick, PreviewLineColor);
-                                }
-                                direction_vector = movePosLineByAction(startPosLine, nullptr, action);
-                            }
-                            else
-                            {
-                                direction_vector = movePosLineByAction(endPosLine, &tile_position, action);
-                                // make dotted line
-                                const auto max_step = Vector2Distance(startPosLine, endPosLine);
-                                auto innerStartPosLine = startPosLine;
-                                auto innerEndPosLine = Vector2MoveTowards(startPosLine, endPosLine, 2);
-                                for (int step = 0; step < max_step && Vector2Distance(innerEndPosLine, endPosLine) > 0;
-                                     step += 2 * PreviewLineThick)
-                                {
-                                    if (CheckCollisionPointRec(innerEndPosLine, LevelMapArea))
-                                    {
-                                        DrawLineEx(
-                                            innerStartPosLine,
-                                            innerEndPosLine,
-                                            PreviewLineThick,
-                                            PreviewLineColor);
-                                    }
-                                    innerStartPosLine =
-                                        Vector2MoveTowards(innerEndPosLine, endPosLine, PreviewLineThick);
-                                    innerEndPosLine =
-                                        Vector2MoveTowards(innerStartPosLine, endPosLine, 2 * PreviewLineThick);
-                                }
-                                if (CheckCollisionPointRec(endPosLine, LevelMapArea))
-                                {
-                                    DrawLineEx(innerEndPosLine, endPosLine, PreviewLineThick, PreviewLineColor);
-                                }
-                                direction_vector = movePosLineByAction(startPosLine, nullptr, action);
-                            }
-                            preview_on_void_tile = preview_on_void_tile || isTileVoid(tile_position);
+                            updateKeyPreview(gameContext, character_pos, gameContext.keyPreviews[i]);
                         }
+                    });
+                for (size_t i = 0; i < previewCount; ++i)
+                {
+                    const auto& preview = gameContext.keyPreviews[i];
+                    for (const auto& [startPosLine, endPosLine] : preview.lines)
+                    {
+                        QueueLineEx(
+                            gameContext.renderQueue,
+                            RenderLayer::MapOverlay,
+                            startPosLine,
+                            endPosLine,
+                            PreviewLineThick,
+                            PreviewLineColor);
+                    }
 
-                        const auto keyText = [&]()
+                    const auto keyText = [&]()
+                    {
+                        switch (preview.key)
                         {
-                            switch (key)
-                            {
-                                case ConnectorKey::NONE: break;
-                                case ConnectorKey::B: return ConnectorKeyBString;
-                                case ConnectorKey::H: return ConnectorKeyHString;
-                                case ConnectorKey::J: return ConnectorKeyJString;
-                                case ConnectorKey::K: return ConnectorKeyKString;
-                                case ConnectorKey::L: return ConnectorKeyLString;
-                                case ConnectorKey::G: return ConnectorKeyGString;
-                            }
-                            return "";
-                        }();
-                        auto keyTextSize = MeasureTextEx(
+                            case ConnectorKey::NONE: break;
+                            case ConnectorKey::B: return ConnectorKeyBString;
+                            case ConnectorKey::H: return ConnectorKeyHString;
+                            case ConnectorKey::J: return ConnectorKeyJString;
+                            case ConnectorKey::K: return ConnectorKeyKString;
+                            case ConnectorKey::L: return ConnectorKeyLString;
+                            case ConnectorKey::G: return ConnectorKeyGString;
+                        }
+                        return "";
+                    }();
+                    auto keyTextSize = MeasureTextEx(
+                        gameContext.font,
+                        keyText,
+                        PreviewTextFontSize,
+                        PreviewTextFontSize / FontSpacingFactor);
+                    Rectangle keyTextPos{
+                        preview.textPosition.x + preview.textDirection.x * keyTextSize.x / 2 + PreviewLineThick + 1,
+                        preview.textPosition.y + preview.textDirection.y * keyTextSize.y / 8 + PreviewLineThick,
+                        keyTextSize.x,
+                        keyTextSize.y};
+                    if (CheckCollisionRecs(keyTextPos, LevelMapArea))
+                    {
+                        QueueTextEx(
+                            gameContext.renderQueue,
+                            RenderLayer::MapOverlay,
                             gameContext.font,
                             keyText,
+                            {keyTextPos.x, keyTextPos.y},
                             PreviewTextFontSize,
-                            PreviewTextFontSize / FontSpacingFactor);
-                        Rectangle keyTextPos{
-                            startPosLine.x + direction_vector.x * keyTextSize.x / 2 + PreviewLineThick + 1,
-                            startPosLine.y + direction_vector.y * keyTextSize.y / 8 + PreviewLineThick,
-                            keyTextSize.x,
-                            keyTextSize.y};
-                        if (CheckCollisionRecs(keyTextPos, LevelMapArea))
-                        {
-                            DrawTextEx(
-                                gameContext.font,
-                                keyText,
-                                {keyTextPos.x, keyTextPos.y},
-                                PreviewTextFontSize,
-                                PreviewTextFontSize / FontSpacingFactor,
-                                PreviewLineColor);
-                        }
+                            PreviewTextFontSize / FontSpacingFactor,
+                            PreviewLineColor);
                     }
                 }
             }
@@ -1276,12 +1499,15 @@ void renderMap(GameContext& gameContext)
         // only render when in map bound
         if (CheckCollisionRecs(character_pos, LevelMapArea))
         {
-            DrawTexturePro(
-                gameContext.characterSpriteSheetTexture,
-                {static_cast<float>(static_cast<int>(gameContext.playerDirection) * CharacterSpriteWidth),
-                 0,
-                 CharacterSpriteWidth,
-                 CharacterSpriteHeight},
+            QueueTexturePro(
+                gameContext.renderQueue,
+                RenderLayer::MapCharacter,
+                gameContext.atlasTexture,
+                SpriteSheetRect(
+                    AtlasCharacterRect,
+                    static_cast<int>(gameContext.playerDirection),
+                    CharacterSpriteWidth,
+                    CharacterSpriteHeight),
                 character_pos,
                 {0, 0},
                 0,
@@ -1290,7 +1516,9 @@ void renderMap(GameContext& gameContext)
     }
 
     // border
-    DrawRectangleLinesEx(
+    QueueRectangleLinesEx(
+        gameContext.renderQueue,
+        RenderLayer::MapOverlay,
         LevelMapArea,
         BorderLineThick,
         (gameContext.state == GameState::CharacterMain) ? MapActiveBorderColor : BorderColor);
@@ -0,0 +1,128 @@
+#include "mapped_file.h"
+#include <cstdio>
+#include <cstdlib>
+
+// @NOTE: no raylib.h here, windows.h and raylib.h don't mix (CloseWindow, ShowCursor, Rectangle, ...)
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif !defined(PLATFORM_WEB)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MAPPED_FILE_POSIX
+#endif
+
+static bool readWholeFile(const char* fileName, MappedFile& file)
+{
+    FILE* fp = std::fopen(fileName, "rb");
+    if (fp == nullptr)
+    {
+        return false;
+    }
+    std::fseek(fp, 0, SEEK_END);
+    const long size = std::ftell(fp);
+    std::fseek(fp, 0, SEEK_SET);
+    if (size <= 0)
+    {
+        std::fclose(fp);
+        return false;
+    }
+    auto* data = static_cast<unsigned char*>(std::malloc(static_cast<size_t>(size)));
+    if (data == nullptr || std::fread(data, 1, static_cast<size_t>(size), fp) != static_cast<size_t>(size))
+    {
+        std::free(data);
+        std::fclose(fp);
+        return false;
+    }
+    std::fclose(fp);
+    file.data = data;
+    file.size = static_cast<size_t>(size);
+    file.mapping = nullptr;
+    file.mapped = false;
+    return true;
+}
+
+bool OpenMappedFile(const char* fileName, MappedFile& file)
+{
+    file = {};
+#if defined(_WIN32)
+    HANDLE handle =
+        CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(handle, &size) || size.QuadPart <= 0)
+    {
+        CloseHandle(handle);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(handle);
+    if (mapping == nullptr)
+    {
+        return readWholeFile(fileName, file);
+    }
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr)
+    {
+        CloseHandle(mapping);
+        return readWholeFile(fileName, file);
+    }
+    file.data = static_cast<const unsigned char*>(view);
+    file.size = static_cast<size_t>(size.QuadPart);
+    file.mapping = mapping;
+    file.mapped = true;
+    return true;
+#elif defined(MAPPED_FILE_POSIX)
+    const int fd = open(fileName, O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED)
+    {
+        return readWholeFile(fileName, file);
+    }
+    file.data = static_cast<const unsigned char*>(view);
+    file.size = static_cast<size_t>(st.st_size);
+    file.mapped = true;
+    return true;
+#else
+    return readWholeFile(fileName, file);
+#endif
+}
+
+void CloseMappedFile(MappedFile& file)
+{
+    if (file.data == nullptr)
+    {
+        return;
+    }
+    if (file.mapped)
+    {
+#if defined(_WIN32)
+        UnmapViewOfFile(file.data);
+        CloseHandle(static_cast<HANDLE>(file.mapping));
+#elif defined(MAPPED_FILE_POSIX)
+        munmap(const_cast<unsigned char*>(file.data), file.size);
+#endif
+    }
+    else
+    {
+        std::free(const_cast<unsigned char*>(file.data));
+    }
+    file = {};
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+
+/// Types
+/// read-only file mapping (mmap), falls back to reading the whole file where mapping is not available (Web)
+struct MappedFile
+{
+    const unsigned char* data{nullptr};
+    size_t size{0};
+
+    // platform handles
+    void* mapping{nullptr};
+    bool mapped{false}; ///< false: data is a heap copy
+};
+
+[[nodiscard]] extern bool OpenMappedFile(const char* fileName, MappedFile& file);
+extern void CloseMappedFile(MappedFile& file);
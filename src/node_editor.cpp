@@ -0,0 +1,245 @@
+#include "node_editor.h"
+#include "constants.h"
+#include <algorithm>
+
+static NodeHandle poolHandle(const NodePool& pool, uint32_t index)
+{
+    return {.index = index, .generation = pool.nodes[index].generation};
+}
+/// checks the affectedLinks (job system for many links), invalidLinks is updated afterwards on the calling thread
+static void checkEditorLinks(NodeEditor& editor)
+{
+    editor.affectedLinkResults.resize(editor.affectedLinks.size());
+    ParallelFor(
+        editor.jobs,
+        editor.affectedLinks.size(),
+        EditorLinksMinBatch,
+        [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                const uint64_t link = editor.affectedLinks[i];
+                editor.affectedLinkResults[i] = CheckPoolLinkGeometry(
+                    editor.pool,
+                    poolHandle(editor.pool, static_cast<uint32_t>(link >> 32u)),
+                    poolHandle(editor.pool, static_cast<uint32_t>(link & UINT32_MAX)));
+            }
+        });
+    for (size_t i = 0; i < editor.affectedLinks.size(); ++i)
+    {
+        if (editor.affectedLinkResults[i] == NodeLinkResult::Linked)
+        {
+            editor.invalidLinks.erase(editor.affectedLinks[i]);
+        }
+        else
+        {
+            editor.invalidLinks[editor.affectedLinks[i]] = editor.affectedLinkResults[i];
+        }
+    }
+}
+
+void RevalidateEditorLinks(NodeEditor& editor)
+{
+    editor.invalidLinks.clear();
+    editor.affectedLinks.clear();
+    for (uint32_t i = 0; i < editor.pool.nodes.size(); ++i)
+    {
+        const auto& node = editor.pool.nodes[i];
+        for (const auto& link : node.links)
+        {
+            if (node.alive && link.index > i)
+            {
+                editor.affectedLinks.push_back(EditorLinkKey(i, link.index));
+            }
+        }
+    }
+    checkEditorLinks(editor);
+}
+
+/// links whose state can depend on the node at its current position
+static void collectAffectedLinks(NodeEditor& editor, uint32_t index)
+{
+    const auto& pool = editor.pool;
+    const auto& node = pool.nodes[index];
+    const Vector2 position = node.data.position;
+    const auto addLinks = [&](uint32_t i)
+    {
+        for (const auto& link : pool.nodes[i].links)
+        {
+            editor.affectedLinks.push_back(EditorLinkKey(i, link.index));
+        }
+        return false;
+    };
+
+    // links of the node
+    addLinks(index);
+    // links the node can be in between, a link through the node has an end within half of its length
+    const float reach = 0.5f * pool.maxLinkLength + MaxNodeRadius;
+    QuerySpatialGridRect(pool.grid, {position.x - reach, position.y - reach, 2 * reach, 2 * reach}, addLinks);
+    // links crossing the links of the node (see CheckPoolLinkGeometry)
+    for (const auto& link : node.links)
+    {
+        QuerySpatialGridSegment(
+            pool.grid,
+            position,
+            pool.nodes[link.index].data.position,
+            0.5f * pool.maxLinkLength + 1.0f,
+            addLinks);
+    }
+}
+
+/// affectedLinks without duplicates, links that were removed in the meantime are dropped (also from invalidLinks)
+static void checkAffectedLinks(NodeEditor& editor)
+{
+    const auto& pool = editor.pool;
+    std::sort(editor.affectedLinks.begin(), editor.affectedLinks.end());
+    editor.affectedLinks.erase(
+        std::unique(editor.affectedLinks.begin(), editor.affectedLinks.end()),
+        editor.affectedLinks.end());
+    std::erase_if(
+        editor.affectedLinks,
+        [&](uint64_t link)
+        {
+            const auto& node = pool.nodes[static_cast<uint32_t>(link >> 32u)];
+            const auto linkIndex = static_cast<uint32_t>(link & UINT32_MAX);
+            const auto isLink = [&](NodeHandle other) { return other.index == linkIndex; };
+            const bool linked = node.alive && std::any_of(node.links.begin(), node.links.end(), isLink);
+            if (!linked)
+            {
+                editor.invalidLinks.erase(link);
+            }
+            return !linked;
+        });
+    checkEditorLinks(editor);
+}
+
+bool MoveEditorNode(NodeEditor& editor, NodeHandle handle, Vector2 position)
+{
+    if (GetPoolNode(editor.pool, handle) == nullptr)
+    {
+        return false;
+    }
+    editor.affectedLinks.clear();
+    collectAffectedLinks(editor, handle.index);
+    MovePoolNode(editor.pool, handle, position);
+    collectAffectedLinks(editor, handle.index);
+    checkAffectedLinks(editor);
+    return true;
+}
+
+NodeHandle AddEditorNode(NodeEditor& editor, const NodeData& data)
+{
+    const NodeHandle handle = AddPoolNode(editor.pool, data);
+    editor.affectedLinks.clear();
+    collectAffectedLinks(editor, handle.index);
+    checkAffectedLinks(editor);
+    return handle;
+}
+
+bool RemoveEditorNode(NodeEditor& editor, NodeHandle handle)
+{
+    if (GetPoolNode(editor.pool, handle) == nullptr)
+    {
+        return false;
+    }
+    // the links of the node are dropped after the removal
+    editor.affectedLinks.clear();
+    collectAffectedLinks(editor, handle.index);
+    RemovePoolNode(editor.pool, handle);
+    checkAffectedLinks(editor);
+    return true;
+}
+
+NodeLinkResult LinkEditorNodes(NodeEditor& editor, NodeHandle handle1, NodeHandle handle2)
+{
+    // a new link has no nodes in between and crosses no link, the other links stay the same
+    return LinkPoolNodes(editor.pool, handle1, handle2);
+}
+
+bool UnlinkEditorNodes(NodeEditor& editor, NodeHandle handle1, NodeHandle handle2)
+{
+    if (!UnlinkPoolNodes(editor.pool, handle1, handle2))
+    {
+        return false;
+    }
+    // the links that were crossing the removed link
+    const auto& pool = editor.pool;
+    editor.invalidLinks.erase(EditorLinkKey(handle1.index, handle2.index));
+    editor.affectedLinks.clear();
+    QuerySpatialGridSegment(
+        pool.grid,
+        pool.nodes[handle1.index].data.position,
+        pool.nodes[handle2.index].data.position,
+        0.5f * pool.maxLinkLength + 1.0f,
+        [&](uint32_t i)
+        {
+            for (const auto& link : pool.nodes[i].links)
+            {
+                editor.affectedLinks.push_back(EditorLinkKey(i, link.index));
+            }
+            return false;
+        });
+    checkAffectedLinks(editor);
+    return true;
+}
+
+void UpdateEditorCandidates(NodeEditor& editor, NodeHandle handle)
+{
+    editor.candidateLinks.clear();
+    const PoolNode* node = GetPoolNode(editor.pool, handle);
+    if (node == nullptr)
+    {
+        return;
+    }
+    const Vector2 position = node->data.position;
+    const float distance = NodeEditorCandidateDistance;
+    QuerySpatialGridRect(
+        editor.pool.grid,
+        {position.x - distance, position.y - distance, 2 * distance, 2 * distance},
+        [&](uint32_t index)
+        {
+            editor.candidateLinks.push_back({.node = poolHandle(editor.pool, index)});
+            return false;
+        });
+    ParallelFor(
+        editor.jobs,
+        editor.candidateLinks.size(),
+        EditorLinksMinBatch,
+        [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                editor.candidateLinks[i].result = CheckPoolLink(editor.pool, handle, editor.candidateLinks[i].node);
+            }
+        });
+    std::erase_if(
+        editor.candidateLinks,
+        [](const EditorCandidateLink& candidate)
+        {
+            switch (candidate.result)
+            {
+                case NodeLinkResult::InvalidNode:
+                case NodeLinkResult::InvalidTypes:
+                case NodeLinkResult::AlreadyLinked: return true;
+                case NodeLinkResult::Linked:
+                case NodeLinkResult::TooManyLinks:
+                case NodeLinkResult::NodeInBetween:
+                case NodeLinkResult::Crossing: break;
+            }
+            return false;
+        });
+}
+
+NodeLinkResult GetEditorLinkResult(const NodeEditor& editor, uint32_t index1, uint32_t index2)
+{
+    const auto link = editor.invalidLinks.find(EditorLinkKey(index1, index2));
+    return (link != editor.invalidLinks.end()) ? link->second : NodeLinkResult::Linked;
+}
+
+bool ValidateEditorLinks(const NodeEditor& editor)
+{
+    NodeEditor full;
+    full.pool = editor.pool;
+    RevalidateEditorLinks(full);
+    return full.invalidLinks == editor.invalidLinks;
+}
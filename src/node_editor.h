@@ -0,0 +1,63 @@
+#pragma once
+
+#include "force_layout.h"
+#include "job_system.h"
+#include "node_pool.h"
+#include "types.h"
+#include <raylib.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/// node editor (level design, sandbox graphs): nodes are dragged around, the links are checked again while dragging
+/// (nodes in between, crossings), only the links near the moved node are checked again (grid of the NodePool),
+/// a drag step costs about the same with 10 or 10k nodes
+inline constexpr float NodeEditorCandidateDistance = 160.0f; ///< candidate links of the dragged node (near nodes)
+
+/// Types
+struct EditorCandidateLink
+{
+    NodeHandle node;
+    NodeLinkResult result{NodeLinkResult::Linked}; ///< Linked when the link would be valid
+};
+struct NodeEditor
+{
+    NodePool pool;
+    NodeHandle dragNode{InvalidNodeHandle};
+    Vector2 dragOffset{0, 0}; ///< node position - mouse position
+    /// links that break the rules with the current positions (NodeInBetween, Crossing), key: EditorLinkKey
+    std::unordered_map<uint64_t, NodeLinkResult> invalidLinks;
+    /// links from the dragged node to the near nodes (not linked yet), see UpdateEditorCandidates
+    std::vector<EditorCandidateLink> candidateLinks;
+    std::vector<uint64_t> affectedLinks; ///< links checked again by the last move (or all links)
+    std::vector<NodeLinkResult> affectedLinkResults; ///< same index as affectedLinks
+    NodeHandle linkNode{InvalidNodeHandle}; ///< first node of a new link (sandbox, SHIFT+LMB)
+    JobSystem* jobs{nullptr}; ///< link checks of large graphs on the workers, nullptr: calling thread
+    ForceLayout layout; ///< auto-layout, ForceLayoutStepsPerFrame steps per frame while layoutRunning
+    bool layoutRunning{false};
+};
+
+[[nodiscard]] inline constexpr uint64_t EditorLinkKey(uint32_t index1, uint32_t index2)
+{
+    return (index1 < index2) ? (static_cast<uint64_t>(index1) << 32u) | index2
+                             : (static_cast<uint64_t>(index2) << 32u) | index1;
+}
+
+/// check all links again (after the nodes and links of the pool are set up), O(links)
+extern void RevalidateEditorLinks(NodeEditor& editor);
+/// move the node (MovePoolNode) and check the links near the old and new position again
+extern bool MoveEditorNode(NodeEditor& editor, NodeHandle handle, Vector2 position);
+/// add the node and check the links it can be in between again
+extern NodeHandle AddEditorNode(NodeEditor& editor, const NodeData& data);
+/// remove the node (RemovePoolNode) and check the links near it again
+extern bool RemoveEditorNode(NodeEditor& editor, NodeHandle handle);
+/// LinkPoolNodes, only valid links are added (no other link has to be checked again)
+extern NodeLinkResult LinkEditorNodes(NodeEditor& editor, NodeHandle handle1, NodeHandle handle2);
+/// remove the link and check the links that were crossing it again
+extern bool UnlinkEditorNodes(NodeEditor& editor, NodeHandle handle1, NodeHandle handle2);
+/// check the links from the node to all near nodes (NodeEditorCandidateDistance)
+extern void UpdateEditorCandidates(NodeEditor& editor, NodeHandle handle);
+/// NodeInBetween or Crossing for invalid links, Linked otherwise
+[[nodiscard]] extern NodeLinkResult GetEditorLinkResult(const NodeEditor& editor, uint32_t index1, uint32_t index2);
+/// invalidLinks is the same as after RevalidateEditorLinks (debug), O(links)
+[[nodiscard]] extern bool ValidateEditorLinks(const NodeEditor& editor);
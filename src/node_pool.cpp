@@ -0,0 +1,373 @@
+#include "node_pool.h"
+#include "geometry.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+void SetNodePoolArea(NodePool& pool, Rectangle area, float cellSize)
+{
+    InitSpatialGrid(pool.grid, area, cellSize);
+    for (uint32_t i = 0; i < pool.nodes.size(); ++i)
+    {
+        if (pool.nodes[i].alive)
+        {
+            SetSpatialGridItem(pool.grid, i, pool.nodes[i].data.position);
+        }
+    }
+}
+
+NodeHandle AddPoolNode(NodePool& pool, const NodeData& data)
+{
+    if (pool.grid.cells.empty())
+    {
+        InitSpatialGrid(pool.grid, ConnectorArea);
+    }
+
+    uint32_t index = 0;
+    if (!pool.freeSlots.empty())
+    {
+        index = pool.freeSlots.back();
+        pool.freeSlots.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(pool.nodes.size());
+        pool.nodes.emplace_back();
+    }
+    auto& node = pool.nodes[index];
+    node.data = data;
+    node.alive = true;
+    node.links.clear();
+    SetSpatialGridItem(pool.grid, index, data.position);
+    ++pool.nodeCount;
+    return {.index = index, .generation = node.generation};
+}
+
+static float linkLength(Vector2 start, Vector2 end)
+{
+    return std::hypot(end.x - start.x, end.y - start.y);
+}
+static size_t linkLengthBucket(const NodePool& pool, uint32_t index1, uint32_t index2)
+{
+    const float length = linkLength(pool.nodes[index1].data.position, pool.nodes[index2].data.position);
+    return static_cast<size_t>(std::ceil(length / LinkLengthBucketSize));
+}
+/// maxLinkLength follows the longest link, also when it gets shorter or is removed
+static void addLinkLength(NodePool& pool, uint32_t index1, uint32_t index2)
+{
+    const size_t bucket = linkLengthBucket(pool, index1, index2);
+    if (bucket >= pool.linkLengths.size())
+    {
+        pool.linkLengths.resize(bucket + 1, 0);
+        pool.maxLinkLength = static_cast<float>(bucket) * LinkLengthBucketSize;
+    }
+    ++pool.linkLengths[bucket];
+}
+static void removeLinkLength(NodePool& pool, uint32_t index1, uint32_t index2)
+{
+    --pool.linkLengths[linkLengthBucket(pool, index1, index2)];
+    while (!pool.linkLengths.empty() && pool.linkLengths.back() == 0)
+    {
+        pool.linkLengths.pop_back();
+    }
+    pool.maxLinkLength =
+        pool.linkLengths.empty() ? 0.0f : static_cast<float>(pool.linkLengths.size() - 1) * LinkLengthBucketSize;
+}
+
+bool RemovePoolNode(NodePool& pool, NodeHandle handle)
+{
+    PoolNode* node = GetPoolNode(pool, handle);
+    if (node == nullptr)
+    {
+        return false;
+    }
+    for (const auto& link : node->links)
+    {
+        removeLinkLength(pool, handle.index, link.index);
+        auto& links = pool.nodes[link.index].links;
+        links.erase(std::find(links.begin(), links.end(), handle));
+    }
+    pool.linkCount -= node->links.size();
+    node->links.clear();
+    node->alive = false;
+    ++node->generation;
+    RemoveSpatialGridItem(pool.grid, handle.index);
+    pool.freeSlots.push_back(handle.index);
+    --pool.nodeCount;
+    return true;
+}
+
+bool MovePoolNode(NodePool& pool, NodeHandle handle, Vector2 position)
+{
+    PoolNode* node = GetPoolNode(pool, handle);
+    if (node == nullptr)
+    {
+        return false;
+    }
+    for (const auto& link : node->links)
+    {
+        removeLinkLength(pool, handle.index, link.index);
+    }
+    node->data.position = position;
+    SetSpatialGridItem(pool.grid, handle.index, position);
+    for (const auto& link : node->links)
+    {
+        addLinkLength(pool, handle.index, link.index);
+    }
+    return true;
+}
+
+PoolNode* GetPoolNode(NodePool& pool, NodeHandle handle)
+{
+    return const_cast<PoolNode*>(GetPoolNode(static_cast<const NodePool&>(pool), handle));
+}
+const PoolNode* GetPoolNode(const NodePool& pool, NodeHandle handle)
+{
+    if (handle.index >= pool.nodes.size())
+    {
+        return nullptr;
+    }
+    const auto& node = pool.nodes[handle.index];
+    return (node.alive && node.generation == handle.generation) ? &node : nullptr;
+}
+
+static bool validTypes(const NodePool& pool, const NodeData& data1, const NodeData& data2)
+{
+    return data1.type != ConnectorType::DISABLED && data2.type != ConnectorType::DISABLED &&
+           (!HasConnectionRule(pool.rules, ConnectionRule::NodeTypes) || data1.type != data2.type ||
+            data1.type == ConnectorType::Action);
+}
+
+NodeLinkResult CheckPoolLink(const NodePool& pool, NodeHandle handle1, NodeHandle handle2)
+{
+    const PoolNode* node1 = GetPoolNode(pool, handle1);
+    const PoolNode* node2 = GetPoolNode(pool, handle2);
+    if (node1 == nullptr || node2 == nullptr || handle1 == handle2)
+    {
+        return NodeLinkResult::InvalidNode;
+    }
+    if (!validTypes(pool, node1->data, node2->data))
+    {
+        return NodeLinkResult::InvalidTypes;
+    }
+    if (std::find(node1->links.begin(), node1->links.end(), handle2) != node1->links.end())
+    {
+        return NodeLinkResult::AlreadyLinked;
+    }
+    if (node1->links.size() >= pool.maxLinksPerNode || node2->links.size() >= pool.maxLinksPerNode)
+    {
+        return NodeLinkResult::TooManyLinks;
+    }
+    return CheckPoolLinkGeometry(pool, handle1, handle2);
+}
+NodeLinkResult CheckPoolLinkGeometry(const NodePool& pool, NodeHandle handle1, NodeHandle handle2)
+{
+    const Vector2 start = pool.nodes[handle1.index].data.position;
+    const Vector2 end = pool.nodes[handle2.index].data.position;
+    if (HasConnectionRule(pool.rules, ConnectionRule::NodesInBetween))
+    {
+        const bool nodeInBetween = QuerySpatialGridSegment(
+            pool.grid,
+            start,
+            end,
+            MaxNodeRadius,
+            [&](uint32_t i)
+            {
+                return i != handle1.index && i != handle2.index &&
+                       geometry::CheckCollisionLineNode(start, end, pool.nodes[i].data);
+            });
+        if (nodeInBetween)
+        {
+            return NodeLinkResult::NodeInBetween;
+        }
+    }
+    // a crossing link has a node within half of its length to the crossing, links sharing a node don't cross
+    if (HasConnectionRule(pool.rules, ConnectionRule::Crossings))
+    {
+        const bool crossing = QuerySpatialGridSegment(
+            pool.grid,
+            start,
+            end,
+            0.5f * pool.maxLinkLength + 1.0f,
+            [&](uint32_t i)
+            {
+                if (i == handle1.index || i == handle2.index)
+                {
+                    return false;
+                }
+                const auto& node = pool.nodes[i];
+                return std::any_of(
+                    node.links.begin(),
+                    node.links.end(),
+                    [&](const NodeHandle& link)
+                    {
+                        return link.index != handle1.index && link.index != handle2.index &&
+                               geometry::CheckCollisionLines(
+                                   start, end, node.data.position, pool.nodes[link.index].data.position);
+                    });
+            });
+        if (crossing)
+        {
+            return NodeLinkResult::Crossing;
+        }
+    }
+    return NodeLinkResult::Linked;
+}
+
+NodeLinkResult LinkPoolNodes(NodePool& pool, NodeHandle handle1, NodeHandle handle2)
+{
+    const NodeLinkResult result = CheckPoolLink(pool, handle1, handle2);
+    if (result == NodeLinkResult::Linked)
+    {
+        pool.nodes[handle1.index].links.push_back(handle2);
+        pool.nodes[handle2.index].links.push_back(handle1);
+        ++pool.linkCount;
+        addLinkLength(pool, handle1.index, handle2.index);
+    }
+    return result;
+}
+
+bool UnlinkPoolNodes(NodePool& pool, NodeHandle handle1, NodeHandle handle2)
+{
+    PoolNode* node1 = GetPoolNode(pool, handle1);
+    PoolNode* node2 = GetPoolNode(pool, handle2);
+    if (node1 == nullptr || node2 == nullptr)
+    {
+        return false;
+    }
+    const auto link1 = std::find(node1->links.begin(), node1->links.end(), handle2);
+    const auto link2 = std::find(node2->links.begin(), node2->links.end(), handle1);
+    if (link1 == node1->links.end() || link2 == node2->links.end())
+    {
+        return false;
+    }
+    // order of the links doesn't matter
+    *link1 = node1->links.back();
+    node1->links.pop_back();
+    *link2 = node2->links.back();
+    node2->links.pop_back();
+    --pool.linkCount;
+    removeLinkLength(pool, handle1.index, handle2.index);
+    return true;
+}
+
+bool ValidatePoolGraph(const NodePool& pool)
+{
+    size_t nodeCount = 0;
+    size_t linkEnds = 0;
+    for (uint32_t i = 0; i < pool.nodes.size(); ++i)
+    {
+        const auto& node = pool.nodes[i];
+        if (!node.alive)
+        {
+            if (!node.links.empty())
+            {
+                return false;
+            }
+            continue;
+        }
+        ++nodeCount;
+        linkEnds += node.links.size();
+        if (node.links.size() > pool.maxLinksPerNode)
+        {
+            return false;
+        }
+        const NodeHandle handle{.index = i, .generation = node.generation};
+        for (const auto& link : node.links)
+        {
+            const PoolNode* other = GetPoolNode(pool, link);
+            if (other == nullptr || link == handle || !validTypes(pool, node.data, other->data) ||
+                std::find(other->links.begin(), other->links.end(), handle) == other->links.end())
+            {
+                return false;
+            }
+        }
+    }
+    size_t linkLengths = 0;
+    for (const uint32_t count : pool.linkLengths)
+    {
+        linkLengths += count;
+    }
+    return nodeCount == pool.nodeCount && linkEnds == 2 * pool.linkCount && linkLengths == pool.linkCount;
+}
+
+void GetPoolLinkSegments(const NodePool& pool, std::vector<CrossingSegment>& segments)
+{
+    segments.clear();
+    segments.reserve(pool.linkCount);
+    for (uint32_t i = 0; i < pool.nodes.size(); ++i)
+    {
+        const auto& node = pool.nodes[i];
+        for (const auto& link : node.links)
+        {
+            if (link.index > i)
+            {
+                segments.push_back(
+                    {.start = node.data.position,
+                     .end = pool.nodes[link.index].data.position,
+                     .node1 = static_cast<int>(i),
+                     .node2 = static_cast<int>(link.index)});
+            }
+        }
+    }
+}
+
+bool PoolGraphHasCrossings(const NodePool& pool)
+{
+    std::vector<CrossingSegment> segments;
+    GetPoolLinkSegments(pool, segments);
+    return AnySegmentsCross(segments);
+}
+
+std::vector<NodeHandle> GenerateSyntheticGraph(
+    NodePool& pool, size_t nodeCount, size_t linkAttempts, Rectangle area, uint32_t seed)
+{
+    std::vector<NodeHandle> handles;
+    if (nodeCount == 0)
+    {
+        return handles;
+    }
+    if (pool.nodeCount == 0)
+    {
+        SetNodePoolArea(pool, area);
+    }
+    std::mt19937 random{seed};
+    const auto columns = static_cast<size_t>(
+        std::max(1.0f, std::ceil(std::sqrt(static_cast<float>(nodeCount) * area.width / area.height))));
+    const size_t rows = (nodeCount + columns - 1) / columns;
+    const float cellWidth = area.width / static_cast<float>(columns);
+    const float cellHeight = area.height / static_cast<float>(rows);
+    std::uniform_real_distribution<float> jitter{-0.25f, 0.25f};
+    std::uniform_int_distribution<int> randomAction{
+        static_cast<int>(ConnectorAction::MovementRight), static_cast<int>(ConnectorAction::Jump)};
+    constexpr std::array<ConnectorKey, 6> Keys{
+        ConnectorKey::B, ConnectorKey::H, ConnectorKey::J, ConnectorKey::K, ConnectorKey::L, ConnectorKey::G};
+    std::uniform_int_distribution<size_t> randomKey{0, Keys.size() - 1};
+
+    // jittered grid, about a quarter are keys
+    handles.reserve(nodeCount);
+    for (size_t i = 0; i < nodeCount; ++i)
+    {
+        const Vector2 position{
+            area.x + (static_cast<float>(i % columns) + 0.5f + jitter(random)) * cellWidth,
+            area.y + (static_cast<float>(i / columns) + 0.5f + jitter(random)) * cellHeight};
+        handles.push_back(AddPoolNode(
+            pool,
+            (random() % 4 == 0) ? KeyNode(position, Keys[randomKey(random)])
+                                : ActionNode(position, static_cast<ConnectorAction>(randomAction(random)))));
+    }
+
+    // links to the grid neighbours (right, down, diagonal)
+    std::uniform_int_distribution<size_t> randomNode{0, nodeCount - 1};
+    const std::array<size_t, 3> neighbours{1, columns, columns + 1};
+    for (size_t attempt = 0; attempt < linkAttempts; ++attempt)
+    {
+        const size_t node = randomNode(random);
+        const size_t other = node + neighbours[random() % neighbours.size()];
+        if (other < nodeCount)
+        {
+            LinkPoolNodes(pool, handles[node], handles[other]);
+        }
+    }
+    return handles;
+}
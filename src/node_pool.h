@@ -0,0 +1,92 @@
+#pragma once
+
+#include "constants.h"
+#include "segment_sweep.h"
+#include "spatial_grid.h"
+#include "types.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// growable node storage for sandbox graphs (thousands of nodes, not limited to MaxNodesInLevel),
+/// nodes are referenced by handles: removed nodes free their slot, the generation makes old handles invalid
+/// connections are adjacency lists (both directions), same rules as validConnection/validPreConnections
+/// link checks only look at the nodes and links near the new link (grid)
+
+/// Constants
+inline constexpr float LinkLengthBucketSize = 16.0f; ///< NodePool::maxLinkLength is at most this much longer
+
+/// Types
+struct NodeHandle
+{
+    uint32_t index{UINT32_MAX};
+    uint32_t generation{0};
+
+    bool operator==(const NodeHandle&) const = default;
+};
+inline constexpr NodeHandle InvalidNodeHandle{};
+
+struct PoolNode
+{
+    NodeData data;
+    uint32_t generation{0};
+    bool alive{false};
+    std::vector<NodeHandle> links;
+};
+
+struct NodePool
+{
+    std::vector<PoolNode> nodes;
+    std::vector<uint32_t> freeSlots;
+    size_t nodeCount{0};
+    size_t linkCount{0};
+    size_t maxLinksPerNode{MaxNodeConnections};
+    uint8_t rules{AllConnectionRules}; ///< ConnectionRule flags, only NodeTypes, NodesInBetween and Crossings are used
+    SpatialGrid grid;          ///< node index by position, ConnectorArea by default (SetNodePoolArea)
+    std::vector<uint32_t> linkLengths; ///< links per length bucket (LinkLengthBucketSize), last bucket not empty
+    float maxLinkLength{0.0f}; ///< longest link (or more), links crossing a new link have a node within half of it
+};
+
+enum class NodeLinkResult : uint8_t
+{
+    Linked,
+    InvalidNode, ///< removed node (old handle), same node twice
+    InvalidTypes,
+    AlreadyLinked,
+    TooManyLinks, ///< maxLinksPerNode
+    NodeInBetween,
+    Crossing,
+};
+
+/// area of the grid (nodes outside still work, but are slower), rebuilds the grid
+extern void SetNodePoolArea(NodePool& pool, Rectangle area, float cellSize = SpatialGridCellSize);
+extern NodeHandle AddPoolNode(NodePool& pool, const NodeData& data);
+/// change the position with this (not data.position), keeps the grid up to date, the links are not checked again
+extern bool MovePoolNode(NodePool& pool, NodeHandle handle, Vector2 position);
+/// unlinks the node, handles of the node are invalid afterwards
+extern bool RemovePoolNode(NodePool& pool, NodeHandle handle);
+/// nullptr when the node was removed
+[[nodiscard]] extern PoolNode* GetPoolNode(NodePool& pool, NodeHandle handle);
+[[nodiscard]] extern const PoolNode* GetPoolNode(const NodePool& pool, NodeHandle handle);
+
+/// connect the nodes when the rules allow it (validConnection: types, limits, nodes in between, crossings)
+extern NodeLinkResult LinkPoolNodes(NodePool& pool, NodeHandle handle1, NodeHandle handle2);
+[[nodiscard]] extern NodeLinkResult CheckPoolLink(const NodePool& pool, NodeHandle handle1, NodeHandle handle2);
+/// only nodes in between and crossings (NodeInBetween, Crossing or Linked), also for existing links (after a move),
+/// rules that are off (NodePool::rules) are not checked
+/// @NOTE: handles are not checked
+[[nodiscard]] extern NodeLinkResult
+CheckPoolLinkGeometry(const NodePool& pool, NodeHandle handle1, NodeHandle handle2);
+extern bool UnlinkPoolNodes(NodePool& pool, NodeHandle handle1, NodeHandle handle2);
+
+/// consistency of the graph (links in both directions, alive nodes, link limits and types), O(nodes + links)
+[[nodiscard]] extern bool ValidatePoolGraph(const NodePool& pool);
+/// every link once (node1: lower index), for the crossing checks (segment_sweep.h)
+extern void GetPoolLinkSegments(const NodePool& pool, std::vector<CrossingSegment>& segments);
+/// any two links cross (e.g. after MovePoolNode), O(links log links)
+[[nodiscard]] extern bool PoolGraphHasCrossings(const NodePool& pool);
+
+/// random sandbox graph for tests and benchmarks: nodeCount nodes (jittered grid in area), then linkAttempts random
+/// links between near nodes (only valid links are kept), returns the handles of the nodes
+extern std::vector<NodeHandle> GenerateSyntheticGraph(
+    NodePool& pool, size_t nodeCount, size_t linkAttempts, Rectangle area, uint32_t seed);
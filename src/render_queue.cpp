@@ -0,0 +1,289 @@
+#include "render_queue.h"
+#include <raylib.h>
+#include <rlgl.h>
+#include <algorithm>
+#include <cstring>
+
+static unsigned int commandTextureId(const RenderQueue& queue, const RenderCommand& command)
+{
+    switch (command.type)
+    {
+        case RenderCommandType::TexturePro: return command.texture.id;
+        case RenderCommandType::Text: return (command.font != nullptr) ? command.font->texture.id : 0;
+        case RenderCommandType::Rectangle:
+        case RenderCommandType::RectangleLines:
+        case RenderCommandType::Ring:
+        case RenderCommandType::Circle: return queue.shapesTextureId;
+        case RenderCommandType::Line:
+        case RenderCommandType::CircleLines: return queue.defaultTextureId;
+    }
+    return 0;
+}
+static RenderPrimitive commandPrimitive(const RenderCommand& command)
+{
+    switch (command.type)
+    {
+        case RenderCommandType::TexturePro:
+        case RenderCommandType::Text:
+        case RenderCommandType::Rectangle:
+        case RenderCommandType::RectangleLines:
+        case RenderCommandType::Ring:
+        case RenderCommandType::Circle: return RenderPrimitive::Quads; // SUPPORT_QUADS_DRAW_MODE
+        case RenderCommandType::Line: return RenderPrimitive::Triangles;
+        case RenderCommandType::CircleLines: return RenderPrimitive::Lines;
+    }
+    return RenderPrimitive::Quads;
+}
+
+static void submitCommand(RenderQueue& queue, RenderLayer layer, const RenderCommand& command)
+{
+    const auto index = static_cast<uint64_t>(queue.commands.size());
+    const auto textureId = commandTextureId(queue, command);
+    const auto primitive = commandPrimitive(command);
+    // layer (8 bit) | texture (16 bit) | primitive (8 bit) | submit order (32 bit)
+    const uint64_t key = (static_cast<uint64_t>(layer) << 56) | (static_cast<uint64_t>(textureId & 0xFFFF) << 40) |
+                         (static_cast<uint64_t>(primitive) << 32) | index;
+    queue.commands.push_back(command);
+    queue.sortKeys.push_back(key);
+}
+
+static void executeCommand(const RenderQueue& queue, const RenderCommand& command)
+{
+    switch (command.type)
+    {
+        case RenderCommandType::TexturePro:
+            DrawTexturePro(
+                command.texture,
+                command.source,
+                command.dest,
+                command.origin,
+                command.rotation,
+                command.color);
+            break;
+        case RenderCommandType::Text:
+            if (command.font != nullptr)
+            {
+                DrawTextEx(
+                    *command.font,
+                    queue.textBuffer.c_str() + command.textOffset,
+                    command.startPos,
+                    command.fontSize,
+                    command.spacing,
+                    command.color);
+            }
+            break;
+        case RenderCommandType::Line:
+            DrawLineEx(command.startPos, command.endPos, command.thick, command.color);
+            break;
+        case RenderCommandType::Rectangle: DrawRectangleRec(command.dest, command.color); break;
+        case RenderCommandType::RectangleLines:
+            DrawRectangleLinesEx(command.dest, command.thick, command.color);
+            break;
+        case RenderCommandType::Ring:
+            DrawRing(
+                command.startPos,
+                command.innerRadius,
+                command.outerRadius,
+                command.startAngle,
+                command.endAngle,
+                command.segments,
+                command.color);
+            break;
+        case RenderCommandType::Circle:
+            DrawCircleV(command.startPos, command.outerRadius, command.color);
+            break;
+        case RenderCommandType::CircleLines:
+            DrawCircleLinesV(command.startPos, command.outerRadius, command.color);
+            break;
+    }
+}
+
+void BeginRenderQueue(RenderQueue& queue)
+{
+    queue.commands.clear();
+    queue.sortKeys.clear();
+    queue.textBuffer.clear();
+    queue.shapesTextureId = GetShapesTexture().id;
+    queue.defaultTextureId = rlGetTextureIdDefault();
+}
+
+void FlushRenderQueue(RenderQueue& queue, bool keepCommands)
+{
+    const auto countBatchFlushes = [&](auto getCommand)
+    {
+        int flushes = 0;
+        unsigned int lastTextureId = 0;
+        auto lastPrimitive = RenderPrimitive::Quads;
+        for (size_t i = 0; i < queue.commands.size(); ++i)
+        {
+            const auto& command = getCommand(i);
+            const auto textureId = commandTextureId(queue, command);
+            const auto primitive = commandPrimitive(command);
+            if (i == 0 || textureId != lastTextureId || primitive != lastPrimitive)
+            {
+                ++flushes;
+            }
+            lastTextureId = textureId;
+            lastPrimitive = primitive;
+        }
+        return flushes;
+    };
+
+    queue.stats.commands = static_cast<int>(queue.commands.size());
+    queue.stats.unsortedBatchFlushes =
+        countBatchFlushes([&](size_t i) -> const RenderCommand& { return queue.commands[i]; });
+
+    // submit order is the lowest part of the key, so equal draws keep their order
+    std::sort(queue.sortKeys.begin(), queue.sortKeys.end());
+    const auto sortedCommand = [&](size_t i) -> const RenderCommand&
+    {
+        return queue.commands[static_cast<uint32_t>(queue.sortKeys[i] & 0xFFFFFFFF)];
+    };
+    queue.stats.batchFlushes = countBatchFlushes(sortedCommand);
+
+    for (size_t i = 0; i < queue.sortKeys.size(); ++i)
+    {
+        executeCommand(queue, sortedCommand(i));
+    }
+
+    if (!keepCommands)
+    {
+        queue.commands.clear();
+        queue.sortKeys.clear();
+        queue.textBuffer.clear();
+    }
+}
+
+
+void QueueTextureRec(
+    RenderQueue& queue,
+    RenderLayer layer,
+    Texture2D texture,
+    Rectangle source,
+    Vector2 position,
+    Color tint)
+{
+    QueueTexturePro(
+        queue,
+        layer,
+        texture,
+        source,
+        {position.x, position.y, source.width, source.height},
+        {0, 0},
+        0,
+        tint);
+}
+void QueueTexturePro(
+    RenderQueue& queue,
+    RenderLayer layer,
+    Texture2D texture,
+    Rectangle source,
+    Rectangle dest,
+    Vector2 origin,
+    float rotation,
+    Color tint)
+{
+    RenderCommand command;
+    command.type = RenderCommandType::TexturePro;
+    command.texture = texture;
+    command.source = source;
+    command.dest = dest;
+    command.origin = origin;
+    command.rotation = rotation;
+    command.color = tint;
+    submitCommand(queue, layer, command);
+}
+void QueueTextEx(
+    RenderQueue& queue,
+    RenderLayer layer,
+    const Font& font,
+    const char* text,
+    Vector2 position,
+    float fontSize,
+    float spacing,
+    Color tint)
+{
+    if (text == nullptr || text[0] == '\0')
+    {
+        return;
+    }
+
+    RenderCommand command;
+    command.type = RenderCommandType::Text;
+    command.font = &font;
+    // copy text, TextFormat buffers are reused before the queue gets flushed
+    command.textOffset = static_cast<uint32_t>(queue.textBuffer.size());
+    queue.textBuffer.append(text, std::strlen(text) + 1);
+    command.startPos = position;
+    command.fontSize = fontSize;
+    command.spacing = spacing;
+    command.color = tint;
+    submitCommand(queue, layer, command);
+}
+void QueueLineEx(RenderQueue& queue, RenderLayer layer, Vector2 startPos, Vector2 endPos, float thick, Color color)
+{
+    RenderCommand command;
+    command.type = RenderCommandType::Line;
+    command.startPos = startPos;
+    command.endPos = endPos;
+    command.thick = thick;
+    command.color = color;
+    submitCommand(queue, layer, command);
+}
+void QueueRectangleRec(RenderQueue& queue, RenderLayer layer, Rectangle rec, Color color)
+{
+    RenderCommand command;
+    command.type = RenderCommandType::Rectangle;
+    command.dest = rec;
+    command.color = color;
+    submitCommand(queue, layer, command);
+}
+void QueueRectangleLinesEx(RenderQueue& queue, RenderLayer layer, Rectangle rec, float lineThick, Color color)
+{
+    RenderCommand command;
+    command.type = RenderCommandType::RectangleLines;
+    command.dest = rec;
+    command.thick = lineThick;
+    command.color = color;
+    submitCommand(queue, layer, command);
+}
+void QueueRing(
+    RenderQueue& queue,
+    RenderLayer layer,
+    Vector2 center,
+    float innerRadius,
+    float outerRadius,
+    float startAngle,
+    float endAngle,
+    int segments,
+    Color color)
+{
+    RenderCommand command;
+    command.type = RenderCommandType::Ring;
+    command.startPos = center;
+    command.innerRadius = innerRadius;
+    command.outerRadius = outerRadius;
+    command.startAngle = startAngle;
+    command.endAngle = endAngle;
+    command.segments = segments;
+    command.color = color;
+    submitCommand(queue, layer, command);
+}
+void QueueCircle(RenderQueue& queue, RenderLayer layer, Vector2 center, float radius, Color color)
+{
+    RenderCommand command;
+    command.type = RenderCommandType::Circle;
+    command.startPos = center;
+    command.outerRadius = radius;
+    command.color = color;
+    submitCommand(queue, layer, command);
+}
+void QueueCircleLines(RenderQueue& queue, RenderLayer layer, Vector2 center, float radius, Color color)
+{
+    RenderCommand command;
+    command.type = RenderCommandType::CircleLines;
+    command.startPos = center;
+    command.outerRadius = radius;
+    command.color = color;
+    submitCommand(queue, layer, command);
+}
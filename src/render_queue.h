@@ -0,0 +1,145 @@
+#pragma once
+
+#include <raylib.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// enums
+// painter's order, draws in a higher layer are always on top of lower layers
+// @NOTE: draws inside the same layer are re-ordered by texture, they must not overlap each other
+enum class RenderLayer : uint8_t
+{
+    Background,
+    NodeLines,
+    NodeBackground,
+    Nodes,
+    NodeLabels,
+    Map,
+    MapOverlay,
+    MapCharacter,
+    UiBackground,
+    Ui,
+    HelpBackground,
+    Help,
+};
+
+// rlgl draw mode used by the raylib draw call, a mode switch also breaks the batch
+enum class RenderPrimitive : uint8_t
+{
+    Quads,
+    Triangles,
+    Lines,
+};
+
+enum class RenderCommandType : uint8_t
+{
+    TexturePro,
+    Text,
+    Line,
+    Rectangle,
+    RectangleLines,
+    Ring,
+    Circle,
+    CircleLines,
+};
+
+/// Types
+struct RenderCommand
+{
+    RenderCommandType type{RenderCommandType::Rectangle};
+    Color color{WHITE};
+    // texture
+    Texture2D texture{};
+    Rectangle source{0, 0, 0, 0};
+    Rectangle dest{0, 0, 0, 0};
+    Vector2 origin{0, 0};
+    float rotation{0};
+    // text
+    const Font* font{nullptr};
+    uint32_t textOffset{0};
+    float fontSize{0};
+    float spacing{0};
+    // shapes
+    Vector2 startPos{0, 0};
+    Vector2 endPos{0, 0};
+    float thick{0};
+    float innerRadius{0};
+    float outerRadius{0};
+    float startAngle{0};
+    float endAngle{0};
+    int segments{0};
+};
+
+struct RenderQueueStats
+{
+    int commands{0};
+    int batchFlushes{0}; ///< texture or draw mode switches while flushing (each one ends a raylib batch)
+    int unsortedBatchFlushes{0}; ///< switches the same commands would cause in submit order
+};
+
+struct RenderQueue
+{
+    std::vector<RenderCommand> commands;
+    std::vector<uint64_t> sortKeys; ///< layer | texture | primitive | sequence, low 32 bits are the command index
+    std::string textBuffer; ///< null-terminated strings referenced by RenderCommand::textOffset
+    RenderQueueStats stats{};
+
+    // cached per frame, see BeginRenderQueue
+    unsigned int shapesTextureId{0};
+    unsigned int defaultTextureId{0};
+
+    RenderQueue()
+    {
+        commands.reserve(512);
+        sortKeys.reserve(512);
+        textBuffer.reserve(2048);
+    }
+};
+
+extern void BeginRenderQueue(RenderQueue& queue);
+/// keepCommands: the same frame can be drawn again (snapshot of the logic thread, see logic_thread.h)
+extern void FlushRenderQueue(RenderQueue& queue, bool keepCommands = false);
+
+// submit, same parameters as the raylib draw functions
+extern void QueueTextureRec(
+    RenderQueue& queue,
+    RenderLayer layer,
+    Texture2D texture,
+    Rectangle source,
+    Vector2 position,
+    Color tint);
+extern void QueueTexturePro(
+    RenderQueue& queue,
+    RenderLayer layer,
+    Texture2D texture,
+    Rectangle source,
+    Rectangle dest,
+    Vector2 origin,
+    float rotation,
+    Color tint);
+extern void QueueTextEx(
+    RenderQueue& queue,
+    RenderLayer layer,
+    const Font& font,
+    const char* text,
+    Vector2 position,
+    float fontSize,
+    float spacing,
+    Color tint);
+extern void
+QueueLineEx(RenderQueue& queue, RenderLayer layer, Vector2 startPos, Vector2 endPos, float thick, Color color);
+extern void QueueRectangleRec(RenderQueue& queue, RenderLayer layer, Rectangle rec, Color color);
+extern void QueueRectangleLinesEx(RenderQueue& queue, RenderLayer layer, Rectangle rec, float lineThick, Color color);
+extern void QueueRing(
+    RenderQueue& queue,
+    RenderLayer layer,
+    Vector2 center,
+    float innerRadius,
+    float outerRadius,
+    float startAngle,
+    float endAngle,
+    int segments,
+    Color color);
+extern void QueueCircle(RenderQueue& queue, RenderLayer layer, Vector2 center, float radius, Color color);
+extern void QueueCircleLines(RenderQueue& queue, RenderLayer layer, Vector2 center, float radius, Color color);
@@ -0,0 +1,90 @@
+#include "resource_pack.h"
+#include <raylib.h>
+#include <algorithm>
+#include <cstring>
+
+#if defined(EMBED_RESOURCES)
+// generated from src/resources.pack, see tools/embed_resource_pack.cmake
+extern const unsigned char ResourcePackData[];
+extern const size_t ResourcePackDataSize;
+#endif
+
+static const ResourcePackHeader* embeddedHeader()
+{
+#if defined(EMBED_RESOURCES)
+    if (ResourcePackDataSize < sizeof(ResourcePackHeader))
+    {
+        return nullptr;
+    }
+    const auto* header = reinterpret_cast<const ResourcePackHeader*>(ResourcePackData);
+    if (std::memcmp(header->magic, ResourcePackMagic, sizeof(ResourcePackMagic)) != 0 ||
+        header->version != ResourcePackVersion ||
+        sizeof(ResourcePackHeader) + header->entryCount * sizeof(ResourcePackEntry) > ResourcePackDataSize)
+    {
+        return nullptr;
+    }
+    return header;
+#else
+    return nullptr;
+#endif
+}
+
+bool HasEmbeddedResources()
+{
+    return embeddedHeader() != nullptr;
+}
+
+bool FindEmbeddedResource(const char* fileName, PackedResource& resource)
+{
+    const auto* header = embeddedHeader();
+    if (header == nullptr || fileName == nullptr)
+    {
+        return false;
+    }
+
+    const auto* pack = reinterpret_cast<const unsigned char*>(header);
+    const auto* entriesBegin = reinterpret_cast<const ResourcePackEntry*>(pack + sizeof(ResourcePackHeader));
+    const auto* entriesEnd = entriesBegin + header->entryCount;
+    const auto entryName = [&](const ResourcePackEntry& entry)
+    {
+        return reinterpret_cast<const char*>(pack + entry.nameOffset);
+    };
+
+    // entries are sorted by name
+    const auto* entry = std::lower_bound(
+        entriesBegin,
+        entriesEnd,
+        fileName,
+        [&](const ResourcePackEntry& e, const char* name) { return std::strcmp(entryName(e), name) < 0; });
+    if (entry == entriesEnd || std::strcmp(entryName(*entry), fileName) != 0)
+    {
+        return false;
+    }
+
+    resource.data = pack + entry->dataOffset;
+    resource.dataSize = entry->dataSize;
+    resource.rawSize = entry->rawSize;
+    resource.compressed = (entry->flags & ResourcePackEntryDeflate) != 0;
+    return true;
+}
+
+unsigned char* LoadResourceFileData(const char* fileName, int* dataSize)
+{
+    PackedResource resource;
+    if (!FindEmbeddedResource(fileName, resource))
+    {
+        return LoadFileData(fileName, dataSize);
+    }
+
+    if (resource.compressed)
+    {
+        return DecompressData(resource.data, static_cast<int>(resource.dataSize), dataSize);
+    }
+    auto* ret = static_cast<unsigned char*>(MemAlloc(static_cast<unsigned int>(resource.dataSize)));
+    if (ret != nullptr)
+    {
+        std::memcpy(ret, resource.data, resource.dataSize);
+        *dataSize = static_cast<int>(resource.dataSize);
+    }
+    return ret;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/// resource pack (src/resources.pack), see tools/resource_packer.cpp
+/// @NOTE: little-endian, all offsets are relative to the start of the pack, data is 16-byte aligned
+///
+/// | ResourcePackHeader | ResourcePackEntry[entryCount] (sorted by name) | names | data ... |
+inline constexpr char ResourcePackMagic[4] = {'N', 'C', 'R', 'P'};
+inline constexpr uint32_t ResourcePackVersion = 1;
+inline constexpr uint32_t ResourcePackDataAlignment = 16;
+
+enum ResourcePackEntryFlags : uint32_t
+{
+    ResourcePackEntryStored = 0,
+    ResourcePackEntryDeflate = 1 << 0, ///< compressed with raylib CompressData (raw deflate)
+};
+
+struct ResourcePackHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+};
+static_assert(sizeof(ResourcePackHeader) == 16);
+
+struct ResourcePackEntry
+{
+    uint32_t nameOffset; ///< null-terminated, same path as the game loads it ("resources/atlas.png")
+    uint32_t nameSize;
+    uint32_t dataOffset;
+    uint32_t dataSize; ///< size in the pack
+    uint32_t rawSize; ///< size after decompression
+    uint32_t flags;
+};
+static_assert(sizeof(ResourcePackEntry) == 24);
+
+/// Types
+struct PackedResource
+{
+    const unsigned char* data{nullptr}; ///< points into the pack (no copy)
+    size_t dataSize{0};
+    size_t rawSize{0};
+    bool compressed{false};
+};
+
+/// embedded pack, only available when built with EMBED_RESOURCES (see src/CMakeLists.txt)
+[[nodiscard]] extern bool HasEmbeddedResources();
+/// look up a file in the embedded pack, returns false when the file is not packed (load from disk)
+[[nodiscard]] extern bool FindEmbeddedResource(const char* fileName, PackedResource& resource);
+/// load file data from the embedded pack (decompressed) or from disk, free with UnloadFileData
+/// @NOTE: stored (uncompressed) entries should be used directly via FindEmbeddedResource to avoid the copy
+[[nodiscard]] extern unsigned char* LoadResourceFileData(const char* fileName, int* dataSize);
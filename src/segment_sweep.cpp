@@ -0,0 +1,221 @@
+#include "segment_sweep.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <set>
+
+/// segment from left to right (lower end first when vertical)
+struct SweepSegment
+{
+    double x1{0};
+    double y1{0};
+    double x2{0};
+    double y2{0};
+    double slope{0}; ///< infinity when vertical
+    int index{-1};
+};
+struct SweepEvent
+{
+    double x{0};
+    double y{0};
+    int segment{-1};
+    bool start{false};
+};
+
+static SweepSegment makeSweepSegment(const CrossingSegment& segment, int index)
+{
+    auto [x1, y1, x2, y2] = std::array<double, 4>{segment.start.x, segment.start.y, segment.end.x, segment.end.y};
+    if (x2 < x1 || (x2 == x1 && y2 < y1))
+    {
+        std::swap(x1, x2);
+        std::swap(y1, y2);
+    }
+    const double slope = (x1 == x2) ? std::numeric_limits<double>::infinity() : (y2 - y1) / (x2 - x1);
+    return {.x1 = x1, .y1 = y1, .x2 = x2, .y2 = y2, .slope = slope, .index = index};
+}
+
+/// order of the segments along the sweep line (at sweepX), vertical segments at their lower end
+struct SweepOrder
+{
+    const std::vector<SweepSegment>* segments{nullptr};
+    const double* sweepX{nullptr};
+
+    [[nodiscard]] double yAt(const SweepSegment& segment) const
+    {
+        return (segment.x1 == segment.x2) ? segment.y1 : segment.y1 + (*sweepX - segment.x1) * segment.slope;
+    }
+    bool operator()(int index1, int index2) const
+    {
+        const auto& segment1 = (*segments)[index1];
+        const auto& segment2 = (*segments)[index2];
+        const double y1 = yAt(segment1);
+        const double y2 = yAt(segment2);
+        if (y1 != y2)
+        {
+            return y1 < y2;
+        }
+        // same point (e.g. shared node): order after the point
+        if (segment1.slope != segment2.slope)
+        {
+            return segment1.slope < segment2.slope;
+        }
+        return index1 < index2;
+    }
+};
+
+bool AnySegmentsCross(std::span<const CrossingSegment> segments, std::pair<int, int>* crossing)
+{
+    std::vector<SweepSegment> sweepSegments;
+    sweepSegments.reserve(segments.size());
+    std::vector<SweepEvent> events;
+    events.reserve(2 * segments.size());
+    for (size_t i = 0; i < segments.size(); ++i)
+    {
+        const auto& segment = sweepSegments.emplace_back(makeSweepSegment(segments[i], static_cast<int>(i)));
+        events.push_back({.x = segment.x1, .y = segment.y1, .segment = static_cast<int>(i), .start = true});
+        events.push_back({.x = segment.x2, .y = segment.y2, .segment = static_cast<int>(i), .start = false});
+    }
+    // starts before ends at the same x, segments touching at x are both in the sweep line
+    std::sort(
+        events.begin(),
+        events.end(),
+        [](const SweepEvent& event1, const SweepEvent& event2)
+        {
+            if (event1.x != event2.x)
+            {
+                return event1.x < event2.x;
+            }
+            if (event1.start != event2.start)
+            {
+                return event1.start;
+            }
+            return event1.y < event2.y;
+        });
+
+    double sweepX = 0;
+    using SweepLine = std::set<int, SweepOrder>;
+    SweepLine sweepLine{SweepOrder{.segments = &sweepSegments, .sweepX = &sweepX}};
+    std::vector<SweepLine::iterator> positions(segments.size(), sweepLine.end());
+    const auto cross = [&](int index1, int index2)
+    {
+        if (!SegmentsCross(segments[index1], segments[index2]))
+        {
+            return false;
+        }
+        if (crossing != nullptr)
+        {
+            *crossing = std::minmax(index1, index2);
+        }
+        return true;
+    };
+
+    // the leftmost crossing is between neighbours of the sweep line (before the crossing the order doesn't change)
+    for (const auto& event : events)
+    {
+        sweepX = event.x;
+        if (event.start)
+        {
+            const auto position = sweepLine.insert(event.segment).first;
+            positions[event.segment] = position;
+            if (position != sweepLine.begin() && cross(*std::prev(position), event.segment))
+            {
+                return true;
+            }
+            if (std::next(position) != sweepLine.end() && cross(*std::next(position), event.segment))
+            {
+                return true;
+            }
+        }
+        else
+        {
+            const auto position = positions[event.segment];
+            if (position != sweepLine.begin() && std::next(position) != sweepLine.end() &&
+                cross(*std::prev(position), *std::next(position)))
+            {
+                return true;
+            }
+            sweepLine.erase(position);
+        }
+    }
+    return false;
+}
+
+void FindCrossingSegments(std::span<const CrossingSegment> segments, std::vector<std::pair<int, int>>& crossings)
+{
+    crossings.clear();
+    std::vector<SweepSegment> sweepSegments;
+    sweepSegments.reserve(segments.size());
+    for (size_t i = 0; i < segments.size(); ++i)
+    {
+        sweepSegments.push_back(makeSweepSegment(segments[i], static_cast<int>(i)));
+    }
+    std::sort(
+        sweepSegments.begin(),
+        sweepSegments.end(),
+        [](const SweepSegment& segment1, const SweepSegment& segment2) { return segment1.x1 < segment2.x1; });
+
+    // y extent of the highest segment, a segment overlapping in y starts at most that far below
+    double maxHeight = 0;
+    for (const auto& segment : sweepSegments)
+    {
+        maxHeight = std::max(maxHeight, std::abs(segment.y2 - segment.y1));
+    }
+
+    // segments overlapping the sweep line (x), ordered by their lowest y: only the ones that can overlap in y are
+    // compared, the min-heap on the end (x2) drops them when the sweep line is past their end
+    using ActiveSegments = std::multimap<double, const SweepSegment*>;
+    ActiveSegments active;
+    std::vector<ActiveSegments::iterator> activePositions(segments.size());
+    std::vector<const SweepSegment*> ends;
+    const auto laterEnd = [](const SweepSegment* segment1, const SweepSegment* segment2)
+    { return segment1->x2 > segment2->x2; };
+    for (const auto& segment : sweepSegments)
+    {
+        while (!ends.empty() && ends.front()->x2 < segment.x1)
+        {
+            active.erase(activePositions[ends.front()->index]);
+            std::pop_heap(ends.begin(), ends.end(), laterEnd);
+            ends.pop_back();
+        }
+        const double minY = std::min(segment.y1, segment.y2);
+        const double maxY = std::max(segment.y1, segment.y2);
+        for (auto other = active.lower_bound(minY - maxHeight); other != active.end() && other->first <= maxY; ++other)
+        {
+            if (std::max(other->second->y1, other->second->y2) >= minY &&
+                SegmentsCross(segments[segment.index], segments[other->second->index]))
+            {
+                crossings.push_back(std::minmax(segment.index, other->second->index));
+            }
+        }
+        activePositions[segment.index] = active.emplace(minY, &segment);
+        ends.push_back(&segment);
+        std::push_heap(ends.begin(), ends.end(), laterEnd);
+    }
+    std::sort(crossings.begin(), crossings.end());
+}
+
+void FindSegmentCrossings(
+    std::span<const CrossingSegment> segments, const CrossingSegment& segment, std::vector<int>& crossed)
+{
+    crossed.clear();
+    const float minX = std::min(segment.start.x, segment.end.x);
+    const float maxX = std::max(segment.start.x, segment.end.x);
+    const float minY = std::min(segment.start.y, segment.end.y);
+    const float maxY = std::max(segment.start.y, segment.end.y);
+    for (size_t i = 0; i < segments.size(); ++i)
+    {
+        const auto& other = segments[i];
+        // bounding boxes first
+        if (std::max(other.start.x, other.end.x) < minX || std::min(other.start.x, other.end.x) > maxX ||
+            std::max(other.start.y, other.end.y) < minY || std::min(other.start.y, other.end.y) > maxY)
+        {
+            continue;
+        }
+        if (SegmentsCross(segment, other))
+        {
+            crossed.push_back(static_cast<int>(i));
+        }
+    }
+}
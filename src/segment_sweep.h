@@ -0,0 +1,43 @@
+#pragma once
+
+#include "geometry.h"
+#include <raylib.h>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+/// crossing connections for whole wirings (bulk edits, loaded or generated graphs), O(E log E) instead of all pairs,
+/// same rule as validPreConnections: geometry::CheckCollisionLines, connections sharing a node don't cross
+/// @NOTE: the sweep expects valid nodes (validConnection): no connection through another node,
+///        only connections of the same node end at the same position
+
+/// connection line, node1/node2: nodes at the ends (-1: no node, never shared)
+struct CrossingSegment
+{
+    Vector2 start{0, 0};
+    Vector2 end{0, 0};
+    int node1{-1};
+    int node2{-1};
+};
+
+inline constexpr bool SegmentsShareNode(const CrossingSegment& segment1, const CrossingSegment& segment2)
+{
+    return (segment1.node1 != -1 && (segment1.node1 == segment2.node1 || segment1.node1 == segment2.node2)) ||
+           (segment1.node2 != -1 && (segment1.node2 == segment2.node1 || segment1.node2 == segment2.node2));
+}
+inline constexpr bool SegmentsCross(const CrossingSegment& segment1, const CrossingSegment& segment2)
+{
+    return !SegmentsShareNode(segment1, segment2) &&
+           geometry::CheckCollisionLines(segment1.start, segment1.end, segment2.start, segment2.end);
+}
+
+/// any two segments cross (Shamos-Hoey sweep line), crossing: one of the crossing pairs (indices)
+[[nodiscard]] extern bool AnySegmentsCross(
+    std::span<const CrossingSegment> segments, std::pair<int, int>* crossing = nullptr);
+/// all crossing pairs (indices, first < second), sweep over x, only segments overlapping in x and y are compared
+extern void FindCrossingSegments(
+    std::span<const CrossingSegment> segments, std::vector<std::pair<int, int>>& crossings);
+/// segments crossed by segment (indices), e.g. a new connection against the wiring
+extern void FindSegmentCrossings(
+    std::span<const CrossingSegment> segments, const CrossingSegment& segment, std::vector<int>& crossed);
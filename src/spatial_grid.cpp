@@ -0,0 +1,51 @@
+#include "spatial_grid.h"
+#include <algorithm>
+#include <cmath>
+
+void InitSpatialGrid(SpatialGrid& grid, Rectangle area, float cellSize)
+{
+    grid.area = area;
+    grid.cellSize = cellSize;
+    grid.columns = std::max(1, static_cast<int>(std::ceil(area.width / cellSize)));
+    grid.rows = std::max(1, static_cast<int>(std::ceil(area.height / cellSize)));
+    grid.cells.assign(static_cast<size_t>(grid.columns) * grid.rows, {});
+    grid.itemCells.clear();
+}
+
+void ClearSpatialGrid(SpatialGrid& grid)
+{
+    for (auto& cell : grid.cells)
+    {
+        cell.clear();
+    }
+    grid.itemCells.clear();
+}
+
+void SetSpatialGridItem(SpatialGrid& grid, uint32_t id, Vector2 position)
+{
+    const int cell = GetSpatialGridRow(grid, position.y) * grid.columns + GetSpatialGridColumn(grid, position.x);
+    if (id >= grid.itemCells.size())
+    {
+        grid.itemCells.resize(id + 1, -1);
+    }
+    if (grid.itemCells[id] == cell)
+    {
+        return;
+    }
+    RemoveSpatialGridItem(grid, id);
+    grid.cells[cell].push_back(id);
+    grid.itemCells[id] = cell;
+}
+
+void RemoveSpatialGridItem(SpatialGrid& grid, uint32_t id)
+{
+    if (id >= grid.itemCells.size() || grid.itemCells[id] == -1)
+    {
+        return;
+    }
+    // order in the cell doesn't matter
+    auto& cell = grid.cells[grid.itemCells[id]];
+    *std::find(cell.begin(), cell.end(), id) = cell.back();
+    cell.pop_back();
+    grid.itemCells[id] = -1;
+}
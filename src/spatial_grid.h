@@ -0,0 +1,126 @@
+#pragma once
+
+#include <raylib.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// uniform grid over an area (e.g. ConnectorArea), items (node indices) are stored in the cell of their position,
+/// queries only visit the cells near a point/rectangle/segment instead of all nodes (mouse picking, nodes in between)
+/// @NOTE: positions outside of the area are clamped into the border cells (still found, only slower)
+inline constexpr float SpatialGridCellSize = 40.0f; ///< a bit more than a node (2 * ActionNodeRadius)
+
+struct SpatialGrid
+{
+    Rectangle area{0, 0, 0, 0};
+    float cellSize{SpatialGridCellSize};
+    int columns{0};
+    int rows{0};
+    std::vector<std::vector<uint32_t>> cells; ///< item ids, row by row
+    std::vector<int32_t> itemCells;           ///< cell of the item (index: id), -1 when not in the grid
+};
+
+/// empty grid, cellSize > 0
+extern void InitSpatialGrid(SpatialGrid& grid, Rectangle area, float cellSize = SpatialGridCellSize);
+/// remove all items (keeps the cells)
+extern void ClearSpatialGrid(SpatialGrid& grid);
+/// add or move the item
+extern void SetSpatialGridItem(SpatialGrid& grid, uint32_t id, Vector2 position);
+extern void RemoveSpatialGridItem(SpatialGrid& grid, uint32_t id);
+
+[[nodiscard]] inline int GetSpatialGridColumn(const SpatialGrid& grid, float x)
+{
+    const float column = std::floor((x - grid.area.x) / grid.cellSize);
+    return static_cast<int>(std::clamp(column, 0.0f, static_cast<float>(grid.columns - 1)));
+}
+[[nodiscard]] inline int GetSpatialGridRow(const SpatialGrid& grid, float y)
+{
+    const float row = std::floor((y - grid.area.y) / grid.cellSize);
+    return static_cast<int>(std::clamp(row, 0.0f, static_cast<float>(grid.rows - 1)));
+}
+
+/// visit(id) all items with the position inside of rec (and some more near it, check the collision in visit),
+/// visit returns true to stop, returns true when stopped
+template<typename Visit>
+bool QuerySpatialGridRect(const SpatialGrid& grid, Rectangle rec, Visit&& visit)
+{
+    if (grid.cells.empty())
+    {
+        return false;
+    }
+    const int minColumn = GetSpatialGridColumn(grid, rec.x);
+    const int maxColumn = GetSpatialGridColumn(grid, rec.x + rec.width);
+    const int minRow = GetSpatialGridRow(grid, rec.y);
+    const int maxRow = GetSpatialGridRow(grid, rec.y + rec.height);
+    for (int row = minRow; row <= maxRow; ++row)
+    {
+        for (int column = minColumn; column <= maxColumn; ++column)
+        {
+            for (const uint32_t id : grid.cells[row * grid.columns + column])
+            {
+                if (visit(id))
+                {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+/// visit(id) all items with the position closer than distance to the segment (and some more, check in visit),
+/// only the cells along the segment are visited, visit returns true to stop, returns true when stopped
+template<typename Visit>
+bool QuerySpatialGridSegment(const SpatialGrid& grid, Vector2 start, Vector2 end, float distance, Visit&& visit)
+{
+    if (grid.cells.empty())
+    {
+        return false;
+    }
+    const int minColumn = GetSpatialGridColumn(grid, std::min(start.x, end.x) - distance);
+    const int maxColumn = GetSpatialGridColumn(grid, std::max(start.x, end.x) + distance);
+    const int minRow = GetSpatialGridRow(grid, std::min(start.y, end.y) - distance);
+    const int maxRow = GetSpatialGridRow(grid, std::max(start.y, end.y) + distance);
+
+    // skip cells (center) too far away from the segment, border cells also hold the items outside of the area
+    const float halfCell = 0.5f * grid.cellSize;
+    const float maxDistance = distance + halfCell * std::sqrt(2.0f);
+    const float dx = end.x - start.x;
+    const float dy = end.y - start.y;
+    const float lengthSqr = dx * dx + dy * dy;
+    const auto nearSegment = [&](int column, int row)
+    {
+        if (column == 0 || row == 0 || column == grid.columns - 1 || row == grid.rows - 1)
+        {
+            return true;
+        }
+        const float cx = grid.area.x + static_cast<float>(column) * grid.cellSize + halfCell;
+        const float cy = grid.area.y + static_cast<float>(row) * grid.cellSize + halfCell;
+        const float t =
+            (lengthSqr > 0.0f) ? std::clamp(((cx - start.x) * dx + (cy - start.y) * dy) / lengthSqr, 0.0f, 1.0f) : 0.0f;
+        const float px = start.x + t * dx - cx;
+        const float py = start.y + t * dy - cy;
+        return px * px + py * py <= maxDistance * maxDistance;
+    };
+
+    for (int row = minRow; row <= maxRow; ++row)
+    {
+        for (int column = minColumn; column <= maxColumn; ++column)
+        {
+            if (!nearSegment(column, row))
+            {
+                continue;
+            }
+            for (const uint32_t id : grid.cells[row * grid.columns + column])
+            {
+                if (visit(id))
+                {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
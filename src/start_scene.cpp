@@ -3,8 +3,9 @@
 
 void UpdateStartScene(GameContext& gameContext)
 {
-    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) && CheckCollisionRecs(StartButtonRect, gameContext.mouse) ||
-        IsKeyPressed(KEY_ENTER))
+    if (IsFrameMouseButtonPressed(gameContext.input, MOUSE_BUTTON_LEFT) &&
+            CheckCollisionRecs(StartButtonRect, gameContext.mouse) ||
+        IsFrameKeyPressed(gameContext.input, KEY_ENTER))
     {
         SetLevel(gameContext, StartLevel);
     }
@@ -13,10 +14,12 @@ void UpdateStartScene(GameContext& gameContext)
 void RenderStartScene(GameContext& gameContext)
 {
     // title
-    DrawTexture(
-        gameContext.logoTexture,
-        ConnectorArea.x + ConnectorArea.width / 2 - gameContext.logoTexture.width / 2,
-        ConnectorArea.y + 72,
+    QueueTextureRec(
+        gameContext.renderQueue,
+        RenderLayer::Ui,
+        gameContext.atlasTexture,
+        AtlasLogoRect,
+        {ConnectorArea.x + ConnectorArea.width / 2 - AtlasLogoRect.width / 2, ConnectorArea.y + 72},
         NeutralTintColor);
 
     const auto startButtonTextSize = MeasureTextEx(
@@ -26,8 +29,15 @@ void RenderStartScene(GameContext& gameContext)
         StartButtonTextFontSize / FontSpacingFactor);
     const auto startButtonColor =
         (CheckCollisionRecs(StartButtonRect, gameContext.mouse)) ? ButtonHoverColor : ButtonColor;
-    DrawRectangleLinesEx(StartButtonRect, ButtonLineThick, startButtonColor);
-    DrawTextEx(
+    QueueRectangleLinesEx(
+        gameContext.renderQueue,
+        RenderLayer::Ui,
+        StartButtonRect,
+        ButtonLineThick,
+        startButtonColor);
+    QueueTextEx(
+        gameContext.renderQueue,
+        RenderLayer::Ui,
         gameContext.font,
         WelcomeStartButtonText,
         {StartButtonRect.x + StartButtonRect.width / 2 - startButtonTextSize.x / 2,
@@ -42,7 +52,9 @@ void RenderStartScene(GameContext& gameContext)
         WelcomeFooterText,
         WelcomeFooterTextFontSize,
         WelcomeFooterTextFontSize / FontSpacingFactor);
-    DrawTextEx(
+    QueueTextEx(
+        gameContext.renderQueue,
+        RenderLayer::Ui,
         gameContext.font,
         WelcomeFooterText,
         {WelcomeFooterTextArea.x + WelcomeFooterTextArea.width / 2 - footerTextSize.x / 2, WelcomeFooterTextArea.y},
@@ -53,7 +65,9 @@ void RenderStartScene(GameContext& gameContext)
     // show welcome text
     const auto welcomeTextSize =
         MeasureTextEx(gameContext.font, WelcomeText, WelcomeTextFontSize, WelcomeTextFontSize / FontSpacingFactor);
-    DrawTextEx(
+    QueueTextEx(
+        gameContext.renderQueue,
+        RenderLayer::Ui,
         gameContext.font,
         WelcomeText,
         {WelcomeTextArea.x + LevelArea.width / 2 - welcomeTextSize.x / 2, WelcomeTextArea.y},
@@ -61,6 +75,33 @@ void RenderStartScene(GameContext& gameContext)
         WelcomeTextFontSize / FontSpacingFactor,
         TextFontColor);
 
-    DrawTexture(gameContext.instruction1Texture, HelpInstruction1Area.x, HelpInstruction1Area.y, NeutralTintColor);
-    DrawTexture(gameContext.instruction2Texture, HelpInstruction2Area.x, HelpInstruction2Area.y, NeutralTintColor);
-}
\ No newline at end of file
+    QueueTextureRec(
+        gameContext.renderQueue,
+        RenderLayer::Ui,
+        gameContext.atlasTexture,
+        AtlasInstruction1Rect,
+        {HelpInstruction1Area.x, HelpInstruction1Area.y},
+        NeutralTintColor);
+    QueueTextureRec(
+        gameContext.renderQueue,
+        RenderLayer::Ui,
+        gameContext.atlasTexture,
+        AtlasInstruction2Rect,
+        {HelpInstruction2Area.x, HelpInstruction2Area.y},
+        NeutralTintColor);
+}
+void RenderLoadingScene(GameContext& gameContext)
+{
+    const auto loadingTextSize =
+        MeasureTextEx(gameContext.font, LoadingText, LoadingTextFontSize, LoadingTextFontSize / FontSpacingFactor);
+    QueueTextEx(
+        gameContext.renderQueue,
+        RenderLayer::Ui,
+        gameContext.font,
+        LoadingText,
+        {ConnectorArea.x + ConnectorArea.width / 2 - loadingTextSize.x / 2,
+         ConnectorArea.y + ConnectorArea.height / 2 - loadingTextSize.y / 2},
+        LoadingTextFontSize,
+        LoadingTextFontSize / FontSpacingFactor,
+        TextFontColor);
+}
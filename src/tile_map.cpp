@@ -0,0 +1,115 @@
+#include "tile_map.h"
+#include <algorithm>
+
+void InitTileMap(TileMap& map, int width, int height)
+{
+    map.width = std::max(width, 0);
+    map.height = std::max(height, 0);
+    map.chunksX = (map.width + TileChunkSize - 1) / TileChunkSize;
+    map.chunksY = (map.height + TileChunkSize - 1) / TileChunkSize;
+    map.chunks.clear();
+    map.chunks.resize(static_cast<size_t>(map.chunksX) * map.chunksY);
+}
+
+void SetTile(TileMap& map, int x, int y, TileSet tile)
+{
+    if (x < 0 || y < 0 || x >= map.width || y >= map.height)
+    {
+        return;
+    }
+    auto& chunk = map.chunks[(y / TileChunkSize) * map.chunksX + (x / TileChunkSize)];
+    if (chunk == nullptr)
+    {
+        if (static_cast<uint8_t>(tile) == EmptyTile)
+        {
+            return;
+        }
+        chunk = std::make_unique<TileChunk>(EmptyTileChunk);
+    }
+    const int row = y % TileChunkSize;
+    const uint32_t bit = 1u << (x % TileChunkSize);
+    chunk->tiles[row * TileChunkSize + (x % TileChunkSize)] = static_cast<uint8_t>(tile);
+    const auto setBit = [&](std::array<uint32_t, TileChunkSize>& mask, bool value)
+    { mask[row] = value ? (mask[row] | bit) : (mask[row] & ~bit); };
+    setBit(chunk->voidMask, tile == TileSet::Void1 || tile == TileSet::Void2);
+    setBit(chunk->doorMask, tile == TileSet::Door);
+    setBit(chunk->floorMask, tile == TileSet::Floor || tile == TileSet::Key);
+}
+
+uint32_t GetTileMaskRow(const TileMap& map, TileMask mask, int x, int y)
+{
+    const uint32_t outside = (mask == TileMask::Void) ? ~uint32_t{0} : 0;
+    if (static_cast<unsigned>(y) >= static_cast<unsigned>(map.height))
+    {
+        return outside;
+    }
+    // chunk masks beyond the map width are void already (EmptyTileChunk)
+    const auto chunkRow = [&](int chunkX)
+    {
+        return (chunkX >= 0 && chunkX < map.chunksX)
+                   ? GetTileMask(*GetTileChunk(map, chunkX, y / TileChunkSize), mask)[y % TileChunkSize]
+                   : outside;
+    };
+    const int chunkX = (x >= 0) ? x / TileChunkSize : (x - TileChunkSize + 1) / TileChunkSize;
+    const int offset = x - chunkX * TileChunkSize;
+    const uint32_t low = chunkRow(chunkX) >> offset;
+    return (offset == 0) ? low : (low | (chunkRow(chunkX + 1) << (TileChunkSize - offset)));
+}
+
+void TestTileMasks(
+    const TileMap& map, TileMask mask, std::span<const TilePosition> positions, std::span<uint8_t> results)
+{
+    const size_t count = std::min(positions.size(), results.size());
+    for (size_t i = 0; i < count; ++i)
+    {
+        results[i] = TestTileMask(map, mask, positions[i]) ? 1 : 0;
+    }
+}
+
+void LoadTileMap(TileMap& map, const Level_t& mapData)
+{
+    InitTileMap(map, LevelMapWidth, LevelMapHeight);
+    for (int y = 0; y < LevelMapHeight; ++y)
+    {
+        for (int x = 0; x < LevelMapWidth; ++x)
+        {
+            SetTile(map, x, y, static_cast<TileSet>(mapData[y][x]));
+        }
+    }
+}
+
+void CopyTileMap(TileMap& map, const TileMap& other)
+{
+    InitTileMap(map, other.width, other.height);
+    for (size_t i = 0; i < other.chunks.size(); ++i)
+    {
+        if (other.chunks[i] != nullptr)
+        {
+            map.chunks[i] = std::make_unique<TileChunk>(*other.chunks[i]);
+        }
+    }
+}
+
+void LoadLevelTileMap(TileMap& map, const LevelData& level)
+{
+    if (level.tileMap != nullptr)
+    {
+        CopyTileMap(map, *level.tileMap);
+    }
+    else if (level.mapData != nullptr)
+    {
+        LoadTileMap(map, *level.mapData);
+    }
+    else
+    {
+        InitTileMap(map, 0, 0);
+    }
+}
+
+TileMapCamera FollowTileMapCamera(const TileMap& map, int playerX, int playerY)
+{
+    return {
+        .x = std::clamp(playerX - LevelViewWidth / 2, 0, std::max(map.width - LevelViewWidth, 0)),
+        .y = std::clamp(playerY - LevelViewHeight / 2, 0, std::max(map.height - LevelViewHeight, 0)),
+    };
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "constants.h"
+#include "types.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+/// tile map of any size, stored in chunks (TileChunkSize x TileChunkSize tiles, 8-bit TileSet)
+/// @NOTE: chunks that are all void are not allocated (empty space in large maps), outside of the map is void
+inline constexpr int TileChunkSize = 32;
+inline constexpr uint8_t EmptyTile = static_cast<uint8_t>(TileSet::Void1);
+/// max. width and height of a level map (level files), tile indices (width * height) fit into int
+inline constexpr int MaxLevelMapSize = 4096;
+
+/// visible tiles in LevelMapArea
+inline constexpr int LevelViewWidth = static_cast<int>(LevelMapArea.width) / LevelTileWidth;
+inline constexpr int LevelViewHeight = static_cast<int>(LevelMapArea.height) / LevelTileHeight;
+
+/// enums
+enum class TileMask : uint8_t
+{
+    Void, ///< Void1, Void2 and outside of the map
+    Door,
+    Floor, ///< walkable (Floor, Key)
+};
+
+/// Types
+/// tiles and packed tile masks (one bit per tile, bit: x % TileChunkSize), masks are updated by SetTile
+struct TileChunk
+{
+    std::array<uint8_t, TileChunkSize * TileChunkSize> tiles{};
+    std::array<uint32_t, TileChunkSize> voidMask{};
+    std::array<uint32_t, TileChunkSize> doorMask{};
+    std::array<uint32_t, TileChunkSize> floorMask{};
+};
+static_assert(TileChunkSize == 32, "tile mask rows are uint32_t");
+
+inline constexpr TileChunk MakeEmptyTileChunk()
+{
+    TileChunk ret;
+    ret.tiles.fill(EmptyTile);
+    ret.voidMask.fill(~uint32_t{0});
+    return ret;
+}
+/// not allocated chunks (all void)
+inline constexpr TileChunk EmptyTileChunk = MakeEmptyTileChunk();
+
+struct TileMap
+{
+    int width{0};
+    int height{0};
+    int chunksX{0};
+    int chunksY{0};
+    std::vector<std::unique_ptr<TileChunk>> chunks; ///< row by row, nullptr: all EmptyTile
+};
+
+/// first visible tile (top left) in LevelMapArea
+struct TileMapCamera
+{
+    int x{0};
+    int y{0};
+};
+
+extern void InitTileMap(TileMap& map, int width, int height);
+extern void SetTile(TileMap& map, int x, int y, TileSet tile);
+/// small (fixed size) level map (compiled-in levels, level pack)
+extern void LoadTileMap(TileMap& map, const Level_t& mapData);
+extern void CopyTileMap(TileMap& map, const TileMap& other);
+/// map of the level (mapData or tileMap)
+extern void LoadLevelTileMap(TileMap& map, const LevelData& level);
+
+/// chunk (inside the map), EmptyTileChunk when not allocated
+[[nodiscard]] inline const TileChunk* GetTileChunk(const TileMap& map, int chunkX, int chunkY)
+{
+    const TileChunk* chunk = map.chunks[chunkY * map.chunksX + chunkX].get();
+    return (chunk != nullptr) ? chunk : &EmptyTileChunk;
+}
+[[nodiscard]] inline bool IsInsideTileMap(const TileMap& map, TilePosition position)
+{
+    // negative positions wrap around (one compare per axis)
+    return (static_cast<unsigned>(position.x) < static_cast<unsigned>(map.width)) &
+           (static_cast<unsigned>(position.y) < static_cast<unsigned>(map.height));
+}
+[[nodiscard]] inline TileSet GetTile(const TileMap& map, int x, int y)
+{
+    if (!IsInsideTileMap(map, {x, y}))
+    {
+        return static_cast<TileSet>(EmptyTile);
+    }
+    const TileChunk* chunk = GetTileChunk(map, x / TileChunkSize, y / TileChunkSize);
+    return static_cast<TileSet>(chunk->tiles[(y % TileChunkSize) * TileChunkSize + (x % TileChunkSize)]);
+}
+
+[[nodiscard]] inline const std::array<uint32_t, TileChunkSize>& GetTileMask(const TileChunk& chunk, TileMask mask)
+{
+    switch (mask)
+    {
+        case TileMask::Void: break;
+        case TileMask::Door: return chunk.doorMask;
+        case TileMask::Floor: return chunk.floorMask;
+    }
+    return chunk.voidMask;
+}
+/// tile mask bit at position (outside of the map is void)
+[[nodiscard]] inline bool TestTileMask(const TileMap& map, TileMask mask, TilePosition position)
+{
+    if (!IsInsideTileMap(map, position))
+    {
+        return mask == TileMask::Void;
+    }
+    const TileChunk* chunk = GetTileChunk(map, position.x / TileChunkSize, position.y / TileChunkSize);
+    return ((GetTileMask(*chunk, mask)[position.y % TileChunkSize] >> (position.x % TileChunkSize)) & 1u) != 0;
+}
+[[nodiscard]] inline bool IsVoidAt(const TileMap& map, TilePosition position)
+{
+    return TestTileMask(map, TileMask::Void, position);
+}
+[[nodiscard]] inline bool IsDoorAt(const TileMap& map, TilePosition position)
+{
+    return TestTileMask(map, TileMask::Door, position);
+}
+/// 32 tiles of a row at once (bit i: tile x + i), outside of the map is void, for batch tests
+[[nodiscard]] extern uint32_t GetTileMaskRow(const TileMap& map, TileMask mask, int x, int y);
+/// test many positions (solver, batch simulation), results[i]: tile mask bit at positions[i]
+extern void TestTileMasks(
+    const TileMap& map, TileMask mask, std::span<const TilePosition> positions, std::span<uint8_t> results);
+
+/// camera follows the player (centered), stays inside the map
+[[nodiscard]] extern TileMapCamera FollowTileMapCamera(const TileMap& map, int playerX, int playerY);
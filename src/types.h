@@ -4,12 +4,15 @@
 #include <raylib.h>
 #include <array>
 #include <cstdint>
+#include <span>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 /// enums
 enum class GameState
 {
+    Loading, ///< decoding assets, see asset_loader.h
     Start,
     NodesMain,
     CharacterMain,
@@ -58,6 +61,41 @@ enum class ConnectorAction : int
     MovementUp = 3,
     Jump = 4,
 };
+// guide lines (showHelp2) when a level starts
+enum class LevelGuidelines : uint8_t
+{
+    Keep, ///< keep the current setting
+    Suggest, ///< show, unless the player toggled them (manuelHelp)
+    Force, ///< always show (tutorial)
+};
+// connection rules of a level (ConnectionRules), bit flags
+enum class ConnectionRule : uint8_t
+{
+    NodeTypes = 1 << 0, ///< only key - action and action - action connections
+    NodesInBetween = 1 << 1, ///< no node on the connection
+    Crossings = 1 << 2, ///< connections don't cross (unless they share a node)
+    LevelConnections = 1 << 3, ///< max. connections in the level (maxNodeConnections)
+    ActionsPerKey = 1 << 4, ///< max. actions of a key bind (maxActionsPerKey)
+    KeysPerAction = 1 << 5, ///< max. keys connected to an action (ConnectionRules::maxKeysPerAction)
+    DirectActionsPerKey = 1 << 6, ///< max. actions directly connected to a key (maxDirectActionsPerKey)
+};
+inline constexpr int ConnectionRuleCount = 7;
+inline constexpr uint8_t AllConnectionRules = (1u << ConnectionRuleCount) - 1u;
+[[nodiscard]] inline constexpr bool HasConnectionRule(uint8_t rules, ConnectionRule rule)
+{
+    return (rules & static_cast<uint8_t>(rule)) != 0;
+}
+/// active rules and their parameters, the connections of a level are validated with these rules
+struct ConnectionRules
+{
+    uint8_t rules{AllConnectionRules}; ///< ConnectionRule flags
+    int maxConnectionsPerNode{MaxNodeConnections}; ///< always active, at most MaxNodeConnections
+    int maxKeysPerAction{1};
+    int maxDirectActionsPerKey{1};
+
+    constexpr bool operator==(const ConnectionRules&) const = default;
+};
+inline constexpr ConnectionRules DefaultConnectionRules{};
 enum class ControlIcons : int
 {
     // same as ConnectorAction
@@ -69,6 +107,13 @@ enum class ControlIcons : int
 };
 
 /// Types
+/// tile coordinates in the level map
+struct TilePosition
+{
+    int x{0};
+    int y{0};
+};
+
 struct NodeData
 {
     Vector2 position{0, 0};
@@ -95,6 +140,15 @@ struct ConnectorNode
         connected_actions.reserve(MaxIndirectConnections);
     }
 };
+/// preview lines of a key (guide lines), from the player along the actions of the key
+struct KeyPreview
+{
+    ConnectorKey key{ConnectorKey::NONE};
+    const std::vector<ConnectorAction>* actions{nullptr}; ///< keyBinds
+    std::vector<std::pair<Vector2, Vector2>> lines; ///< only lines ending in the LevelMapArea
+    Vector2 textPosition{0, 0}; ///< start of the last line
+    Vector2 textDirection{1, 1};
+};
 
 inline constexpr void setActionNode(ConnectorNode& node, Vector2 pos, ConnectorAction action)
 {
@@ -141,11 +195,55 @@ inline constexpr NodeData KeyNode(Vector2 pos, ConnectorKey key)
     };
 }
 
+/// tile step of an action, direction is the facing direction (jump), updated by movement
+inline constexpr TilePosition ActionTileStep(ConnectorAction action, CharacterDirection& direction)
+{
+    switch (action)
+    {
+        case ConnectorAction::NONE: break;
+        case ConnectorAction::MovementRight: direction = CharacterDirection::Right; return {1, 0};
+        case ConnectorAction::MovementLeft: direction = CharacterDirection::Left; return {-1, 0};
+        case ConnectorAction::MovementDown: direction = CharacterDirection::Down; return {0, 1};
+        case ConnectorAction::MovementUp: direction = CharacterDirection::Up; return {0, -1};
+        case ConnectorAction::Jump:
+            switch (direction)
+            {
+                case CharacterDirection::Right: return {JumpFactor, 0};
+                case CharacterDirection::Left: return {-JumpFactor, 0};
+                case CharacterDirection::Up: return {0, -JumpFactor};
+                case CharacterDirection::Down: return {0, JumpFactor};
+            }
+            break;
+    }
+    return {0, 0};
+}
+inline constexpr void MoveTile(TilePosition& position, CharacterDirection& direction, ConnectorAction action)
+{
+    const TilePosition step = ActionTileStep(action, direction);
+    position.x += step.x;
+    position.y += step.y;
+}
+
 using LevelLine_t = std::array<int, LevelMapWidth>;
 using Level_t = std::array<LevelLine_t, LevelMapHeight>;
 
 using GameLevelNodes = std::array<ConnectorNode, MaxNodesInLevel>;
 
+struct TileMap;
+/// everything SetLevel needs to start a level (compiled-in level or level pack)
+struct LevelData
+{
+    const Level_t* mapData{nullptr};
+    const TileMap* tileMap{nullptr}; ///< maps of any size (level files), instead of mapData, see tile_map.h
+    std::span<const NodeData> nodesData;
+    Vector2 characterStartTilesPosition{0, 0};
+    CharacterDirection characterStartDirection{CharacterDirection::Right};
+    int maxNodeConnections{0};
+    int maxActionsPerKey{0};
+    LevelGuidelines guidelines{LevelGuidelines::Keep};
+    ConnectionRules connectionRules{DefaultConnectionRules};
+};
+
 template<size_t N>
     requires(N <= MaxNodesInLevel)
 auto CreateLevelNodes(const std::array<NodeData, N>& data)
@@ -162,4 +260,17 @@ auto CreateLevelNodes(const std::array<NodeData, N>& data)
         ret[i].index = static_cast<int>(i);
     }
     return ret;
-}
\ No newline at end of file
+}
+inline GameLevelNodes CreateLevelNodes(std::span<const NodeData> data)
+{
+    GameLevelNodes ret;
+    for (size_t i = 0; i < data.size() && i < ret.size(); ++i)
+    {
+        ret[i].data = data[i];
+    }
+    for (size_t i = 0; i < ret.size(); ++i)
+    {
+        ret[i].index = static_cast<int>(i);
+    }
+    return ret;
+}
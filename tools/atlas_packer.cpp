@@ -0,0 +1,186 @@
+/*******************************************************************************************
+ *
+ *   atlas_packer - packs sprite sheets into one texture atlas
+ *
+ *   Usage: atlas_packer <atlas.png> <atlas.h> <image.png>...
+ *
+ *   Writes the atlas image and a header with one constexpr source rectangle per input image,
+ *   named after the file (icons-control.png -> AtlasIconsControlRect).
+ *
+ ********************************************************************************************/
+
+#include <raylib.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+inline constexpr int AtlasPackerWidth = 512;
+inline constexpr int AtlasPackerPadding = 1;
+
+struct AtlasEntry
+{
+    std::string name;
+    std::string rectName;
+    Image image{};
+    Rectangle rect{0, 0, 0, 0};
+};
+struct AtlasShelf
+{
+    int y{0};
+    int height{0};
+    int width{0}; ///< used width
+};
+
+static std::string rectNameFromFile(const char* fileName)
+{
+    std::string ret = "Atlas";
+    bool upper = true;
+    for (const char* c = GetFileNameWithoutExt(fileName); *c != '\0'; ++c)
+    {
+        if (*c == '-' || *c == '_' || *c == ' ')
+        {
+            upper = true;
+            continue;
+        }
+        ret += (upper) ? static_cast<char>(std::toupper(*c)) : *c;
+        upper = false;
+    }
+    return ret + "Rect";
+}
+
+static int nextPowerOfTwo(int value)
+{
+    int ret = 1;
+    while (ret < value)
+    {
+        ret *= 2;
+    }
+    return ret;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 4)
+    {
+        fprintf(stderr, "usage: %s <atlas.png> <atlas.h> <image.png>...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    SetTraceLogLevel(LOG_WARNING);
+
+    const char* outputImageFileName = argv[1];
+    const char* outputHeaderFileName = argv[2];
+
+    std::vector<AtlasEntry> entries;
+    for (int i = 3; i < argc; ++i)
+    {
+        AtlasEntry entry;
+        entry.name = GetFileName(argv[i]);
+        entry.rectName = rectNameFromFile(argv[i]);
+        entry.image = LoadImage(argv[i]);
+        if (entry.image.data == nullptr)
+        {
+            fprintf(stderr, "failed to load image: %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+        if (entry.image.width + AtlasPackerPadding > AtlasPackerWidth)
+        {
+            fprintf(stderr, "image too wide for atlas: %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+        ImageFormat(&entry.image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        entries.push_back(entry);
+    }
+
+    // pack: tallest first into the first shelf with enough space (deterministic, sorted by name on same height)
+    std::sort(
+        entries.begin(),
+        entries.end(),
+        [](const AtlasEntry& a, const AtlasEntry& b)
+        {
+            if (a.image.height != b.image.height)
+            {
+                return a.image.height > b.image.height;
+            }
+            return a.name < b.name;
+        });
+    std::vector<AtlasShelf> shelves;
+    int usedHeight = 0;
+    for (auto& entry : entries)
+    {
+        const int width = entry.image.width + AtlasPackerPadding;
+        const int height = entry.image.height + AtlasPackerPadding;
+        auto shelf = std::find_if(
+            shelves.begin(),
+            shelves.end(),
+            [&](const AtlasShelf& s) { return s.height >= height && s.width + width <= AtlasPackerWidth; });
+        if (shelf == shelves.end())
+        {
+            shelves.push_back({.y = usedHeight, .height = height, .width = 0});
+            usedHeight += height;
+            shelf = std::prev(shelves.end());
+        }
+        entry.rect = {
+            static_cast<float>(shelf->width),
+            static_cast<float>(shelf->y),
+            static_cast<float>(entry.image.width),
+            static_cast<float>(entry.image.height)};
+        shelf->width += width;
+    }
+
+    const int atlasHeight = nextPowerOfTwo(usedHeight);
+    Image atlas = GenImageColor(AtlasPackerWidth, atlasHeight, BLANK);
+    for (const auto& entry : entries)
+    {
+        ImageDraw(
+            &atlas,
+            entry.image,
+            {0, 0, static_cast<float>(entry.image.width), static_cast<float>(entry.image.height)},
+            entry.rect,
+            WHITE);
+    }
+    const bool exported = ExportImage(atlas, outputImageFileName);
+    UnloadImage(atlas);
+    if (!exported)
+    {
+        fprintf(stderr, "failed to export atlas: %s\n", outputImageFileName);
+        return EXIT_FAILURE;
+    }
+
+    // header, sorted by name (stable output)
+    std::sort(entries.begin(), entries.end(), [](const AtlasEntry& a, const AtlasEntry& b) { return a.name < b.name; });
+    FILE* header = fopen(outputHeaderFileName, "w");
+    if (header == nullptr)
+    {
+        fprintf(stderr, "failed to write header: %s\n", outputHeaderFileName);
+        return EXIT_FAILURE;
+    }
+    fprintf(header, "#pragma once\n\n");
+    fprintf(header, "// generated by tools/atlas_packer from src/resources, do not edit\n\n");
+    fprintf(header, "#include <raylib.h>\n\n");
+    fprintf(header, "inline constexpr const char* AtlasFileName = \"%s\";\n", GetFileName(outputImageFileName));
+    fprintf(header, "inline constexpr int AtlasWidth = %d;\n", AtlasPackerWidth);
+    fprintf(header, "inline constexpr int AtlasHeight = %d;\n\n", atlasHeight);
+    for (const auto& entry : entries)
+    {
+        fprintf(
+            header,
+            "inline constexpr Rectangle %s{%d, %d, %d, %d}; // %s\n",
+            entry.rectName.c_str(),
+            static_cast<int>(entry.rect.x),
+            static_cast<int>(entry.rect.y),
+            static_cast<int>(entry.rect.width),
+            static_cast<int>(entry.rect.height),
+            entry.name.c_str());
+    }
+    fclose(header);
+
+    for (auto& entry : entries)
+    {
+        UnloadImage(entry.image);
+    }
+
+    return EXIT_SUCCESS;
+}
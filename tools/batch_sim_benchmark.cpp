@@ -0,0 +1,111 @@
+/*******************************************************************************************
+ *
+ *   batch_sim_benchmark - batch simulation (src/batch_sim.h) vs. the scalar path
+ *
+ *   Usage: batch_sim_benchmark [states] [steps] [level]
+ *
+ *   Runs random action sequences on a compiled-in level, checks that both paths end in the same
+ *   states and prints the simulated character steps per second. Both paths stop when no character is
+ *   alive, only the steps that ran are counted.
+ *
+ ********************************************************************************************/
+
+#include <raylib.h>
+#include "batch_sim.h"
+#include "levels.h"
+#include "tile_map.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+int main(int argc, char** argv)
+{
+    const size_t states = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1024;
+    const size_t steps = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 16;
+    const int level = (argc > 3) ? std::atoi(argv[3]) : 1;
+    const LevelData* levelData = GetBuiltinLevel(level);
+    if (levelData == nullptr || states == 0 || steps == 0)
+    {
+        fprintf(stderr, "usage: %s [states] [steps] [level 1-%d]\n", argv[0], MaxLevels);
+        return EXIT_FAILURE;
+    }
+    SetTraceLogLevel(LOG_WARNING);
+
+    TileMap tileMap;
+    LoadLevelTileMap(tileMap, *levelData);
+    BatchSimMap map;
+    InitBatchSimMap(map, tileMap);
+    const TilePosition start{
+        static_cast<int>(levelData->characterStartTilesPosition.x),
+        static_cast<int>(levelData->characterStartTilesPosition.y)};
+
+    // step-major action sequences (see RunBatchSim)
+    std::mt19937 random{42};
+    std::uniform_int_distribution<int> randomAction{
+        static_cast<int>(ConnectorAction::NONE), static_cast<int>(ConnectorAction::Jump)};
+    std::vector<ConnectorAction> actions(states * steps);
+    for (auto& action : actions)
+    {
+        action = static_cast<ConnectorAction>(randomAction(random));
+    }
+
+    // repeat until the measurement is long enough, run returns the steps that ran (early out)
+    constexpr auto MinDuration = std::chrono::milliseconds(200);
+    size_t stepsRun = 0;
+    const auto measure = [&](BatchSimState& state, auto&& run)
+    {
+        size_t characterSteps = 0;
+        const auto begin = BenchmarkClock::now();
+        auto duration = BenchmarkClock::duration::zero();
+        do
+        {
+            ResetBatchSim(state, states, start, levelData->characterStartDirection);
+            stepsRun = run(state);
+            characterSteps += stepsRun * states;
+            duration = BenchmarkClock::now() - begin;
+        } while (duration < MinDuration);
+        return static_cast<double>(characterSteps) / std::chrono::duration<double>(duration).count();
+    };
+
+    BatchSimState batchState;
+    const double batchRate =
+        measure(batchState, [&](BatchSimState& state) { return RunBatchSim(map, state, actions); });
+    const size_t batchStepsRun = stepsRun;
+    BatchSimState scalarState;
+    const double scalarRate = measure(
+        scalarState,
+        [&](BatchSimState& state)
+        {
+            // same early out as RunBatchSim
+            size_t step = 0;
+            while (step < steps)
+            {
+                StepBatchSimScalar(tileMap, state, std::span{actions}.subspan(step * states, states));
+                ++step;
+                if (CountBatchSimStatus(state, BatchSimStatus::Alive) == 0)
+                {
+                    break;
+                }
+            }
+            return step;
+        });
+
+    if (batchStepsRun != stepsRun || batchState.x != scalarState.x || batchState.y != scalarState.y ||
+        batchState.direction != scalarState.direction || batchState.status != scalarState.status)
+    {
+        fprintf(stderr, "batch simulation differs from the scalar path\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("level %d, %zu states, %zu of %zu steps run (%d lanes)\n", level, states, stepsRun, steps, BatchSimLanes);
+    printf("  won: %zu, dead: %zu\n",
+           CountBatchSimStatus(batchState, BatchSimStatus::Won),
+           CountBatchSimStatus(batchState, BatchSimStatus::Dead));
+    printf("  batch:  %12.0f steps/s\n", batchRate);
+    printf("  scalar: %12.0f steps/s (%.2fx)\n", scalarRate, batchRate / scalarRate);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,23 @@
+# converts the resource pack into a C++ source file (byte array), runs as script: cmake -DINPUT=... -DOUTPUT=... -P
+# @NOTE: plain CMake, so it also works when cross-compiling (Web)
+
+if(NOT INPUT OR NOT OUTPUT)
+  message(FATAL_ERROR "usage: cmake -DINPUT=<resources.pack> -DOUTPUT=<resource_pack_data.cpp> -P embed_resource_pack.cmake")
+endif()
+
+file(READ ${INPUT} pack_hex HEX)
+# 32 bytes per line (4 bytes per word, CMake regex has no {n})
+set(byte "[0-9a-f][0-9a-f]")
+string(REGEX REPLACE "(${byte}${byte}${byte}${byte})" "\\1 " pack_hex "${pack_hex}")
+set(word "[0-9a-f]+ ")
+string(REGEX REPLACE "(${word}${word}${word}${word}${word}${word}${word}${word})" "\\1\n" pack_hex "${pack_hex}")
+string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," pack_hex "${pack_hex}")
+string(REPLACE " " "" pack_hex "${pack_hex}")
+
+file(
+  WRITE ${OUTPUT}
+  "// generated by tools/embed_resource_pack.cmake from resources.pack, do not edit\n"
+  "#include <cstddef>\n\n"
+  "// see resource_pack.cpp\n"
+  "alignas(16) extern const unsigned char ResourcePackData[] = {\n${pack_hex}\n};\n"
+  "extern const size_t ResourcePackDataSize = sizeof(ResourcePackData);\n")
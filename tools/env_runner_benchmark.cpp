@@ -0,0 +1,71 @@
+/*******************************************************************************************
+ *
+ *   env_runner_benchmark - steps many game environments (src/env_runner.h) with random actions
+ *
+ *   Usage: env_runner_benchmark [environments] [steps] [threads] [level]
+ *
+ *   Prints environment steps per second and the finished episodes (won/dead/truncated).
+ *
+ ********************************************************************************************/
+
+#include <raylib.h>
+#include "env_runner.h"
+#include "levels.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+    const size_t envCount = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 4096;
+    const size_t steps = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 1000;
+    const int threads = (argc > 3) ? std::atoi(argv[3]) : 0;
+    const int level = (argc > 4) ? std::atoi(argv[4]) : 1;
+    const LevelData* levelData = GetBuiltinLevel(level);
+    EnvLevel envLevel;
+    if (levelData == nullptr || envCount == 0 || !InitEnvLevel(envLevel, *levelData))
+    {
+        fprintf(stderr, "usage: %s [environments] [steps] [threads] [level 1-%d]\n", argv[0], MaxLevels);
+        return EXIT_FAILURE;
+    }
+    SetTraceLogLevel(LOG_WARNING);
+
+    EnvRunner runner;
+    StartEnvRunner(runner, envLevel, envCount, threads);
+
+    // actions are generated up front (not measured), a few batches are reused
+    constexpr size_t ActionBatches = 16;
+    std::mt19937 random{42};
+    std::uniform_int_distribution<int> randomAction{0, EnvActionCount - 1};
+    std::vector<int> actions(ActionBatches * envCount);
+    for (auto& action : actions)
+    {
+        action = randomAction(random);
+    }
+
+    size_t won = 0;
+    size_t dead = 0;
+    size_t truncated = 0;
+    const auto begin = std::chrono::steady_clock::now();
+    for (size_t step = 0; step < steps; ++step)
+    {
+        StepEnvRunner(runner, std::span{actions}.subspan((step % ActionBatches) * envCount, envCount));
+        for (size_t i = 0; i < envCount; ++i)
+        {
+            if (runner.dones[i] != 0)
+            {
+                won += runner.rewards[i] > 0.0f;
+                dead += runner.rewards[i] <= EnvDeathReward;
+                truncated += runner.rewards[i] > EnvDeathReward && runner.rewards[i] <= 0.0f;
+            }
+        }
+    }
+    const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - begin;
+
+    printf("level %d, %zu environments, %zu steps, %zu workers\n", level, envCount, steps, runner.workers.size() + 1);
+    printf("  episodes: %zu won, %zu dead, %zu truncated\n", won, dead, truncated);
+    printf("  %.0f steps/s\n", static_cast<double>(envCount * steps) / duration.count());
+    return EXIT_SUCCESS;
+}
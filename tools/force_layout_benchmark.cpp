@@ -0,0 +1,150 @@
+/*******************************************************************************************
+ *
+ *   force_layout_benchmark - force-directed auto-layout of large sandbox graphs (src/force_layout.h)
+ *
+ *   Usage: force_layout_benchmark [nodes] [seed]
+ *
+ *   The nodes of a generated sandbox graph (src/node_pool.h) are scattered randomly, then laid out again
+ *   (ForceLayoutWorker), crossings, nodes too close and nodes outside the area are counted before and after.
+ *   The time per step with the Barnes-Hut quadtree is compared with all pairs (theta 0).
+ *
+ ********************************************************************************************/
+
+#include <raylib.h>
+#include "force_layout.h"
+#include "geometry.h"
+#include "node_pool.h"
+#include "segment_sweep.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+inline constexpr int ComparedSteps = 5;
+
+struct LayoutStats
+{
+    size_t crossings{0};
+    size_t tooClose{0};
+    size_t outside{0};
+};
+
+static LayoutStats layoutStats(const NodePool& pool, Rectangle area, float nodeSpacing)
+{
+    LayoutStats ret;
+    std::vector<CrossingSegment> segments;
+    GetPoolLinkSegments(pool, segments);
+    std::vector<std::pair<int, int>> crossings;
+    FindCrossingSegments(segments, crossings);
+    ret.crossings = crossings.size();
+
+    for (uint32_t i = 0; i < pool.nodes.size(); ++i)
+    {
+        const auto& node = pool.nodes[i];
+        if (!node.alive)
+        {
+            continue;
+        }
+        const Vector2 position = node.data.position;
+        const auto radius = static_cast<float>(geometry::NodeRadius(node.data));
+        if (position.x < area.x + radius || position.x > area.x + area.width - radius ||
+            position.y < area.y + radius || position.y > area.y + area.height - radius)
+        {
+            ++ret.outside;
+        }
+        const float reach = 2 * MaxNodeRadius + nodeSpacing;
+        QuerySpatialGridRect(
+            pool.grid,
+            {position.x - reach, position.y - reach, 2 * reach, 2 * reach},
+            [&](uint32_t index)
+            {
+                const auto& other = pool.nodes[index];
+                const float dx = other.data.position.x - position.x;
+                const float dy = other.data.position.y - position.y;
+                const float minDistance = radius + static_cast<float>(geometry::NodeRadius(other.data));
+                if (index > i && dx * dx + dy * dy < minDistance * minDistance)
+                {
+                    ++ret.tooClose;
+                }
+                return false;
+            });
+    }
+    return ret;
+}
+
+static double stepTime(const NodePool& pool, const ForceLayoutSettings& settings)
+{
+    ForceLayout layout;
+    InitForceLayout(layout, pool, settings);
+    const auto begin = BenchmarkClock::now();
+    for (int step = 0; step < ComparedSteps; ++step)
+    {
+        StepForceLayout(layout);
+    }
+    return std::chrono::duration<double, std::milli>(BenchmarkClock::now() - begin).count() / ComparedSteps;
+}
+
+int main(int argc, char** argv)
+{
+    const size_t nodeCount = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 2000;
+    const auto seed = static_cast<uint32_t>((argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 1);
+    if (nodeCount < 4)
+    {
+        fprintf(stderr, "usage: %s [nodes] [seed]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    SetTraceLogLevel(LOG_WARNING);
+
+    const float size = 60.0f * std::sqrt(static_cast<float>(nodeCount));
+    const Rectangle area{0, 0, size, size};
+    NodePool pool;
+    const auto handles = GenerateSyntheticGraph(pool, nodeCount, 2 * nodeCount, area, seed);
+
+    // scatter: the links are long and cross each other
+    std::mt19937 random{seed};
+    std::uniform_real_distribution<float> randomPosition{MaxNodeRadius, size - MaxNodeRadius};
+    for (const auto& handle : handles)
+    {
+        MovePoolNode(pool, handle, {randomPosition(random), randomPosition(random)});
+    }
+    const ForceLayoutSettings settings{.area = area};
+    const LayoutStats before = layoutStats(pool, area, settings.nodeSpacing);
+
+    ForceLayoutWorker worker;
+    const auto begin = BenchmarkClock::now();
+    StartForceLayoutWorker(worker, pool, settings);
+    while (!TakeForceLayout(worker, pool))
+    {
+        UpdateForceLayoutWorker(worker);
+        std::this_thread::yield();
+    }
+    const double layoutTime = std::chrono::duration<double, std::milli>(BenchmarkClock::now() - begin).count();
+    const LayoutStats after = layoutStats(pool, area, settings.nodeSpacing);
+
+    printf(
+        "%zu nodes, %zu links, layout: %d steps in %.1fms\n",
+        pool.nodeCount,
+        pool.linkCount,
+        worker.layout.steps,
+        layoutTime);
+    printf("  crossings:     %7zu -> %zu\n", before.crossings, after.crossings);
+    printf("  nodes overlap: %7zu -> %zu\n", before.tooClose, after.tooClose);
+    printf("  outside area:  %7zu -> %zu\n", before.outside, after.outside);
+
+    const double barnesHutTime = stepTime(pool, settings);
+    ForceLayoutSettings exactSettings = settings;
+    exactSettings.theta = 0.0f;
+    const double exactTime = stepTime(pool, exactSettings);
+    printf(
+        "  step: %.2fms (theta %.1f), %.2fms all pairs (%.1fx)\n",
+        barnesHutTime,
+        settings.theta,
+        exactTime,
+        exactTime / barnesHutTime);
+    return (after.outside == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
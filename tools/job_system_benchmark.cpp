@@ -0,0 +1,139 @@
+/*******************************************************************************************
+ *
+ *   job_system_benchmark - scheduling overhead of the job system (src/job_system.h)
+ *
+ *   Usage: job_system_benchmark [workers] [nodes] [seed]
+ *
+ *   Empty jobs measure the cost of forking and joining (RunJob/WaitJobGroup, ParallelFor), then all links of a
+ *   generated sandbox graph (src/node_pool.h) are checked again (RevalidateEditorLinks) on the calling thread
+ *   and on the workers, the results are compared.
+ *
+ ********************************************************************************************/
+
+#include <raylib.h>
+#include "job_system.h"
+#include "node_editor.h"
+#include "node_pool.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+inline constexpr int ForkJoinRounds = 2000;
+inline constexpr size_t JobsPerRound = 64;
+inline constexpr int RevalidateRounds = 5;
+inline constexpr float MoveDistance = 40.0f;
+
+static void emptyJob(void* /*data*/, size_t /*begin*/, size_t /*end*/)
+{
+}
+
+/// us per RunJob (JobsPerRound jobs, then WaitJobGroup)
+static double forkJoinTime(JobSystem& jobs)
+{
+    const auto begin = BenchmarkClock::now();
+    for (int round = 0; round < ForkJoinRounds; ++round)
+    {
+        JobGroup group;
+        for (size_t i = 0; i < JobsPerRound; ++i)
+        {
+            RunJob(jobs, group, emptyJob, nullptr, i, i + 1);
+        }
+        WaitJobGroup(jobs, group);
+    }
+    return std::chrono::duration<double, std::micro>(BenchmarkClock::now() - begin).count() /
+           (ForkJoinRounds * JobsPerRound);
+}
+
+/// us per ParallelFor with one item per job (like the key previews)
+static double parallelForTime(JobSystem& jobs, size_t count)
+{
+    std::vector<size_t> items(count);
+    const auto begin = BenchmarkClock::now();
+    for (int round = 0; round < ForkJoinRounds; ++round)
+    {
+        ParallelFor(
+            &jobs,
+            items.size(),
+            1,
+            [&](size_t first, size_t last)
+            {
+                for (size_t i = first; i < last; ++i)
+                {
+                    ++items[i];
+                }
+            });
+    }
+    return std::chrono::duration<double, std::micro>(BenchmarkClock::now() - begin).count() / ForkJoinRounds;
+}
+
+static double revalidateTime(NodeEditor& editor)
+{
+    const auto begin = BenchmarkClock::now();
+    for (int round = 0; round < RevalidateRounds; ++round)
+    {
+        RevalidateEditorLinks(editor);
+    }
+    return std::chrono::duration<double, std::milli>(BenchmarkClock::now() - begin).count() / RevalidateRounds;
+}
+
+int main(int argc, char** argv)
+{
+    const int workerCount = (argc > 1) ? std::atoi(argv[1]) : 0;
+    const size_t nodeCount = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 50000;
+    const auto seed = static_cast<uint32_t>((argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 1);
+    if (nodeCount < 4)
+    {
+        fprintf(stderr, "usage: %s [workers] [nodes] [seed]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    SetTraceLogLevel(LOG_WARNING);
+
+    JobSystem jobs;
+    StartJobSystem(jobs, workerCount);
+    printf("%d workers\n", GetJobWorkerCount(jobs));
+
+    printf("  RunJob + WaitJobGroup: %8.3fus per job (%zu jobs per group)\n", forkJoinTime(jobs), JobsPerRound);
+    printf("  ParallelFor (6 keys):  %8.3fus\n", parallelForTime(jobs, 6));
+    printf("  ParallelFor (64):      %8.3fus\n", parallelForTime(jobs, 64));
+    printf(
+        "  executed jobs: %llu, stolen: %llu\n",
+        static_cast<unsigned long long>(jobs.executedJobs.load()),
+        static_cast<unsigned long long>(jobs.stolenJobs.load()));
+
+    // all links of a large sandbox graph
+    const float size = 40.0f * std::sqrt(static_cast<float>(nodeCount));
+    NodeEditor serial;
+    const auto handles = GenerateSyntheticGraph(serial.pool, nodeCount, 2 * nodeCount, {0, 0, size, size}, seed);
+    // some nodes moved a bit, some links are invalid
+    std::mt19937 random{seed};
+    std::uniform_real_distribution<float> randomOffset{-MoveDistance, MoveDistance};
+    for (size_t i = 0; i < handles.size(); i += 10)
+    {
+        const Vector2 position = GetPoolNode(serial.pool, handles[i])->data.position;
+        MovePoolNode(serial.pool, handles[i], {position.x + randomOffset(random), position.y + randomOffset(random)});
+    }
+    NodeEditor parallel;
+    parallel.pool = serial.pool;
+    parallel.jobs = &jobs;
+    const double serialTime = revalidateTime(serial);
+    const double parallelTime = revalidateTime(parallel);
+    if (serial.invalidLinks != parallel.invalidLinks)
+    {
+        fprintf(stderr, "link checks on the workers don't match the calling thread\n");
+        return EXIT_FAILURE;
+    }
+    printf(
+        "%zu nodes, %zu links: RevalidateEditorLinks %.2fms, %.2fms with workers (%.1fx)\n",
+        serial.pool.nodeCount,
+        serial.pool.linkCount,
+        serialTime,
+        parallelTime,
+        serialTime / parallelTime);
+    printf("  invalid links: %zu\n", serial.invalidLinks.size());
+    return EXIT_SUCCESS;
+}
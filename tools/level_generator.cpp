@@ -0,0 +1,296 @@
+/*******************************************************************************************
+ *
+ *   level_generator - random levels (map and nodes), only solvable levels are kept
+ *
+ *   Usage: level_generator <levels.pack> [count] [seed] [threads]
+ *
+ *   Every level is checked with level_validation::IsValidLevel (geometry, limits, solver),
+ *   levels are generated in parallel and written into the level pack as they are done (in order).
+ *   Level i only depends on the seed and i (same pack with any number of threads).
+ *
+ *   Play them with: raylib_game --level-pack=<levels.pack>
+ *
+ ********************************************************************************************/
+
+#include <raylib.h>
+#include "constants.h"
+#include "geometry.h"
+#include "level_pack.h"
+#include "level_validation.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+inline constexpr int MinPresses = 3;
+inline constexpr int MaxPresses = 12;
+inline constexpr int MinDoorDistance = 3; ///< tiles (manhattan) between start and door
+inline constexpr int MaxKeyNodes = 3;
+inline constexpr int MaxActionNodes = 4;
+inline constexpr int MaxDecoyTiles = 8;
+inline constexpr float NodeGrid = 20.0f; ///< node positions are snapped to the grid
+inline constexpr int MaxNodePlacements = 64;
+
+static constexpr std::array<ConnectorAction, 5> GeneratorActions{
+    ConnectorAction::MovementRight,
+    ConnectorAction::MovementLeft,
+    ConnectorAction::MovementDown,
+    ConnectorAction::MovementUp,
+    ConnectorAction::Jump};
+static constexpr std::array<ConnectorKey, 6> GeneratorKeys{
+    ConnectorKey::B, ConnectorKey::H, ConnectorKey::J, ConnectorKey::K, ConnectorKey::L, ConnectorKey::G};
+
+template<typename T>
+static T randomInt(std::mt19937& random, T min, T max)
+{
+    return std::uniform_int_distribution<T>{min, max}(random);
+}
+
+/// map: floor path made by pressing random key binds (actions of the level), door at the end
+static bool generateMap(std::mt19937& random, LevelPackLevel& level, std::span<const ConnectorAction> actions)
+{
+    for (auto& line : level.mapData)
+    {
+        for (auto& tile : line)
+        {
+            tile = static_cast<int>((randomInt(random, 0, 9) == 0) ? TileSet::Void2 : TileSet::Void1);
+        }
+    }
+
+    TilePosition position{randomInt(random, 0, LevelMapWidth - 1), randomInt(random, 0, LevelMapHeight - 1)};
+    auto direction = static_cast<CharacterDirection>(randomInt(random, 0, 3));
+    const TilePosition start = position;
+    level.data.characterStartTilesPosition = {static_cast<float>(start.x), static_cast<float>(start.y)};
+    level.data.characterStartDirection = direction;
+    level.mapData[start.y][start.x] = static_cast<int>(TileSet::Floor);
+
+    const int presses = randomInt(random, MinPresses, MaxPresses);
+    for (int press = 0; press < presses; ++press)
+    {
+        const int chainLength = randomInt(random, 1, level.data.maxActionsPerKey);
+        for (int i = 0; i < chainLength; ++i)
+        {
+            TilePosition next = position;
+            auto nextDirection = direction;
+            MoveTile(next, nextDirection, actions[randomInt<size_t>(random, 0, actions.size() - 1)]);
+            if (next.x < 0 || next.y < 0 || next.x >= LevelMapWidth || next.y >= LevelMapHeight)
+            {
+                continue;
+            }
+            position = next;
+            direction = nextDirection;
+            level.mapData[position.y][position.x] = static_cast<int>(TileSet::Floor);
+        }
+    }
+    if (std::abs(position.x - start.x) + std::abs(position.y - start.y) < MinDoorDistance)
+    {
+        return false;
+    }
+    level.mapData[position.y][position.x] = static_cast<int>(TileSet::Door);
+
+    // decoys (walkable, but not on the path)
+    const int decoys = randomInt(random, 0, MaxDecoyTiles);
+    for (int i = 0; i < decoys; ++i)
+    {
+        auto& tile = level.mapData[randomInt(random, 0, LevelMapHeight - 1)][randomInt(random, 0, LevelMapWidth - 1)];
+        if (level_validation::IsVoidTile(tile))
+        {
+            tile = static_cast<int>(TileSet::Floor);
+        }
+    }
+    return true;
+}
+
+/// random position (grid) inside the ConnectorArea, not overlapping the other nodes
+static bool placeNode(std::mt19937& random, std::span<const NodeData> others, NodeData& node)
+{
+    const float radius = static_cast<float>(geometry::NodeRadius(node));
+    const int columns = static_cast<int>((ConnectorArea.width - 2 * radius) / NodeGrid);
+    const int rows = static_cast<int>((ConnectorArea.height - 2 * radius) / NodeGrid);
+    for (int attempt = 0; attempt < MaxNodePlacements; ++attempt)
+    {
+        node.position = {
+            ConnectorArea.x + radius + static_cast<float>(randomInt(random, 0, columns)) * NodeGrid,
+            ConnectorArea.y + radius + static_cast<float>(randomInt(random, 0, rows)) * NodeGrid};
+        const bool overlaps = std::any_of(
+            others.begin(),
+            others.end(),
+            [&](const NodeData& other)
+            {
+                return geometry::CheckCollisionCircles(
+                    node.position, radius, other.position, static_cast<float>(geometry::NodeRadius(other)));
+            });
+        if (!overlaps && geometry::CircleInsideRec(node.position, radius, ConnectorArea))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// every key can be connected to an action (validConnection, no nodes in between)
+static bool keysConnectable(const LevelData& level)
+{
+    const level_validation::SolverState noConnections{};
+    for (size_t key = 0; key < level.nodesData.size(); ++key)
+    {
+        if (level.nodesData[key].type != ConnectorType::Key)
+        {
+            continue;
+        }
+        bool connectable = false;
+        for (size_t action = 0; action < level.nodesData.size() && !connectable; ++action)
+        {
+            connectable = level.nodesData[action].type == ConnectorType::Action &&
+                          level_validation::SolverValidEdge(
+                              level, noConnections, static_cast<int>(key), static_cast<int>(action));
+        }
+        if (!connectable)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool generateLevel(std::mt19937& random, LevelPackLevel& level)
+{
+    // nodes (actions, keys) and limits
+    std::array<ConnectorAction, GeneratorActions.size()> actionPool = GeneratorActions;
+    std::shuffle(actionPool.begin(), actionPool.end(), random);
+    std::array<ConnectorKey, GeneratorKeys.size()> keyPool = GeneratorKeys;
+    std::shuffle(keyPool.begin(), keyPool.end(), random);
+    const int actionCount = randomInt(random, 1, MaxActionNodes);
+    const int keyCount = randomInt(random, 1, std::min(MaxKeyNodes, MaxNodesInLevel - actionCount));
+
+    level.data = {};
+    level.data.mapData = &level.mapData;
+    level.data.maxActionsPerKey = randomInt(random, 1, std::min(actionCount, level_validation::MaxChainLength));
+    level.data.maxNodeConnections = randomInt(random, 1, actionCount);
+    level.data.guidelines = LevelGuidelines::Keep;
+
+    const std::span<const ConnectorAction> actions{actionPool.data(), static_cast<size_t>(actionCount)};
+    if (!generateMap(random, level, actions))
+    {
+        return false;
+    }
+
+    level.nodesData.clear();
+    for (int i = 0; i < actionCount + keyCount; ++i)
+    {
+        NodeData node = (i < actionCount) ? ActionNode({}, actionPool[i]) : KeyNode({}, keyPool[i - actionCount]);
+        if (!placeNode(random, level.nodesData, node))
+        {
+            return false;
+        }
+        level.nodesData.push_back(node);
+    }
+    std::shuffle(level.nodesData.begin(), level.nodesData.end(), random);
+    level.data.nodesData = level.nodesData;
+
+    return keysConnectable(level.data) && level_validation::IsValidLevel(level.data);
+}
+
+struct GeneratorQueue
+{
+    std::mutex mutex;
+    std::condition_variable generated;
+    std::map<size_t, std::unique_ptr<LevelPackLevel>> levels; ///< done, not written yet
+    std::atomic<size_t> nextLevel{0};
+    std::atomic<size_t> attempts{0};
+};
+
+static void generatorWorker(GeneratorQueue& queue, size_t count, uint32_t seed)
+{
+    for (size_t index = queue.nextLevel.fetch_add(1); index < count; index = queue.nextLevel.fetch_add(1))
+    {
+        std::seed_seq seedSequence{seed, static_cast<uint32_t>(index)};
+        std::mt19937 random{seedSequence};
+        auto level = std::make_unique<LevelPackLevel>();
+        size_t attempts = 1;
+        while (!generateLevel(random, *level))
+        {
+            ++attempts;
+        }
+        queue.attempts += attempts;
+
+        std::lock_guard lock{queue.mutex};
+        queue.levels.emplace(index, std::move(level));
+        queue.generated.notify_one();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <levels.pack> [count] [seed] [threads]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    const size_t count = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 1000;
+    const auto seed = static_cast<uint32_t>((argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 1);
+    const int threads = (argc > 4) ? std::atoi(argv[4]) : 0;
+    SetTraceLogLevel(LOG_WARNING);
+
+    LevelPackWriter writer;
+    if (!OpenLevelPackWriter(writer, argv[1], count))
+    {
+        fprintf(stderr, "failed to write level pack: %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    const auto begin = std::chrono::steady_clock::now();
+    GeneratorQueue queue;
+    const int hardwareThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    const int workerCount = std::max(1, std::min((threads > 0) ? threads : hardwareThreads, static_cast<int>(count)));
+    std::vector<std::thread> workers;
+    workers.reserve(workerCount);
+    for (int i = 0; i < workerCount; ++i)
+    {
+        workers.emplace_back(generatorWorker, std::ref(queue), count, seed);
+    }
+
+    // write the levels in order, as soon as they are done
+    bool ok = true;
+    for (size_t index = 0; index < count; ++index)
+    {
+        std::unique_ptr<LevelPackLevel> level;
+        {
+            std::unique_lock lock{queue.mutex};
+            queue.generated.wait(lock, [&] { return queue.levels.contains(index); });
+            level = std::move(queue.levels.extract(index).mapped());
+        }
+        ok = WriteLevelPackLevel(writer, level->data) && ok;
+        if ((index + 1) % 1000 == 0)
+        {
+            printf("%zu levels\n", index + 1);
+        }
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    ok = CloseLevelPackWriter(writer) && ok;
+    if (!ok)
+    {
+        fprintf(stderr, "failed to write level pack: %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - begin;
+    printf("%zu levels (%zu candidates) in %.2fs with %d threads: %s\n",
+           count,
+           queue.attempts.load(),
+           duration.count(),
+           workerCount,
+           argv[1]);
+    return EXIT_SUCCESS;
+}
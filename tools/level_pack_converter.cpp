@@ -0,0 +1,116 @@
+/*******************************************************************************************
+ *
+ *   level_pack_converter - writes the compiled-in levels (level1.h ...) into a level pack
+ *
+ *   Usage: level_pack_converter <levels.pack> [level directory]
+ *
+ *   The pack can be loaded with: raylib_game --level-pack=<levels.pack>
+ *   See src/level_pack.h for the format.
+ *
+ *   With a level directory, the levels are also written as level files (levelN.txt) for level design,
+ *   see src/level_file.h, load (and hot-reload) them with: raylib_game --level-dir=<level directory>
+ *
+ ********************************************************************************************/
+
+#include <raylib.h>
+#include "constants.h"
+#include "level_file.h"
+#include "level_pack.h"
+#include "levels.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/// all fields of a fixed-size level, the round trips must not lose anything
+static bool sameLevel(const LevelData& expected, const LevelData& actual)
+{
+    const auto sameNode = [](const NodeData& a, const NodeData& b)
+    {
+        return a.position.x == b.position.x && a.position.y == b.position.y && a.action == b.action &&
+               a.key == b.key && a.type == b.type;
+    };
+    return actual.mapData != nullptr && *actual.mapData == *expected.mapData &&
+           std::equal(
+               actual.nodesData.begin(),
+               actual.nodesData.end(),
+               expected.nodesData.begin(),
+               expected.nodesData.end(),
+               sameNode) &&
+           actual.characterStartTilesPosition.x == expected.characterStartTilesPosition.x &&
+           actual.characterStartTilesPosition.y == expected.characterStartTilesPosition.y &&
+           actual.characterStartDirection == expected.characterStartDirection &&
+           actual.maxNodeConnections == expected.maxNodeConnections &&
+           actual.maxActionsPerKey == expected.maxActionsPerKey && actual.guidelines == expected.guidelines &&
+           actual.connectionRules == expected.connectionRules;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <levels.pack> [level directory]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    SetTraceLogLevel(LOG_WARNING);
+
+    std::vector<LevelData> levels;
+    for (int level = 1; level <= MaxLevels; ++level)
+    {
+        const LevelData* levelData = GetBuiltinLevel(level);
+        if (levelData == nullptr)
+        {
+            fprintf(stderr, "level %d not found\n", level);
+            return EXIT_FAILURE;
+        }
+        levels.push_back(*levelData);
+    }
+
+    auto pack = EncodeLevelPack(levels);
+    if (!SaveFileData(argv[1], pack.data(), static_cast<int>(pack.size())))
+    {
+        fprintf(stderr, "failed to write level pack: %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    // round trip, the pack must load the same levels
+    LevelPack levelPack;
+    if (!OpenLevelPack(argv[1], levelPack) || levelPack.levelCount != static_cast<int>(levels.size()))
+    {
+        fprintf(stderr, "failed to read back level pack: %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+    for (int level = 1; level <= levelPack.levelCount; ++level)
+    {
+        const LevelData* actual = GetLevelPackLevel(levelPack, level);
+        if (actual == nullptr || !sameLevel(levels[level - 1], *actual))
+        {
+            fprintf(stderr, "level %d differs after reading back\n", level);
+            return EXIT_FAILURE;
+        }
+    }
+    printf("%d levels, %zu bytes\n", levelPack.levelCount, pack.size());
+
+    // level files, round trip
+    if (argc >= 3)
+    {
+        for (int level = 1; level <= static_cast<int>(levels.size()); ++level)
+        {
+            const LevelData& expected = levels[level - 1];
+            // copy, SaveLevelFile uses TextFormat
+            const std::string fileName =
+                TextFormat("%s/%s%d%s", argv[2], LevelFilePrefix, level, LevelFileExtension);
+            LevelPackLevel actual;
+            if (!SaveLevelFile(fileName.c_str(), expected) || !LoadLevelFile(fileName.c_str(), actual) ||
+                !sameLevel(expected, actual.data))
+            {
+                fprintf(stderr, "failed to write level file: %s\n", fileName.c_str());
+                return EXIT_FAILURE;
+            }
+        }
+        printf("%zu level files in %s\n", levels.size(), argv[2]);
+    }
+
+    return EXIT_SUCCESS;
+}
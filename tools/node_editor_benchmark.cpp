@@ -0,0 +1,166 @@
+/*******************************************************************************************
+ *
+ *   node_editor_benchmark - dragging nodes of a large sandbox graph (src/node_editor.h)
+ *
+ *   Usage: node_editor_benchmark [nodes] [drags] [seed]
+ *
+ *   Random nodes of a generated sandbox graph (src/node_pool.h) are dragged in small steps (one step per frame),
+ *   the incremental link checks are compared with checking all links again and the time per step is printed.
+ *   Then one node is dragged across the whole area and back (very long links for a moment) and the small drags
+ *   run again, the steps should cost the same as before.
+ *
+ ********************************************************************************************/
+
+#include <raylib.h>
+#include "node_editor.h"
+#include "node_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <numbers>
+#include <random>
+#include <vector>
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+inline constexpr int StepsPerDrag = 30;
+inline constexpr float StepDistance = 4.0f;
+inline constexpr int FarDragSteps = 10;
+
+struct DragStats
+{
+    double moveTime{0};
+    double candidatesTime{0};
+    double fullTime{0};
+    size_t drags{0};
+    size_t steps{0};
+    size_t affectedLinks{0};
+    size_t maxInvalidLinks{0};
+};
+
+/// random drags in small steps, false when the incremental link checks don't match all links
+static bool runDrags(
+    NodeEditor& editor, const std::vector<NodeHandle>& handles, size_t dragCount, float size, std::mt19937& random,
+    DragStats& stats)
+{
+    std::uniform_real_distribution<float> randomAngle{0.0f, 2.0f * std::numbers::pi_v<float>};
+    for (size_t drag = 0; drag < dragCount; ++drag)
+    {
+        const NodeHandle handle = handles[random() % handles.size()];
+        const float angle = randomAngle(random);
+        for (int step = 0; step < StepsPerDrag; ++step)
+        {
+            const Vector2 position = GetPoolNode(editor.pool, handle)->data.position;
+            const Vector2 target{
+                std::clamp(position.x + StepDistance * std::cos(angle), 0.0f, size),
+                std::clamp(position.y + StepDistance * std::sin(angle), 0.0f, size)};
+
+            auto begin = BenchmarkClock::now();
+            MoveEditorNode(editor, handle, target);
+            stats.moveTime += std::chrono::duration<double, std::micro>(BenchmarkClock::now() - begin).count();
+            begin = BenchmarkClock::now();
+            UpdateEditorCandidates(editor, handle);
+            stats.candidatesTime += std::chrono::duration<double, std::micro>(BenchmarkClock::now() - begin).count();
+            stats.affectedLinks += editor.affectedLinks.size();
+            stats.maxInvalidLinks = std::max(stats.maxInvalidLinks, editor.invalidLinks.size());
+            ++stats.steps;
+        }
+
+        // reference: all links again
+        NodeEditor full;
+        full.pool = editor.pool;
+        const auto begin = BenchmarkClock::now();
+        RevalidateEditorLinks(full);
+        stats.fullTime += std::chrono::duration<double, std::micro>(BenchmarkClock::now() - begin).count();
+        ++stats.drags;
+        if (full.invalidLinks != editor.invalidLinks)
+        {
+            fprintf(stderr, "incremental link checks don't match all links (drag %zu)\n", drag);
+            return false;
+        }
+    }
+    return true;
+}
+
+/// drag a linked node to the far corner and back to its position
+static void dragAcross(NodeEditor& editor, const std::vector<NodeHandle>& handles, float size)
+{
+    const auto linked = std::find_if(
+        handles.begin(),
+        handles.end(),
+        [&](NodeHandle handle) { return !GetPoolNode(editor.pool, handle)->links.empty(); });
+    if (linked == handles.end())
+    {
+        return;
+    }
+    const Vector2 start = GetPoolNode(editor.pool, *linked)->data.position;
+    const Vector2 corner{(start.x < 0.5f * size) ? size : 0.0f, (start.y < 0.5f * size) ? size : 0.0f};
+    for (int step = 1; step <= 2 * FarDragSteps; ++step)
+    {
+        const float t = static_cast<float>((step <= FarDragSteps) ? step : 2 * FarDragSteps - step) / FarDragSteps;
+        MoveEditorNode(
+            editor, *linked, {start.x + t * (corner.x - start.x), start.y + t * (corner.y - start.y)});
+    }
+}
+
+static void printStats(const char* name, const DragStats& stats)
+{
+    printf(
+        "  %s: %zu drags (%zu steps), up to %zu invalid links\n",
+        name,
+        stats.drags,
+        stats.steps,
+        stats.maxInvalidLinks);
+    printf(
+        "    move:       %9.2fus per step (%.1f links checked)\n",
+        stats.moveTime / stats.steps,
+        1.0 * stats.affectedLinks / stats.steps);
+    printf("    candidates: %9.2fus per step\n", stats.candidatesTime / stats.steps);
+    printf(
+        "    all links:  %9.2fus (%.0fx)\n",
+        stats.fullTime / stats.drags,
+        (stats.fullTime / stats.drags) / (stats.moveTime / stats.steps));
+}
+
+int main(int argc, char** argv)
+{
+    const size_t nodeCount = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 10000;
+    const size_t dragCount = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 100;
+    const auto seed = static_cast<uint32_t>((argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 1);
+    if (nodeCount < 4 || dragCount == 0)
+    {
+        fprintf(stderr, "usage: %s [nodes] [drags] [seed]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    SetTraceLogLevel(LOG_WARNING);
+
+    const float size = 40.0f * std::sqrt(static_cast<float>(nodeCount));
+    NodeEditor editor;
+    const auto handles = GenerateSyntheticGraph(editor.pool, nodeCount, 2 * nodeCount, {0, 0, size, size}, seed);
+    RevalidateEditorLinks(editor);
+
+    std::mt19937 random{seed};
+    DragStats before;
+    if (!runDrags(editor, handles, dragCount, size, random, before))
+    {
+        return EXIT_FAILURE;
+    }
+    // the longest link only grows for a moment, the checks near the dragged nodes must not stay wider
+    dragAcross(editor, handles, size);
+    DragStats after;
+    if (!runDrags(editor, handles, dragCount, size, random, after))
+    {
+        return EXIT_FAILURE;
+    }
+
+    printf(
+        "%zu nodes, %zu links, longest link %.0f\n",
+        editor.pool.nodeCount,
+        editor.pool.linkCount,
+        editor.pool.maxLinkLength);
+    printStats("small drags", before);
+    printStats("after a drag across the area", after);
+    return EXIT_SUCCESS;
+}
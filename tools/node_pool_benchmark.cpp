@@ -0,0 +1,122 @@
+/*******************************************************************************************
+ *
+ *   node_pool_benchmark - link, unlink, validate and add/remove on a large sandbox graph (src/node_pool.h)
+ *
+ *   Usage: node_pool_benchmark [nodes] [operations] [seed]
+ *
+ *   Prints the time per operation, everything should stay far below a frame (16ms) at 10k nodes.
+ *
+ ********************************************************************************************/
+
+#include <raylib.h>
+#include "node_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+static double microseconds(BenchmarkClock::duration duration, size_t operations)
+{
+    return std::chrono::duration<double, std::micro>(duration).count() /
+           static_cast<double>(std::max<size_t>(1, operations));
+}
+
+int main(int argc, char** argv)
+{
+    const size_t nodeCount = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 10000;
+    const size_t operations = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 1000;
+    const auto seed = static_cast<uint32_t>((argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 1);
+    if (nodeCount < 2)
+    {
+        fprintf(stderr, "usage: %s [nodes] [operations] [seed]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    SetTraceLogLevel(LOG_WARNING);
+
+    // about 40 px per node (same density as the levels)
+    const float size = 40.0f * std::sqrt(static_cast<float>(nodeCount));
+    NodePool pool;
+    auto begin = BenchmarkClock::now();
+    std::vector<NodeHandle> handles = GenerateSyntheticGraph(pool, nodeCount, nodeCount, {0, 0, size, size}, seed);
+    const auto generateTime = BenchmarkClock::now() - begin;
+    printf("%zu nodes, %zu links, generated in %.1fms\n",
+           pool.nodeCount,
+           pool.linkCount,
+           std::chrono::duration<double, std::milli>(generateTime).count());
+
+    std::mt19937 random{seed};
+    std::uniform_int_distribution<size_t> randomNode{0, nodeCount - 2};
+
+    // link (any two nodes next to each other in the pool, mostly neighbours)
+    size_t linked = 0;
+    begin = BenchmarkClock::now();
+    for (size_t i = 0; i < operations; ++i)
+    {
+        const size_t node = randomNode(random);
+        linked += LinkPoolNodes(pool, handles[node], handles[node + 1]) == NodeLinkResult::Linked;
+    }
+    const auto linkTime = BenchmarkClock::now() - begin;
+
+    // unlink
+    size_t unlinked = 0;
+    begin = BenchmarkClock::now();
+    for (size_t i = 0; i < operations; ++i)
+    {
+        const NodeHandle handle = handles[randomNode(random)];
+        const PoolNode* node = GetPoolNode(pool, handle);
+        if (node != nullptr && !node->links.empty())
+        {
+            unlinked += UnlinkPoolNodes(pool, handle, node->links.front());
+        }
+    }
+    const auto unlinkTime = BenchmarkClock::now() - begin;
+
+    // remove and add (slots are reused, old handles must be invalid)
+    begin = BenchmarkClock::now();
+    std::vector<NodeHandle> removed;
+    for (size_t i = 0; i < operations; ++i)
+    {
+        auto& handle = handles[randomNode(random)];
+        const PoolNode* node = GetPoolNode(pool, handle);
+        if (node == nullptr)
+        {
+            continue;
+        }
+        const NodeData data = node->data;
+        RemovePoolNode(pool, handle);
+        removed.push_back(handle);
+        handle = AddPoolNode(pool, data);
+    }
+    const auto churnTime = BenchmarkClock::now() - begin;
+    for (const auto& handle : removed)
+    {
+        if (GetPoolNode(pool, handle) != nullptr)
+        {
+            fprintf(stderr, "removed node is still valid (index %u)\n", handle.index);
+            return EXIT_FAILURE;
+        }
+    }
+
+    begin = BenchmarkClock::now();
+    const bool valid = ValidatePoolGraph(pool);
+    const auto validateTime = BenchmarkClock::now() - begin;
+    if (!valid)
+    {
+        fprintf(stderr, "invalid graph\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("  link:          %9.2fus (%zu/%zu linked)\n", microseconds(linkTime, operations), linked, operations);
+    printf("  unlink:        %9.2fus (%zu unlinked)\n", microseconds(unlinkTime, operations), unlinked);
+    printf("  remove + add:  %9.2fus\n", microseconds(churnTime, operations));
+    printf("  validate:      %9.2fus (%zu nodes, %zu links)\n",
+           microseconds(validateTime, 1),
+           pool.nodeCount,
+           pool.linkCount);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,130 @@
+/*******************************************************************************************
+ *
+ *   resource_packer - packs game resources into one (compressed) resource pack
+ *
+ *   Usage: resource_packer <resources.pack> <root dir> <file>...
+ *
+ *   Files are named by their path relative to the root dir ("resources/atlas.png"), the same
+ *   path the game loads them with. Each file is compressed (raw deflate, raylib CompressData)
+ *   when it gets noticeably smaller, otherwise it is stored so the game can use it without a copy.
+ *   See src/resource_pack.h for the format.
+ *
+ ********************************************************************************************/
+
+#include <raylib.h>
+#include "resource_pack.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/// store when compression saves less than 10% (already compressed data like png)
+inline constexpr float ResourcePackerMinCompressionRatio = 0.9f;
+
+struct PackerEntry
+{
+    std::string name;
+    std::vector<unsigned char> data;
+    uint32_t rawSize{0};
+    uint32_t flags{ResourcePackEntryStored};
+};
+
+static void alignTo(std::vector<unsigned char>& pack, uint32_t alignment)
+{
+    while (pack.size() % alignment != 0)
+    {
+        pack.push_back(0);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 4)
+    {
+        fprintf(stderr, "usage: %s <resources.pack> <root dir> <file>...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    SetTraceLogLevel(LOG_WARNING);
+
+    const char* outputFileName = argv[1];
+    const std::string rootDir = argv[2];
+
+    std::vector<PackerEntry> entries;
+    for (int i = 3; i < argc; ++i)
+    {
+        PackerEntry entry;
+        entry.name = argv[i];
+        int dataSize = 0;
+        unsigned char* fileData = LoadFileData((rootDir + "/" + entry.name).c_str(), &dataSize);
+        if (fileData == nullptr)
+        {
+            fprintf(stderr, "failed to load file: %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+        entry.rawSize = static_cast<uint32_t>(dataSize);
+
+        int compressedSize = 0;
+        unsigned char* compressedData = CompressData(fileData, dataSize, &compressedSize);
+        if (compressedData != nullptr && compressedSize < dataSize * ResourcePackerMinCompressionRatio)
+        {
+            entry.data.assign(compressedData, compressedData + compressedSize);
+            entry.flags = ResourcePackEntryDeflate;
+        }
+        else
+        {
+            entry.data.assign(fileData, fileData + dataSize);
+        }
+        MemFree(compressedData);
+        UnloadFileData(fileData);
+
+        printf(
+            "%s: %u -> %zu bytes (%s)\n",
+            entry.name.c_str(),
+            entry.rawSize,
+            entry.data.size(),
+            (entry.flags & ResourcePackEntryDeflate) ? "deflate" : "stored");
+        entries.push_back(std::move(entry));
+    }
+
+    // sorted by name for the lookup (binary search)
+    std::sort(
+        entries.begin(),
+        entries.end(),
+        [](const PackerEntry& a, const PackerEntry& b) { return a.name < b.name; });
+
+    ResourcePackHeader header{};
+    std::memcpy(header.magic, ResourcePackMagic, sizeof(ResourcePackMagic));
+    header.version = ResourcePackVersion;
+    header.entryCount = static_cast<uint32_t>(entries.size());
+
+    std::vector<ResourcePackEntry> index(entries.size());
+    std::vector<unsigned char> pack(sizeof(ResourcePackHeader) + entries.size() * sizeof(ResourcePackEntry), 0);
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        index[i].nameOffset = static_cast<uint32_t>(pack.size());
+        index[i].nameSize = static_cast<uint32_t>(entries[i].name.size());
+        pack.insert(pack.end(), entries[i].name.begin(), entries[i].name.end());
+        pack.push_back('\0');
+    }
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        alignTo(pack, ResourcePackDataAlignment);
+        index[i].dataOffset = static_cast<uint32_t>(pack.size());
+        index[i].dataSize = static_cast<uint32_t>(entries[i].data.size());
+        index[i].rawSize = entries[i].rawSize;
+        index[i].flags = entries[i].flags;
+        pack.insert(pack.end(), entries[i].data.begin(), entries[i].data.end());
+    }
+    std::memcpy(pack.data(), &header, sizeof(header));
+    std::memcpy(pack.data() + sizeof(header), index.data(), index.size() * sizeof(ResourcePackEntry));
+
+    if (!SaveFileData(outputFileName, pack.data(), static_cast<int>(pack.size())))
+    {
+        fprintf(stderr, "failed to write resource pack: %s\n", outputFileName);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,172 @@
+/*******************************************************************************************
+ *
+ *   segment_sweep_benchmark - crossing connections (src/segment_sweep.h) vs. testing all pairs
+ *
+ *   Usage: segment_sweep_benchmark [nodes] [seed]
+ *
+ *   Wirings of generated sandbox graphs (src/node_pool.h, no crossings) with and without some extra
+ *   crossing connections, checks that the sweep finds the same crossings as the all pairs test.
+ *
+ ********************************************************************************************/
+
+#include <raylib.h>
+#include "node_pool.h"
+#include "segment_sweep.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+static bool anySegmentsCrossAllPairs(const std::vector<CrossingSegment>& segments)
+{
+    for (size_t i = 0; i < segments.size(); ++i)
+    {
+        for (size_t j = i + 1; j < segments.size(); ++j)
+        {
+            if (SegmentsCross(segments[i], segments[j]))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+static std::vector<std::pair<int, int>> findCrossingSegmentsAllPairs(const std::vector<CrossingSegment>& segments)
+{
+    std::vector<std::pair<int, int>> crossings;
+    for (size_t i = 0; i < segments.size(); ++i)
+    {
+        for (size_t j = i + 1; j < segments.size(); ++j)
+        {
+            if (SegmentsCross(segments[i], segments[j]))
+            {
+                crossings.emplace_back(static_cast<int>(i), static_cast<int>(j));
+            }
+        }
+    }
+    return crossings;
+}
+
+template<typename Run>
+static double milliseconds(Run&& run)
+{
+    const auto begin = BenchmarkClock::now();
+    run();
+    return std::chrono::duration<double, std::milli>(BenchmarkClock::now() - begin).count();
+}
+
+int main(int argc, char** argv)
+{
+    const size_t nodeCount = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 10000;
+    const auto seed = static_cast<uint32_t>((argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 1);
+    if (nodeCount < 4)
+    {
+        fprintf(stderr, "usage: %s [nodes] [seed]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    SetTraceLogLevel(LOG_WARNING);
+
+    const float size = 40.0f * std::sqrt(static_cast<float>(nodeCount));
+    NodePool pool;
+    GenerateSyntheticGraph(pool, nodeCount, 2 * nodeCount, {0, 0, size, size}, seed);
+    std::vector<CrossingSegment> segments;
+    GetPoolLinkSegments(pool, segments);
+
+    bool ok = true;
+    const auto check = [&](const char* name, const std::vector<CrossingSegment>& wiring)
+    {
+        bool sweep = false;
+        bool allPairs = false;
+        std::vector<std::pair<int, int>> crossings;
+        std::vector<std::pair<int, int>> allPairsCrossings;
+        const double sweepTime = milliseconds([&] { sweep = AnySegmentsCross(wiring); });
+        const double allPairsTime = milliseconds([&] { allPairs = anySegmentsCrossAllPairs(wiring); });
+        const double findTime = milliseconds([&] { FindCrossingSegments(wiring, crossings); });
+        const double findAllPairsTime = milliseconds([&] { allPairsCrossings = findCrossingSegmentsAllPairs(wiring); });
+        printf("%s: %zu connections, %zu crossings\n", name, wiring.size(), allPairsCrossings.size());
+        printf("  any crossing:  sweep %9.2fms, all pairs %9.2fms\n", sweepTime, allPairsTime);
+        printf("  all crossings: sweep %9.2fms, all pairs %9.2fms\n", findTime, findAllPairsTime);
+        if (sweep != allPairs || crossings != allPairsCrossings)
+        {
+            fprintf(stderr, "%s: sweep and all pairs test don't match\n", name);
+            ok = false;
+        }
+    };
+    check("generated", segments);
+
+    // some long connections (without nodes) crossing the wiring
+    std::mt19937 random{seed};
+    std::uniform_real_distribution<float> randomPosition{0, size};
+    std::uniform_real_distribution<float> randomOffset{-120.0f, 120.0f};
+    for (int i = 0; i < 8; ++i)
+    {
+        const Vector2 start{randomPosition(random), randomPosition(random)};
+        segments.push_back({.start = start, .end = {start.x + randomOffset(random), start.y + randomOffset(random)}});
+    }
+    check("crossing", segments);
+    if (PoolGraphHasCrossings(pool))
+    {
+        fprintf(stderr, "generated graph has crossings\n");
+        ok = false;
+    }
+
+    // only check the sweep against the all pairs test: many small random wirings on a grid (shared nodes, vertical
+    // and parallel lines), nodes at different positions and no connection through a node (validConnection)
+    std::uniform_int_distribution<int> randomGrid{0, 8};
+    for (int wiring = 0; wiring < 10000; ++wiring)
+    {
+        std::vector<Vector2> nodes;
+        while (nodes.size() < 8)
+        {
+            const Vector2 node{static_cast<float>(randomGrid(random)), static_cast<float>(randomGrid(random))};
+            const auto samePosition = [&](Vector2 other) { return other.x == node.x && other.y == node.y; };
+            if (std::none_of(nodes.begin(), nodes.end(), samePosition))
+            {
+                nodes.push_back(node);
+            }
+        }
+        const auto throughNode = [&](int node1, int node2)
+        {
+            const Vector2 start = nodes[node1];
+            const Vector2 end = nodes[node2];
+            for (int i = 0; i < static_cast<int>(nodes.size()); ++i)
+            {
+                const Vector2 node = nodes[i];
+                if (i != node1 && i != node2 &&
+                    (end.x - start.x) * (node.y - start.y) == (end.y - start.y) * (node.x - start.x) &&
+                    node.x >= std::min(start.x, end.x) && node.x <= std::max(start.x, end.x) &&
+                    node.y >= std::min(start.y, end.y) && node.y <= std::max(start.y, end.y))
+                {
+                    return true;
+                }
+            }
+            return false;
+        };
+        std::uniform_int_distribution<int> randomNode{0, static_cast<int>(nodes.size()) - 1};
+        std::vector<CrossingSegment> small;
+        for (int i = 0; i < 6; ++i)
+        {
+            const int node1 = randomNode(random);
+            const int node2 = randomNode(random);
+            if (node1 != node2 && !throughNode(node1, node2))
+            {
+                small.push_back({.start = nodes[node1], .end = nodes[node2], .node1 = node1, .node2 = node2});
+            }
+        }
+        std::vector<std::pair<int, int>> crossings;
+        FindCrossingSegments(small, crossings);
+        if (AnySegmentsCross(small) != anySegmentsCrossAllPairs(small) ||
+            crossings != findCrossingSegmentsAllPairs(small))
+        {
+            fprintf(stderr, "small wiring %d: sweep and all pairs test don't match\n", wiring);
+            ok = false;
+        }
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}